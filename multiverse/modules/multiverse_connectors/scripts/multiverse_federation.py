@@ -0,0 +1,155 @@
+#!/usr/bin/env python3
+
+import argparse
+import time
+from typing import Dict, List, Tuple
+
+from multiverse_client_py import MultiverseClient, MultiverseMetaData
+
+class MultiverseFederationLink(MultiverseClient):
+    def __init__(self, host: str, server_port: str, port: str, multiverse_meta_data: MultiverseMetaData) -> None:
+        super().__init__(port, multiverse_meta_data)
+        self._host = host
+        self._server_port = server_port
+
+    def loginfo(self, message: str) -> None:
+        print(f"INFO: {message}")
+
+    def logwarn(self, message: str) -> None:
+        print(f"WARN: {message}")
+
+    def _run(self) -> None:
+        self.loginfo(f"Start federation link to {self._host}:{self._server_port}.")
+        self._connect_and_start()
+
+    def send_and_receive_meta_data(self) -> None:
+        self.loginfo("Sending request meta data: " + str(self.request_meta_data))
+        self._communicate(True)
+        self.loginfo("Received response meta data: " + str(self.response_meta_data))
+
+    def send_and_receive_data(self) -> None:
+        self._communicate(False)
+
+def split_server(server: str):
+    host, server_port = server.rsplit(":", 1)
+    return host, server_port
+
+def get_dtype(attribute_name: str) -> str:
+    # The same types as the attribute maps of the server
+    if attribute_name.startswith("rgb_"):
+        return "uint8"
+    if attribute_name.startswith("depth_"):
+        return "uint16"
+    return "double"
+
+def get_data_offsets(objects: Dict[str, Dict[str, List[float]]]) -> Dict[Tuple[str, str], Tuple[int, int]]:
+    # The server orders the data by type, then by object name, then by attribute as requested, which is sorted here
+    typed_attributes = {"double": [], "uint8": [], "uint16": []}
+    for object_name in sorted(objects.keys()):
+        for attribute_name in sorted(objects[object_name].keys()):
+            typed_attributes[get_dtype(attribute_name)].append((object_name, attribute_name))
+
+    data_offsets = {}
+    offset = 0
+    for dtype in ["double", "uint8", "uint16"]:
+        for object_name, attribute_name in typed_attributes[dtype]:
+            size = len(objects[object_name][attribute_name])
+            data_offsets[(object_name, attribute_name)] = (offset, size)
+            offset += size
+    return data_offsets
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Replicate the objects that a remote server owns into the same world on the local server.")
+
+    # Define arguments
+    parser.add_argument("--world_name", type=str, required=False, default="world", help="Name of the federated world")
+    parser.add_argument("--remote_server", type=str, required=True, help="Server that owns the objects, e.g. tcp://192.168.1.2:7000")
+    parser.add_argument("--local_server", type=str, required=False, default="tcp://127.0.0.1:7000", help="Server that replicates the objects")
+    parser.add_argument("--remote_port", type=str, required=False, default="5500", help="Client port on the remote server")
+    parser.add_argument("--local_port", type=str, required=False, default="5501", help="Client port on the local server")
+    parser.add_argument("--object_names", type=str, required=False, default="", help="Object names to replicate, empty for all objects")
+    parser.add_argument("--attribute_names", type=str, required=False, default="", help="Attribute names to replicate, empty for all attributes")
+    parser.add_argument("--rate_hz", type=float, required=False, default=0.0, help="Replication rate, 0 to replicate as fast as the remote server steps")
+    parser.add_argument("--no_delta_encoding", action="store_true", help="Send every value on every step instead of only the changed ones")
+    parser.add_argument("--bidirectional", action="store_true", help="Another link replicates the same world in the opposite direction, requires --object_names")
+
+    # Parse arguments
+    args = parser.parse_args()
+
+    # With all objects, each link would also replicate the objects that the other link replicated, back to their owner
+    if args.bidirectional and (args.object_names == "" or "" in args.object_names.split(",")):
+        parser.error("--bidirectional requires --object_names without the empty (all objects) name.")
+
+    object_names = args.object_names.split(",")
+    attribute_names = args.attribute_names.split(",")
+
+    # The remote link receives the owned objects in one batch per step, with delta encoding only the changed values
+    remote_host, remote_server_port = split_server(args.remote_server)
+    remote_link = MultiverseFederationLink(host=remote_host,
+                                           server_port=remote_server_port,
+                                           port=args.remote_port,
+                                           multiverse_meta_data=MultiverseMetaData(
+                                               world_name=args.world_name,
+                                               simulation_name=f"multiverse_federation_{args.remote_port}"))
+    remote_link.request_meta_data["meta_data"]["delta_encoding"] = not args.no_delta_encoding
+    remote_link.run()
+
+    remote_link.request_meta_data["send"] = {}
+    remote_link.request_meta_data["receive"] = {}
+    for object_name in object_names:
+        remote_link.request_meta_data["receive"][object_name] = attribute_names
+    remote_link.send_and_receive_meta_data()
+
+    # The wildcards are replaced by the received names in sorted order, so that the layout of the data is known
+    remote_link.request_meta_data["receive"] = {}
+    for object_name, object_data in remote_link.response_meta_data["receive"].items():
+        remote_link.request_meta_data["receive"][object_name] = sorted(object_data.keys())
+    remote_link.send_and_receive_meta_data()
+
+    remote_link.send_data = [0.0]
+    remote_link.send_and_receive_data()
+
+    # The local link sends the objects under the same names, each value is looked up by name in the received data
+    local_host, local_server_port = split_server(args.local_server)
+    local_link = MultiverseFederationLink(host=local_host,
+                                          server_port=local_server_port,
+                                          port=args.local_port,
+                                          multiverse_meta_data=MultiverseMetaData(
+                                              world_name=args.world_name,
+                                              simulation_name=f"multiverse_federation_{args.local_port}"))
+    local_link.run()
+
+    local_link.request_meta_data["send"] = {}
+    local_link.request_meta_data["receive"] = {}
+    for object_name, object_data in remote_link.response_meta_data["receive"].items():
+        local_link.request_meta_data["send"][object_name] = sorted(object_data.keys())
+    local_link.send_and_receive_meta_data()
+
+    receive_data_offsets = get_data_offsets(remote_link.response_meta_data["receive"])
+    send_data_offsets = get_data_offsets(local_link.response_meta_data["send"])
+    send_data_indices = [0] * sum(size for _, size in send_data_offsets.values())
+    for name, (send_offset, send_size) in send_data_offsets.items():
+        if name not in receive_data_offsets or receive_data_offsets[name][1] != send_size:
+            raise RuntimeError(f"[{name[0]}][{name[1]}] is received with a different size than it is sent.")
+        receive_offset = receive_data_offsets[name][0]
+        for i in range(send_size):
+            send_data_indices[send_offset + i] = 1 + receive_offset + i
+
+    local_link.send_data = [local_link.sim_time] + [remote_link.receive_data[i] for i in send_data_indices]
+    local_link.send_and_receive_data()
+
+    try:
+        while True:
+            start_time = time.time()
+            remote_link.send_data = [remote_link.sim_time]
+            remote_link.send_and_receive_data()
+            receive_data = remote_link.receive_data
+            local_link.send_data = [local_link.sim_time] + [receive_data[i] for i in send_data_indices]
+            local_link.send_and_receive_data()
+            if args.rate_hz > 0.0:
+                time.sleep(max(0.0, 1.0 / args.rate_hz - (time.time() - start_time)))
+    except KeyboardInterrupt:
+        pass
+
+    local_link.stop()
+    remote_link.stop()
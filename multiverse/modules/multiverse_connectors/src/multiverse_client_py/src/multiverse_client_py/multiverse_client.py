@@ -2,6 +2,7 @@
 
 """Multiverse Client base class."""
 
+import asyncio
 import dataclasses
 from typing import List, Dict, Callable, TypeVar
 
@@ -39,6 +40,7 @@ class MultiverseClient:
     _bind_send_data_callback: Callable
     _bind_receive_data_callback: Callable
     _init_objects_callback: Callable
+    _receive_data_double_buffered: bool = False
 
     def __init__(
         self,
@@ -130,7 +132,7 @@ class MultiverseClient:
         """Get the send_data, which is set by the user.
         The first element should be the current simulation time,
         the rest should be the data to send with the following order:
-        double -> uint8_t -> uint16_t"""
+        double -> uint8_t -> uint16_t -> float -> half"""
         return self._send_data
 
     @send_data.setter
@@ -138,20 +140,63 @@ class MultiverseClient:
         """Set the send_data, which is received from the server.
         The first element should be the current simulation time,
         the rest should be the data to send with the following order:
-        double -> uint8_t -> uint16_t"""
-        assert isinstance(send_data, list)
+        double -> uint8_t -> uint16_t -> float -> half.
+        A contiguous float64 numpy array with the same layout is copied without per-element conversion."""
+        assert isinstance(send_data, list) or hasattr(send_data, "__array__")
         self._send_data = send_data
         self._multiverse_socket.set_send_data(self._send_data)
 
+    def set_send_data_arrays(self, world_time: float, send_data_double=(), send_data_uint8=(), send_data_uint16=(),
+                             send_data_float=(), send_data_half=()) -> None:
+        """Set the send_data with one numpy array or memoryview per type, each is copied with a single memcpy.
+
+        Args:
+            world_time: The current simulation time.
+            send_data_double: The double data.
+            send_data_uint8: The uint8_t data.
+            send_data_uint16: The uint16_t data.
+            send_data_float: The float data.
+            send_data_half: The half data, given as float32.
+        """
+        self._send_data = None
+        self._multiverse_socket.set_send_data(world_time, send_data_double, send_data_uint8, send_data_uint16,
+                                              send_data_float, send_data_half)
+
     @property
     def receive_data(self) -> List[float]:
         """Get the receive_data, the first element should be the current world time,
         the rest should be the received data with the following order:
-        double -> uint8_t -> uint16_t"""
+        double -> uint8_t -> uint16_t -> float -> half"""
         receive_data = self._multiverse_socket.get_receive_data()
         assert isinstance(receive_data, list)
         return receive_data
 
+    @property
+    def receive_data_arrays(self) -> Dict[str, "numpy.ndarray"]:
+        """Get the receive_data without copying, as numpy arrays that view the receive buffers,
+        keyed by "double", "uint8", "uint16", "float" and "half" (as float32), the world time is in world_time.
+        The arrays are overwritten by the next communication, or by the one after that
+        if receive_data_double_buffered is set."""
+        return {
+            "double": self._multiverse_socket.get_receive_data_double(),
+            "uint8": self._multiverse_socket.get_receive_data_uint8(),
+            "uint16": self._multiverse_socket.get_receive_data_uint16(),
+            "float": self._multiverse_socket.get_receive_data_float(),
+            "half": self._multiverse_socket.get_receive_data_half(),
+        }
+
+    @property
+    def receive_data_double_buffered(self) -> bool:
+        """Get whether the receive data is double buffered."""
+        return self._receive_data_double_buffered
+
+    @receive_data_double_buffered.setter
+    def receive_data_double_buffered(self, receive_data_double_buffered: bool) -> None:
+        """Set whether the receive data is double buffered, so that the receive_data_arrays
+        of the last communication can be read while the next one arrives."""
+        self._receive_data_double_buffered = receive_data_double_buffered
+        self._multiverse_socket.set_receive_data_double_buffered(receive_data_double_buffered)
+
     @property
     def api_callbacks(self) -> Dict[str, Callable]:
         """Get the api_callbacks."""
@@ -248,6 +293,39 @@ class MultiverseClient:
         """
         return self._multiverse_socket.communicate(resend_request_meta_data)
 
+    async def _connect_and_start_async(self) -> None:
+        """Connect to the server and start the client without blocking the event loop,
+        afterwards the client communicates with step."""
+        await asyncio.get_running_loop().run_in_executor(None, self._connect_and_start)
+        self._multiverse_socket.set_non_blocking(True)
+
+    async def step(self, resend_request_meta_data: bool = False) -> bool:
+        """Communicate with the server, resolves when the server reply arrives.
+        Return True if successful, False otherwise.
+
+        Args:
+            resend_request_meta_data: Resend the request meta data.
+        """
+        if not self._communicate(resend_request_meta_data):
+            return False
+        while not self._multiverse_socket.poll():
+            await self._wait_for_socket()
+        return True
+
+    async def _wait_for_socket(self) -> None:
+        """Wait until the socket signals an event, the event loop watches its file descriptor."""
+        loop = asyncio.get_running_loop()
+        socket_fd = self._multiverse_socket.get_socket_fd()
+        future = loop.create_future()
+        loop.add_reader(socket_fd, lambda: future.done() or future.set_result(None))
+        try:
+            # The socket signals edge-triggered, the timeout guards against a missed edge
+            await asyncio.wait_for(future, 0.1)
+        except asyncio.TimeoutError:
+            pass
+        finally:
+            loop.remove_reader(socket_fd)
+
     def _restart(self) -> None:
         """Restart the client."""
         self._disconnect()
@@ -1,3 +1,5 @@
+import asyncio
+import json
 import signal
 import subprocess
 import threading
@@ -6,6 +8,8 @@ from typing import List
 from time import sleep, time
 import os
 
+import numpy
+
 from multiverse_client_py import MultiverseClient, MultiverseMetaData, SocketAddress
 
 
@@ -247,6 +251,532 @@ class MultiverseClientTestCase(unittest.TestCase):
         multiverse_client_test_spawn.stop()
 
 
+class MultiverseClientDataTestCase(unittest.TestCase):
+    time_start = 0.0
+    _query_server = "tcp://127.0.0.1:7001"
+
+    @classmethod
+    def setUpClass(cls) -> None:
+        cls.time_start = time()
+
+    def create_multiverse_client(self, port, world_name, simulation_name, send_objects, receive_objects,
+                                 meta_data=None, server_port=None):
+        multiverse_meta_data = MultiverseMetaData(world_name=world_name, simulation_name=simulation_name)
+        multiverse_client = MultiverseClientTest(client_addr=port, multiverse_meta_data=multiverse_meta_data)
+        if server_port is not None:
+            multiverse_client._server_port = server_port
+        if meta_data is not None:
+            multiverse_client.request_meta_data["meta_data"].update(meta_data)
+        multiverse_client.request_meta_data["send"] = send_objects
+        multiverse_client.request_meta_data["receive"] = receive_objects
+        multiverse_client.run()
+        return multiverse_client
+
+    def query_snapshot(self, query):
+        import zmq
+        context = zmq.Context.instance()
+        socket = context.socket(zmq.REQ)
+        socket.connect(self._query_server)
+        socket.send_string(json.dumps(query))
+        frames = socket.recv_multipart()
+        socket.close()
+        return frames
+
+    def test_multiverse_client_send_data_arrays(self):
+        world_name = "world_send_data_arrays"
+        multiverse_client_test_send = self.create_multiverse_client("1403", world_name, "sim_test_send",
+                                                                    {"object_1": ["position"],
+                                                                     "object_2": ["rgb_128_128"]}, {})
+        multiverse_client_test_receive = self.create_multiverse_client("1404", world_name, "sim_test_receive", {},
+                                                                       {"object_1": ["position"],
+                                                                        "object_2": ["rgb_128_128"]})
+
+        rgb = numpy.arange(128 * 128 * 3, dtype=numpy.uint8)
+        send_data = numpy.concatenate(([time() - self.time_start, 1.0, 2.0, 3.0], rgb.astype(numpy.float64)))
+        multiverse_client_test_send.send_data = send_data
+        multiverse_client_test_send.send_and_receive_data()
+        multiverse_client_test_receive.send_data = [time() - self.time_start]
+        multiverse_client_test_receive.send_and_receive_data()
+        numpy.testing.assert_array_equal(multiverse_client_test_receive.receive_data_arrays["double"], [1.0, 2.0, 3.0])
+        numpy.testing.assert_array_equal(multiverse_client_test_receive.receive_data_arrays["uint8"], rgb)
+
+        multiverse_client_test_send.set_send_data_arrays(time() - self.time_start,
+                                                         send_data_double=memoryview(numpy.array([4.0, 5.0, 6.0])),
+                                                         send_data_uint8=memoryview(rgb[::-1].copy()))
+        multiverse_client_test_send.send_and_receive_data()
+        multiverse_client_test_receive.send_data = [time() - self.time_start]
+        multiverse_client_test_receive.send_and_receive_data()
+        numpy.testing.assert_array_equal(multiverse_client_test_receive.receive_data_arrays["double"], [4.0, 5.0, 6.0])
+        numpy.testing.assert_array_equal(multiverse_client_test_receive.receive_data_arrays["uint8"], rgb[::-1])
+
+        multiverse_client_test_receive.stop()
+        multiverse_client_test_send.stop()
+
+    def test_multiverse_client_receive_data_arrays(self):
+        world_name = "world_receive_data_arrays"
+        multiverse_client_test_send = self.create_multiverse_client("1401", world_name, "sim_test_send",
+                                                                    {"object_1": ["position", "quaternion"]}, {})
+        multiverse_client_test_send.send_data = [time() - self.time_start, 3.0, 2.0, 1.0, 1.0, 0.0, 0.0, 0.0]
+        multiverse_client_test_send.send_and_receive_data()
+
+        multiverse_client_test_receive = self.create_multiverse_client("1402", world_name, "sim_test_receive", {},
+                                                                       {"object_1": ["position", "quaternion"]})
+        multiverse_client_test_receive.send_data = [time() - self.time_start]
+        multiverse_client_test_receive.send_and_receive_data()
+        receive_data_double = multiverse_client_test_receive.receive_data_arrays["double"]
+        numpy.testing.assert_array_equal(receive_data_double, [3.0, 2.0, 1.0, 1.0, 0.0, 0.0, 0.0])
+
+        # A new handshake reallocates the receive data, the arrays of the old one stay valid
+        multiverse_client_test_receive.request_meta_data["receive"] = {"object_1": ["position"]}
+        multiverse_client_test_receive.send_and_receive_meta_data()
+        multiverse_client_test_receive.send_data = [time() - self.time_start]
+        multiverse_client_test_receive.send_and_receive_data()
+        numpy.testing.assert_array_equal(receive_data_double, [3.0, 2.0, 1.0, 1.0, 0.0, 0.0, 0.0])
+        numpy.testing.assert_array_equal(multiverse_client_test_receive.receive_data_arrays["double"], [3.0, 2.0, 1.0])
+
+        multiverse_client_test_receive.stop()
+        multiverse_client_test_send.stop()
+
+    def test_multiverse_client_rate_hz(self):
+        world_name = "world_rate_hz"
+        multiverse_client_test_send = self.create_multiverse_client("1436", world_name, "sim_test_send",
+                                                                    {"object_1": ["position", "quaternion"]}, {})
+        multiverse_client_test_send.send_data = [time() - self.time_start, 1.0, 2.0, 3.0, 1.0, 0.0, 0.0, 0.0]
+        multiverse_client_test_send.send_and_receive_data()
+
+        multiverse_client_test_receive_attribute = self.create_multiverse_client("1437", world_name,
+                                                                                 "sim_test_receive_attribute", {},
+                                                                                 {"object_1": ["position",
+                                                                                               "quaternion"]},
+                                                                                 {"rate_hz": {"quaternion": 1.0}})
+        multiverse_client_test_receive_session = self.create_multiverse_client("1438", world_name,
+                                                                               "sim_test_receive_session", {},
+                                                                               {"object_1": ["position"]},
+                                                                               {"rate_hz": 1.0})
+        for multiverse_client_test_receive in [multiverse_client_test_receive_attribute,
+                                               multiverse_client_test_receive_session]:
+            multiverse_client_test_receive.send_data = [time() - self.time_start]
+            multiverse_client_test_receive.send_and_receive_data()
+        self.assertEqual(multiverse_client_test_receive_attribute.receive_data[1:],
+                         [1.0, 2.0, 3.0, 1.0, 0.0, 0.0, 0.0])
+        self.assertEqual(multiverse_client_test_receive_session.receive_data[1:], [1.0, 2.0, 3.0])
+
+        # Within the period, the decimated attribute and the decimated session keep their last values
+        multiverse_client_test_send.send_data = [time() - self.time_start, 4.0, 5.0, 6.0, 0.0, 1.0, 0.0, 0.0]
+        multiverse_client_test_send.send_and_receive_data()
+        for multiverse_client_test_receive in [multiverse_client_test_receive_attribute,
+                                               multiverse_client_test_receive_session]:
+            multiverse_client_test_receive.send_data = [time() - self.time_start]
+            multiverse_client_test_receive.send_and_receive_data()
+        self.assertEqual(multiverse_client_test_receive_attribute.receive_data[1:],
+                         [4.0, 5.0, 6.0, 1.0, 0.0, 0.0, 0.0])
+        self.assertEqual(multiverse_client_test_receive_session.receive_data[1:], [1.0, 2.0, 3.0])
+
+        # After the period, both are received again
+        sleep(1.1)
+        for multiverse_client_test_receive in [multiverse_client_test_receive_attribute,
+                                               multiverse_client_test_receive_session]:
+            multiverse_client_test_receive.send_data = [time() - self.time_start]
+            multiverse_client_test_receive.send_and_receive_data()
+        self.assertEqual(multiverse_client_test_receive_attribute.receive_data[1:],
+                         [4.0, 5.0, 6.0, 0.0, 1.0, 0.0, 0.0])
+        self.assertEqual(multiverse_client_test_receive_session.receive_data[1:], [4.0, 5.0, 6.0])
+
+        multiverse_client_test_receive_session.stop()
+        multiverse_client_test_receive_attribute.stop()
+        multiverse_client_test_send.stop()
+
+    def test_multiverse_client_tensors(self):
+        world_name = "world_tensors"
+        tensors = {"tensors": {"joint_efforts_7": {"dtype": "double", "shape": [7]},
+                               "mask_4_4": {"dtype": "uint8", "shape": [4, 4]}}}
+        multiverse_client_test_send = self.create_multiverse_client("1439", world_name, "sim_test_send",
+                                                                    {"object_1": ["joint_efforts_7", "mask_4_4"]},
+                                                                    {}, tensors)
+        multiverse_client_test_receive = self.create_multiverse_client("1440", world_name, "sim_test_receive", {},
+                                                                       {"object_1": ["joint_efforts_7", "mask_4_4"]})
+
+        joint_efforts = numpy.arange(7, dtype=numpy.float64) * 0.5
+        mask = numpy.arange(16, dtype=numpy.uint8)
+        multiverse_client_test_send.set_send_data_arrays(time() - self.time_start, send_data_double=joint_efforts,
+                                                         send_data_uint8=mask)
+        multiverse_client_test_send.send_and_receive_data()
+        multiverse_client_test_receive.send_data = [time() - self.time_start]
+        multiverse_client_test_receive.send_and_receive_data()
+        numpy.testing.assert_array_equal(multiverse_client_test_receive.receive_data_arrays["double"], joint_efforts)
+        numpy.testing.assert_array_equal(multiverse_client_test_receive.receive_data_arrays["uint8"], mask)
+
+        multiverse_client_test_receive.stop()
+        multiverse_client_test_send.stop()
+
+    def test_multiverse_client_wildcards(self):
+        world_name = "world_wildcards"
+        multiverse_client_test_send = self.create_multiverse_client("1441", world_name, "sim_test_send",
+                                                                    {"object_1": ["position"],
+                                                                     "object_2": ["position", "quaternion"]}, {})
+        multiverse_client_test_send.send_data = [time() - self.time_start, 1.0, 2.0, 3.0, 4.0, 5.0, 6.0,
+                                                 1.0, 0.0, 0.0, 0.0]
+        multiverse_client_test_send.send_and_receive_data()
+
+        # An empty object name selects every object that is sent with the attribute
+        multiverse_client_test_receive_objects = self.create_multiverse_client("1442", world_name,
+                                                                               "sim_test_receive_objects", {},
+                                                                               {"": ["position"]})
+        multiverse_client_test_receive_objects.send_data = [time() - self.time_start]
+        multiverse_client_test_receive_objects.send_and_receive_data()
+        self.assertEqual(list(multiverse_client_test_receive_objects.response_meta_data["receive"].keys()),
+                         ["object_1", "object_2"])
+        self.assertEqual(multiverse_client_test_receive_objects.receive_data[1:], [1.0, 2.0, 3.0, 4.0, 5.0, 6.0])
+
+        # An empty attribute name selects every attribute that is sent for the object
+        multiverse_client_test_receive_attributes = self.create_multiverse_client("1443", world_name,
+                                                                                  "sim_test_receive_attributes", {},
+                                                                                  {"object_2": [""]})
+        multiverse_client_test_receive_attributes.send_data = [time() - self.time_start]
+        multiverse_client_test_receive_attributes.send_and_receive_data()
+        self.assertEqual(multiverse_client_test_receive_attributes.receive_data[1:],
+                         [4.0, 5.0, 6.0, 1.0, 0.0, 0.0, 0.0])
+
+        multiverse_client_test_receive_attributes.stop()
+        multiverse_client_test_receive_objects.stop()
+        multiverse_client_test_send.stop()
+
+    def test_multiverse_client_float_and_half(self):
+        world_name = "world_float_and_half"
+        multiverse_client_test_send = self.create_multiverse_client("1406", world_name, "sim_test_send",
+                                                                    {"object_1": ["position", "quaternion"],
+                                                                     "object_2": ["position"]}, {},
+                                                                    {"precision": {"position": "float",
+                                                                                   "quaternion": "half"}})
+        multiverse_client_test_receive = self.create_multiverse_client("1407", world_name, "sim_test_receive", {},
+                                                                       {"object_1": ["position", "quaternion"],
+                                                                        "object_2": ["position"]},
+                                                                       {"precision": "half"})
+
+        # The send data is ordered double -> uint8_t -> uint16_t -> float -> half
+        multiverse_client_test_send.send_data = [time() - self.time_start, 1.5, -2.25, 3.125, -1.0, 2.0, 0.25,
+                                                 0.5, 0.5, 0.5, 0.5]
+        multiverse_client_test_send.send_and_receive_data()
+        multiverse_client_test_receive.send_data = [time() - self.time_start]
+        multiverse_client_test_receive.send_and_receive_data()
+        receive_data_arrays = multiverse_client_test_receive.receive_data_arrays
+        self.assertEqual(receive_data_arrays["double"].size, 0)
+        self.assertEqual(receive_data_arrays["float"].size, 0)
+        numpy.testing.assert_allclose(receive_data_arrays["half"],
+                                      [1.5, -2.25, 3.125, 0.5, 0.5, 0.5, 0.5, -1.0, 2.0, 0.25], atol=1e-3)
+
+        multiverse_client_test_receive.stop()
+        multiverse_client_test_send.stop()
+
+    def test_multiverse_client_delta_encoding(self):
+        world_name = "world_delta_encoding"
+        multiverse_client_test_send = self.create_multiverse_client("1408", world_name, "sim_test_send",
+                                                                    {"object_1": ["position", "quaternion"],
+                                                                     "object_2": ["position"]}, {},
+                                                                    {"delta_encoding": True})
+        multiverse_client_test_receive = self.create_multiverse_client("1409", world_name, "sim_test_receive", {},
+                                                                       {"object_1": ["position", "quaternion"],
+                                                                        "object_2": ["position"]},
+                                                                       {"delta_encoding": True})
+
+        # Only some values change between the steps, so the following frames are delta frames
+        send_data = [1.0, 2.0, 3.0, 1.0, 0.0, 0.0, 0.0, 4.0, 5.0, 6.0]
+        for step in range(5):
+            send_data[0] = float(step)
+            send_data[9] = 6.0 + step
+            multiverse_client_test_send.send_data = [time() - self.time_start] + send_data
+            multiverse_client_test_send.send_and_receive_data()
+            multiverse_client_test_receive.send_data = [time() - self.time_start]
+            multiverse_client_test_receive.send_and_receive_data()
+            self.assertEqual(multiverse_client_test_receive.receive_data[1:], send_data)
+
+        multiverse_client_test_receive.stop()
+        multiverse_client_test_send.stop()
+
+    def test_multiverse_client_history(self):
+        world_name = "world_history"
+        multiverse_client_test_send = self.create_multiverse_client("1412", world_name, "sim_test_send",
+                                                                    {"object_1": ["position"]}, {},
+                                                                    {"history_size": 10})
+        multiverse_client_test_send.send_data = [1.0, 0.0, 0.0, 0.0]
+        multiverse_client_test_send.send_and_receive_data()
+        multiverse_client_test_send.send_data = [2.0, 2.0, 4.0, 6.0]
+        multiverse_client_test_send.send_and_receive_data()
+
+        history_request = {"time": 1.5, "interpolate": True, "receive": {"object_1": ["position"]}}
+        history_response = json.loads(
+            multiverse_client_test_send._multiverse_socket.request_history(json.dumps(history_request)))
+        self.assertEqual(history_response["time"], 1.5)
+        numpy.testing.assert_allclose(history_response["receive"]["object_1"]["position"], [1.0, 2.0, 3.0])
+
+        history_request["time"] = 3.0
+        history_response = json.loads(
+            multiverse_client_test_send._multiverse_socket.request_history(json.dumps(history_request)))
+        self.assertDictEqual(history_response["receive"], {})
+
+        multiverse_client_test_send.stop()
+
+    def test_multiverse_client_step_async(self):
+        world_name = "world_step_async"
+        multiverse_meta_data = MultiverseMetaData(world_name=world_name, simulation_name="sim_test_async")
+        multiverse_client_test_async = MultiverseClientTest(client_addr="1405",
+                                                            multiverse_meta_data=multiverse_meta_data)
+        multiverse_client_test_async.request_meta_data["send"] = {"object_1": ["position"]}
+        multiverse_client_test_async.request_meta_data["receive"] = {"object_1": ["position"]}
+
+        async def step():
+            await multiverse_client_test_async._connect_and_start_async()
+            multiverse_client_test_async.send_data = [time() - self.time_start, 1.0, 2.0, 3.0]
+            self.assertTrue(await multiverse_client_test_async.step())
+            multiverse_client_test_async.send_data = [time() - self.time_start, 4.0, 5.0, 6.0]
+            self.assertTrue(await multiverse_client_test_async.step())
+
+        asyncio.run(step())
+        self.assertEqual(multiverse_client_test_async.receive_data[1:], [4.0, 5.0, 6.0])
+        multiverse_client_test_async.stop()
+
+    def test_multiverse_client_dependencies(self):
+        world_name = "world_dependencies"
+        multiverse_client_test_send_1 = self.create_multiverse_client("1417", world_name, "sim_test_send_1",
+                                                                      {"object_1": ["position"]}, {})
+        multiverse_client_test_send_2 = self.create_multiverse_client("1418", world_name, "sim_test_send_2",
+                                                                      {"object_2": ["position"]}, {})
+        multiverse_client_test_send_1.send_data = [time() - self.time_start, 1.0, 2.0, 3.0]
+        multiverse_client_test_send_1.send_and_receive_data()
+
+        # The receiver only depends on the first sender, so it steps while the second sender never sends
+        multiverse_client_test_receive = self.create_multiverse_client("1419", world_name, "sim_test_receive", {},
+                                                                       {"object_1": ["position"]})
+        for _ in range(3):
+            multiverse_client_test_receive.send_data = [time() - self.time_start]
+            multiverse_client_test_receive.send_and_receive_data()
+            self.assertEqual(multiverse_client_test_receive.receive_data[1:], [1.0, 2.0, 3.0])
+
+        # The senders do not depend on each other and step independently
+        start = time()
+        for step in range(100):
+            multiverse_client_test_send_2.send_data = [time() - self.time_start] + [float(step)] * 3
+            multiverse_client_test_send_2.send_and_receive_data()
+        self.assertLess(time() - start, 5.0)
+
+        multiverse_client_test_receive.stop()
+        multiverse_client_test_send_2.stop()
+        multiverse_client_test_send_1.stop()
+
+    def test_multiverse_client_compression(self):
+        world_name = "world_compression"
+        compression = {"compression": {"rgb": "lz4", "depth": "delta_bitpack"}}
+        multiverse_client_test_send = self.create_multiverse_client("1410", world_name, "sim_test_send",
+                                                                    {"object_1": ["rgb_128_128", "depth_128_128"]},
+                                                                    {}, compression)
+        multiverse_client_test_receive = self.create_multiverse_client("1411", world_name, "sim_test_receive", {},
+                                                                       {"object_1": ["rgb_128_128", "depth_128_128"]},
+                                                                       compression)
+
+        for step in range(3):
+            rgb = (numpy.arange(128 * 128 * 3) // 7 + step).astype(numpy.uint8)
+            depth = (numpy.arange(128 * 128) * 3 + step).astype(numpy.uint16)
+            multiverse_client_test_send.set_send_data_arrays(time() - self.time_start, send_data_uint8=rgb,
+                                                             send_data_uint16=depth)
+            multiverse_client_test_send.send_and_receive_data()
+            multiverse_client_test_receive.send_data = [time() - self.time_start]
+            multiverse_client_test_receive.send_and_receive_data()
+            numpy.testing.assert_array_equal(multiverse_client_test_receive.receive_data_arrays["uint8"], rgb)
+            numpy.testing.assert_array_equal(multiverse_client_test_receive.receive_data_arrays["uint16"], depth)
+
+        multiverse_client_test_receive.stop()
+        multiverse_client_test_send.stop()
+
+    def test_multiverse_client_double_buffered(self):
+        world_name = "world_double_buffered"
+        multiverse_client_test_send_1 = self.create_multiverse_client("1414", world_name, "sim_test_send_1",
+                                                                      {"object_1": ["position"]}, {})
+        multiverse_client_test_send_2 = self.create_multiverse_client("1415", world_name, "sim_test_send_2",
+                                                                      {"object_2": ["position"]}, {})
+        multiverse_client_test_send_1.send_data = [time() - self.time_start, 0.0, 0.0, 0.0]
+        multiverse_client_test_send_1.send_and_receive_data()
+        multiverse_client_test_send_2.send_data = [time() - self.time_start, 0.0, 0.0, 0.0]
+        multiverse_client_test_send_2.send_and_receive_data()
+
+        multiverse_client_test_receive = self.create_multiverse_client("1416", world_name, "sim_test_receive", {},
+                                                                       {"object_1": ["position"],
+                                                                        "object_2": ["position"]},
+                                                                       {"double_buffered": True})
+        multiverse_client_test_receive.send_data = [time() - self.time_start]
+        multiverse_client_test_receive.send_and_receive_data()
+
+        # The epoch is published once both senders committed, so the receiver never sees one sender ahead
+        for step in range(1, 4):
+            multiverse_client_test_send_1.send_data = [time() - self.time_start] + [float(step)] * 3
+            multiverse_client_test_send_1.send_and_receive_data()
+            multiverse_client_test_receive.send_data = [time() - self.time_start]
+            multiverse_client_test_receive.send_and_receive_data()
+            self.assertEqual(multiverse_client_test_receive.receive_data[1:], [float(step - 1)] * 6)
+
+            multiverse_client_test_send_2.send_data = [time() - self.time_start] + [float(step)] * 3
+            multiverse_client_test_send_2.send_and_receive_data()
+            multiverse_client_test_receive.send_data = [time() - self.time_start]
+            multiverse_client_test_receive.send_and_receive_data()
+            self.assertEqual(multiverse_client_test_receive.receive_data[1:], [float(step)] * 6)
+
+        multiverse_client_test_receive.stop()
+        multiverse_client_test_send_2.stop()
+        multiverse_client_test_send_1.stop()
+
+    def test_multiverse_client_interest(self):
+        world_name = "world_interest"
+        multiverse_client_test_send = self.create_multiverse_client("1434", world_name, "sim_test_send",
+                                                                    {"object_inside": ["position"],
+                                                                     "object_outside": ["position"]}, {})
+        multiverse_client_test_send.send_data = [time() - self.time_start, 0.5, 0.5, 0.5, 5.0, 5.0, 5.0]
+        multiverse_client_test_send.send_and_receive_data()
+
+        # Delta frames are enabled with the region of interest
+        multiverse_client_test_receive = self.create_multiverse_client("1435", world_name, "sim_test_receive", {},
+                                                                       {"object_inside": ["position"],
+                                                                        "object_outside": ["position"]},
+                                                                       {"interest": {"min": [-1.0, -1.0, -1.0],
+                                                                                     "max": [1.0, 1.0, 1.0]}})
+        multiverse_client_test_receive.send_data = [time() - self.time_start]
+        multiverse_client_test_receive.send_and_receive_data()
+        self.assertEqual(multiverse_client_test_receive.receive_data[1:4], [0.5, 0.5, 0.5])
+        outside_data = multiverse_client_test_receive.receive_data[4:7]
+        self.assertNotEqual(outside_data, [5.0, 5.0, 5.0])
+
+        # The object outside of the region keeps its last value until it enters the region
+        multiverse_client_test_send.send_data = [time() - self.time_start, -0.5, -0.5, -0.5, 6.0, 6.0, 6.0]
+        multiverse_client_test_send.send_and_receive_data()
+        multiverse_client_test_receive.send_data = [time() - self.time_start]
+        multiverse_client_test_receive.send_and_receive_data()
+        self.assertEqual(multiverse_client_test_receive.receive_data[1:], [-0.5, -0.5, -0.5] + outside_data)
+
+        multiverse_client_test_send.send_data = [time() - self.time_start, -0.5, -0.5, -0.5, 0.0, 0.0, 0.0]
+        multiverse_client_test_send.send_and_receive_data()
+        multiverse_client_test_receive.send_data = [time() - self.time_start]
+        multiverse_client_test_receive.send_and_receive_data()
+        self.assertEqual(multiverse_client_test_receive.receive_data[1:], [-0.5, -0.5, -0.5, 0.0, 0.0, 0.0])
+
+        multiverse_client_test_receive.stop()
+        multiverse_client_test_send.stop()
+
+    def test_multiverse_client_router(self):
+        shard_ports = ["7100", "7200"]
+        shard_processes = [subprocess.Popen(["multiverse_server", f"tcp://127.0.0.1:{shard_port}", "none"])
+                           for shard_port in shard_ports]
+        router_process = subprocess.Popen(["multiverse_server", "--router", "tcp://127.0.0.1:7300"] +
+                                          [f"tcp://127.0.0.1:{shard_port}" for shard_port in shard_ports])
+        sleep(1)
+        try:
+            # Each world is hosted by one shard, the clients of a world meet there through the router
+            for world_index in range(3):
+                world_name = f"world_router_{world_index}"
+                multiverse_client_test_send = self.create_multiverse_client(f"{1420 + 2 * world_index}", world_name,
+                                                                            "sim_test_send",
+                                                                            {"object_1": ["position"]}, {},
+                                                                            server_port="7300")
+                multiverse_client_test_receive = self.create_multiverse_client(f"{1421 + 2 * world_index}",
+                                                                               world_name, "sim_test_receive", {},
+                                                                               {"object_1": ["position"]},
+                                                                               server_port="7300")
+                multiverse_client_test_send.send_data = [time() - self.time_start] + [float(world_index)] * 3
+                multiverse_client_test_send.send_and_receive_data()
+                multiverse_client_test_receive.send_data = [time() - self.time_start]
+                multiverse_client_test_receive.send_and_receive_data()
+                self.assertEqual(multiverse_client_test_receive.receive_data[1:], [float(world_index)] * 3)
+
+                multiverse_client_test_receive.stop()
+                multiverse_client_test_send.stop()
+        finally:
+            kill_multiverse_server(router_process)
+            for shard_process in shard_processes:
+                kill_multiverse_server(shard_process)
+
+    def test_multiverse_client_federation(self):
+        remote_server_process = subprocess.Popen(["multiverse_server", "tcp://127.0.0.1:7400", "none"])
+        local_server_process = subprocess.Popen(["multiverse_server", "tcp://127.0.0.1:7500", "none"])
+        sleep(1)
+        multiverse_client_test_send = self.create_multiverse_client("1432", "world_federation", "sim_test_send",
+                                                                    {"object_b": ["quaternion", "position"],
+                                                                     "object_a": ["position"]}, {},
+                                                                    server_port="7400")
+        multiverse_client_test_send.send_data = [time() - self.time_start, 1.0, 2.0, 3.0, 0.0, 0.0, 0.0,
+                                                 1.0, 4.0, 5.0, 6.0]
+        multiverse_client_test_send.send_and_receive_data()
+
+        federation_script = os.path.join(os.path.dirname(__file__), "..", "..", "..", "scripts",
+                                         "multiverse_federation.py")
+        federation_process = subprocess.Popen(["python3", federation_script,
+                                               "--world_name", "world_federation",
+                                               "--remote_server", "tcp://127.0.0.1:7400",
+                                               "--local_server", "tcp://127.0.0.1:7500",
+                                               "--remote_port", "1430",
+                                               "--local_port", "1431"])
+        try:
+            # The replicated objects are received by name, in a different order than they are sent
+            multiverse_client_test_receive = self.create_multiverse_client("1433", "world_federation",
+                                                                           "sim_test_receive", {},
+                                                                           {"object_a": ["position"],
+                                                                            "object_b": ["quaternion", "position"]},
+                                                                           server_port="7500")
+            for _ in range(50):
+                multiverse_client_test_receive.send_data = [time() - self.time_start]
+                multiverse_client_test_receive.send_and_receive_data()
+                if multiverse_client_test_receive.receive_data[1:4] == [1.0, 2.0, 3.0]:
+                    break
+                sleep(0.1)
+            self.assertEqual(multiverse_client_test_receive.receive_data[1:],
+                             [1.0, 2.0, 3.0, 0.0, 0.0, 0.0, 1.0, 4.0, 5.0, 6.0])
+            multiverse_client_test_receive.stop()
+        finally:
+            kill_multiverse_server(federation_process)
+            multiverse_client_test_send.stop()
+            kill_multiverse_server(local_server_process)
+            kill_multiverse_server(remote_server_process)
+
+    def test_multiverse_client_snapshot(self):
+        world_name = "world_snapshot"
+        multiverse_client_test_send = self.create_multiverse_client("1413", world_name, "sim_test_send",
+                                                                    {"object_2": ["position"],
+                                                                     "object_1": ["position"]}, {})
+        multiverse_client_test_send.send_data = [time() - self.time_start, 1.0, 2.0, 3.0, 4.0, 5.0, 6.0]
+        multiverse_client_test_send.send_and_receive_data()
+
+        # The first query enables the snapshot, the sender fills it from its next step on
+        query = {"world_name": world_name, "objects": {"object_1": ["position"], "": ["position"]}}
+        self.query_snapshot(query)
+        multiverse_client_test_send.send_and_receive_data()
+
+        # The wildcard and the explicit name select object_1 once, the objects are sorted by name
+        snapshot = json.loads(self.query_snapshot(query)[0])
+        self.assertListEqual(list(snapshot["objects"].keys()), ["object_1", "object_2"])
+        self.assertListEqual(snapshot["objects"]["object_1"]["position"], [1.0, 2.0, 3.0])
+        self.assertListEqual(snapshot["objects"]["object_2"]["position"], [4.0, 5.0, 6.0])
+
+        query["format"] = "binary"
+        frames = self.query_snapshot(query)
+        layout = json.loads(frames[0])["layout"]
+        snapshot_double = numpy.frombuffer(frames[1], dtype=numpy.float64)
+        self.assertListEqual([(entry["object"], entry["attribute"], entry["dtype"], entry["offset"], entry["size"])
+                              for entry in layout],
+                             [("object_1", "position", "double", 0, 3), ("object_2", "position", "double", 3, 3)])
+        numpy.testing.assert_array_equal(snapshot_double, [1.0, 2.0, 3.0, 4.0, 5.0, 6.0])
+
+        # The queries do not block the sender, and each snapshot holds the values of one step
+        def send():
+            for step in range(200):
+                multiverse_client_test_send.send_data = [time() - self.time_start] + [float(step)] * 6
+                multiverse_client_test_send.send_and_receive_data()
+
+        send_thread = threading.Thread(target=send)
+        send_thread.start()
+        while send_thread.is_alive():
+            snapshot_double = numpy.frombuffer(self.query_snapshot(query)[1], dtype=numpy.float64)
+            numpy.testing.assert_array_equal(snapshot_double, snapshot_double[0])
+        send_thread.join()
+
+        multiverse_client_test_send.stop()
+
+
 class MultiverseClientComplexTestCase(unittest.TestCase):
     meta_data = MultiverseMetaData(
         length_unit="m",
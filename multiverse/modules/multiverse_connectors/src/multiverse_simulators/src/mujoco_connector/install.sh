@@ -14,6 +14,7 @@ else
         cp -r plugin/multiverse_connector $MUJOCO_SRC_DIR/plugin
         ln -sf $MULTIVERSE_DIR/src/multiverse_client/include/multiverse_client.h $MUJOCO_SRC_DIR/plugin/multiverse_connector
         ln -sf $MULTIVERSE_DIR/src/multiverse_client/include/multiverse_client_json.h $MUJOCO_SRC_DIR/plugin/multiverse_connector
+        ln -sf $MULTIVERSE_DIR/src/multiverse_client/include/multiverse_compression.h $MUJOCO_SRC_DIR/plugin/multiverse_connector
         ln -sf $MULTIVERSE_DIR/lib/libstdc++/libmultiverse_client_json.so $MUJOCO_SRC_DIR/plugin/multiverse_connector
         ln -sf $MULTIVERSE_DIR/lib/libstdc++/libmultiverse_client.a $MUJOCO_SRC_DIR/plugin/multiverse_connector
         
@@ -65,13 +65,43 @@ Json::Value string_to_json(std::string &str)
   }
 }
 
-enum class BodyState : uint8_t
+using mujoco::plugin::multiverse_connector::BodyState;
+using mujoco::plugin::multiverse_connector::EAttribute;
+using mujoco::plugin::multiverse_connector::DataRun;
+using mujoco::plugin::multiverse_connector::OdomBody;
+using mujoco::plugin::multiverse_connector::Rollout;
+
+EAttribute get_attribute(const std::string &attr_name)
 {
-  UNKNOWN = 0,
-  STATIC = 1,
-  FREE = 2,
-  HANGING = 3,
-};
+  static const std::map<std::string, EAttribute> attribute_map =
+  {
+    {"position", EAttribute::Position},
+    {"quaternion", EAttribute::Quaternion},
+    {"relative_velocity", EAttribute::RelativeVelocity},
+    {"odometric_velocity", EAttribute::OdometricVelocity},
+    {"force", EAttribute::Force},
+    {"torque", EAttribute::Torque},
+    {"joint_rvalue", EAttribute::JointRvalue},
+    {"joint_tvalue", EAttribute::JointTvalue},
+    {"joint_angular_velocity", EAttribute::JointAngularVelocity},
+    {"joint_linear_velocity", EAttribute::JointLinearVelocity},
+    {"joint_angular_acceleration", EAttribute::JointAngularAcceleration},
+    {"joint_linear_acceleration", EAttribute::JointLinearAcceleration},
+    {"joint_torque", EAttribute::JointTorque},
+    {"joint_force", EAttribute::JointForce},
+    {"joint_position", EAttribute::JointPosition},
+    {"joint_quaternion", EAttribute::JointQuaternion},
+    {"cmd_joint_rvalue", EAttribute::CmdJointRvalue},
+    {"cmd_joint_tvalue", EAttribute::CmdJointTvalue},
+    {"cmd_joint_angular_velocity", EAttribute::CmdJointAngularVelocity},
+    {"cmd_joint_linear_velocity", EAttribute::CmdJointLinearVelocity},
+    {"cmd_joint_torque", EAttribute::CmdJointTorque},
+    {"cmd_joint_force", EAttribute::CmdJointForce},
+    {"sensors", EAttribute::Sensors},
+  };
+  const std::map<std::string, EAttribute>::const_iterator attribute_it = attribute_map.find(attr_name);
+  return attribute_it != attribute_map.end() ? attribute_it->second : EAttribute::Unknown;
+}
 
 BodyState get_body_state(const mjModel *m, const int body_id)
 {
@@ -90,41 +120,47 @@ BodyState get_body_state(const mjModel *m, const int body_id)
   return BodyState::UNKNOWN;
 }
 
-bool is_attribute_valid(const std::string &obj_name, const std::string &attr_name, const int obj_type, int &attr_size, const mjModel *m)
+std::map<int, int> get_object_ids(const mjModel *m, const std::string &obj_name)
+{
+  return {{mjOBJ_BODY, mj_name2id(m, mjOBJ_BODY, obj_name.c_str())},
+          {mjOBJ_JOINT, mj_name2id(m, mjOBJ_JOINT, obj_name.c_str())},
+          {mjOBJ_ACTUATOR, mj_name2id(m, mjOBJ_ACTUATOR, obj_name.c_str())}};
+}
+
+bool is_attribute_valid(const int obj_id, const EAttribute attr, const int obj_type, int &attr_size, const mjModel *m)
 {
   attr_size = 0;
   switch (obj_type)
   {
   case mjOBJ_BODY:
   {
-    const int body_id = mj_name2id(m, mjOBJ_BODY, obj_name.c_str());
-    const BodyState body_state = get_body_state(m, body_id);
-    if (strcmp(attr_name.c_str(), "position") == 0)
+    const BodyState body_state = obj_id != -1 ? get_body_state(m, obj_id) : BodyState::UNKNOWN;
+    if (attr == EAttribute::Position)
     {
       attr_size = 3;
       return true;
     }
-    else if (strcmp(attr_name.c_str(), "quaternion") == 0)
+    else if (attr == EAttribute::Quaternion)
     {
       attr_size = 4;
       return true;
     }
-    else if (strcmp(attr_name.c_str(), "relative_velocity") == 0 && body_state == BodyState::FREE)
+    else if (attr == EAttribute::RelativeVelocity && body_state == BodyState::FREE)
     {
       attr_size = 6;
       return true;
     }
-    else if (strcmp(attr_name.c_str(), "odometric_velocity") == 0)
+    else if (attr == EAttribute::OdometricVelocity)
     {
       attr_size = 6;
       return true;
     }
-    else if (strcmp(attr_name.c_str(), "force") == 0 && body_state == BodyState::FREE)
+    else if (attr == EAttribute::Force && body_state == BodyState::FREE)
     {
       attr_size = 3;
       return true;
     }
-    else if (strcmp(attr_name.c_str(), "torque") == 0 && body_state == BodyState::FREE)
+    else if (attr == EAttribute::Torque && body_state == BodyState::FREE)
     {
       attr_size = 3;
       return true;
@@ -133,12 +169,14 @@ bool is_attribute_valid(const std::string &obj_name, const std::string &attr_nam
   }
   case mjOBJ_JOINT:
   {
-    const int joint_id = mj_name2id(m, mjOBJ_JOINT, obj_name.c_str());
-    const int joint_type = m->jnt_type[joint_id];
+    if (obj_id == -1)
+    {
+      return false;
+    }
+    const int joint_type = m->jnt_type[obj_id];
     if (joint_type == mjJNT_HINGE)
     {
-      const std::set<const char *> joint_attributes = {"joint_rvalue", "joint_angular_velocity", "joint_angular_acceleration", "joint_torque",};
-      if (std::find(joint_attributes.begin(), joint_attributes.end(), attr_name) != joint_attributes.end())
+      if (attr == EAttribute::JointRvalue || attr == EAttribute::JointAngularVelocity || attr == EAttribute::JointAngularAcceleration || attr == EAttribute::JointTorque)
       {
         attr_size = 1;
         return true;
@@ -146,8 +184,7 @@ bool is_attribute_valid(const std::string &obj_name, const std::string &attr_nam
     }
     else if (joint_type == mjJNT_SLIDE)
     {
-      const std::set<const char *> joint_attributes = {"joint_tvalue", "joint_linear_velocity", "joint_linear_acceleration", "joint_force"};
-      if (std::find(joint_attributes.begin(), joint_attributes.end(), attr_name) != joint_attributes.end())
+      if (attr == EAttribute::JointTvalue || attr == EAttribute::JointLinearVelocity || attr == EAttribute::JointLinearAcceleration || attr == EAttribute::JointForce)
       {
         attr_size = 1;
         return true;
@@ -157,8 +194,8 @@ bool is_attribute_valid(const std::string &obj_name, const std::string &attr_nam
   }
   case mjOBJ_ACTUATOR:
   {
-    const std::set<const char *> actuator_attributes = {"cmd_joint_rvalue", "cmd_joint_tvalue", "cmd_joint_angular_velocity", "cmd_joint_linear_velocity", "cmd_joint_torque", "cmd_joint_force"};
-    if (std::find(actuator_attributes.begin(), actuator_attributes.end(), attr_name) != actuator_attributes.end())
+    if (attr == EAttribute::CmdJointRvalue || attr == EAttribute::CmdJointTvalue || attr == EAttribute::CmdJointAngularVelocity ||
+        attr == EAttribute::CmdJointLinearVelocity || attr == EAttribute::CmdJointTorque || attr == EAttribute::CmdJointForce)
     {
       attr_size = 1;
       return true;
@@ -171,127 +208,292 @@ bool is_attribute_valid(const std::string &obj_name, const std::string &attr_nam
   }
 }
 
-void calculate_contact_efforts(std::map<int, mjtNum *> &contact_efforts, const mjModel *m, mjData *d)
+std::vector<DataRun> get_data_runs(const std::vector<mjtNum *> &data_vec, const std::vector<int> &data_rollouts)
+{
+  std::vector<DataRun> data_runs;
+  for (size_t i = 0; i < data_vec.size(); i++)
+  {
+    if (!data_runs.empty() && data_runs.back().data + data_runs.back().size == data_vec[i] && data_runs.back().rollout == data_rollouts[i])
+    {
+      data_runs.back().size++;
+    }
+    else
+    {
+      data_runs.push_back({data_vec[i], i, 1, data_rollouts[i]});
+    }
+  }
+  return data_runs;
+}
+
+// Copies the runs of the rollouts that take part in the exchange into the buffer
+void gather_data_runs(const std::vector<DataRun> &data_runs, const std::vector<Rollout> &rollouts, mjtNum *buffer)
+{
+  for (const DataRun &data_run : data_runs)
+  {
+    if (!rollouts[data_run.rollout].is_exchanged)
+    {
+      continue;
+    }
+    if (data_run.size == 1)
+    {
+      buffer[data_run.offset] = *data_run.data;
+    }
+    else
+    {
+      mju_copy(buffer + data_run.offset, data_run.data, data_run.size);
+    }
+  }
+}
+
+// Copies the buffer into the runs of the rollouts that take part in the exchange
+void scatter_data_runs(const std::vector<DataRun> &data_runs, const std::vector<Rollout> &rollouts, const mjtNum *buffer)
+{
+  for (const DataRun &data_run : data_runs)
+  {
+    if (!rollouts[data_run.rollout].is_exchanged)
+    {
+      continue;
+    }
+    if (data_run.size == 1)
+    {
+      *data_run.data = buffer[data_run.offset];
+    }
+    else
+    {
+      mju_copy(data_run.data, buffer + data_run.offset, data_run.size);
+    }
+  }
+}
+
+std::string get_rollout_name(const std::string &object_name, const int rollout)
+{
+  return rollout == 0 ? object_name : object_name + "_rollout_" + std::to_string(rollout);
+}
+
+// Returns the rollout of a name from get_rollout_name and the name without the suffix, 0 if it has no valid suffix
+int get_rollout_index(const std::string &rollout_name, const int rollouts, std::string &object_name)
+{
+  object_name = rollout_name;
+  const size_t suffix_pos = rollout_name.rfind("_rollout_");
+  if (rollouts == 1 || suffix_pos == std::string::npos)
+  {
+    return 0;
+  }
+  const std::string rollout_str = rollout_name.substr(suffix_pos + 9);
+  if (rollout_str.empty() || rollout_str.size() > 9 || rollout_str.find_first_not_of("0123456789") != std::string::npos)
+  {
+    return 0;
+  }
+  const int rollout = std::stoi(rollout_str);
+  if (rollout < 1 || rollout >= rollouts)
+  {
+    return 0;
+  }
+  object_name = rollout_name.substr(0, suffix_pos);
+  return rollout;
+}
+
+std::vector<int> get_dof_chain(const mjModel *m, int body_id)
+{
+  // Bodies without dofs move with the first parent that has dofs
+  while (body_id > 0 && m->body_dofnum[body_id] == 0)
+  {
+    body_id = m->body_parentid[body_id];
+  }
+
+  std::vector<int> dof_chain;
+  if (body_id <= 0)
+  {
+    return dof_chain;
+  }
+  for (int dof_id = m->body_dofadr[body_id] + m->body_dofnum[body_id] - 1; dof_id >= 0; dof_id = m->dof_parentid[dof_id])
+  {
+    dof_chain.push_back(dof_id);
+  }
+  return dof_chain;
+}
+
+// Same as multiplying the mj_jacBodyCom Jacobian with qfrc_constraint, but only over the dofs in the chain of each body
+void calculate_contact_efforts(std::map<int, mjtNum *> &contact_efforts, const std::map<int, std::vector<int>> &contact_dof_chains, const mjModel *m, const mjData *d)
 {
-  mj_markStack(d);
   for (std::pair<const int, mjtNum *> &contact_effort : contact_efforts)
   {
-    mjtNum *jac = mj_stackAllocNum(d, 6 * m->nv);
-    mj_jacBodyCom(m, d, jac, jac + 3 * m->nv, contact_effort.first);
-    mju_mulMatVec(contact_effort.second, jac, d->qfrc_constraint, 6, m->nv);
+    mju_zero(contact_effort.second, 6);
+  }
+  if (d->nefc == 0) // No active constraints, so no constraint forces
+  {
+    return;
+  }
+
+  for (const std::pair<const int, std::vector<int>> &contact_dof_chain : contact_dof_chains)
+  {
+    const int body_id = contact_dof_chain.first;
+    mjtNum *force = contact_efforts[body_id];
+    mjtNum *torque = force + 3;
+
+    mjtNum offset[3];
+    mju_sub3(offset, d->xipos + 3 * body_id, d->subtree_com + 3 * m->body_rootid[body_id]);
+    for (const int dof_id : contact_dof_chain.second)
+    {
+      const mjtNum qfrc = d->qfrc_constraint[dof_id];
+      if (qfrc == 0.0)
+      {
+        continue;
+      }
+
+      // The translational column is the linear part of cdof corrected for the rotation about the offset
+      const mjtNum *cdof = d->cdof + 6 * dof_id;
+      mjtNum cdof_offset[3];
+      mju_cross(cdof_offset, cdof, offset);
+      for (int i = 0; i < 3; i++)
+      {
+        force[i] += (cdof[i + 3] + cdof_offset[i]) * qfrc;
+        torque[i] += cdof[i] * qfrc;
+      }
+    }
   }
-  mj_freeStack(d);
 }
 
-void calculate_odom_velocities(std::map<int, mjtNum *> &odom_velocities, const mjModel *m, const mjData *d)
+// Returns 0, 1 or 2 if the axis is x, y or z, -1 otherwise
+int get_axis_index(const mjtNum *axis)
 {
+  for (int i = 0; i < 3; i++)
+  {
+    if (mju_abs(axis[i] - 1.0) < mjMINVAL && mju_abs(axis[(i + 1) % 3]) < mjMINVAL && mju_abs(axis[(i + 2) % 3]) < mjMINVAL)
+    {
+      return i;
+    }
+  }
+  return -1;
+}
+
+std::vector<OdomBody> get_odom_bodies(std::map<int, mjtNum *> &odom_velocities, const mjModel *m)
+{
+  std::vector<OdomBody> odom_bodies;
   for (std::pair<const int, mjtNum *> &odom_velocity : odom_velocities)
   {
     const int body_id = odom_velocity.first;
-    const int dof_adr = m->body_dofadr[body_id];
+    OdomBody odom_body;
+    odom_body.velocity = odom_velocity.second;
     if (m->body_dofnum[body_id] == 6 &&
         m->body_jntadr[body_id] != -1 &&
         m->jnt_type[m->body_jntadr[body_id]] == mjtJoint::mjJNT_FREE)
+    {
+      odom_body.free_qpos_adr = m->jnt_qposadr[m->body_jntadr[body_id]];
+      odom_body.free_dof_adr = m->body_dofadr[body_id];
+    }
+    else if (m->body_dofnum[body_id] <= 6)
     {
       const int joint_adr = m->body_jntadr[body_id];
-      const int qpos_adr = m->jnt_qposadr[joint_adr];
+      for (int joint_id = joint_adr; joint_id < joint_adr + m->body_jntnum[body_id]; joint_id++)
+      {
+        const int axis_index = get_axis_index(m->jnt_axis + 3 * joint_id);
+        if (axis_index == -1)
+        {
+          continue;
+        }
+        if (m->jnt_type[joint_id] == mjtJoint::mjJNT_HINGE)
+        {
+          odom_body.hinge_qpos_adrs[axis_index] = m->jnt_qposadr[joint_id];
+          odom_body.hinge_dof_adrs[axis_index].push_back(m->jnt_dofadr[joint_id]);
+        }
+        else if (m->jnt_type[joint_id] == mjtJoint::mjJNT_SLIDE)
+        {
+          odom_body.slide_dof_adrs[axis_index].push_back(m->jnt_dofadr[joint_id]);
+        }
+      }
+    }
+    else
+    {
+      continue;
+    }
+    odom_bodies.push_back(odom_body);
+  }
+  return odom_bodies;
+}
+
+void calculate_odom_velocities(const std::vector<OdomBody> &odom_bodies, std::vector<mjtNum> &odom_angles, mjData *d)
+{
+  const size_t n = 3 * odom_bodies.size();
+  odom_angles.resize(3 * n);
+  mjtNum *angles = odom_angles.data();
+  mjtNum *sines = angles + n;
+  mjtNum *cosines = sines + n;
 
-      const mjtNum w = (d->qpos + qpos_adr)[3];
-      const mjtNum x = (d->qpos + qpos_adr)[4];
-      const mjtNum y = (d->qpos + qpos_adr)[5];
-      const mjtNum z = (d->qpos + qpos_adr)[6];
+  for (size_t i = 0; i < odom_bodies.size(); i++)
+  {
+    const OdomBody &odom_body = odom_bodies[i];
+    mjtNum *odom_ang_joint_pos = angles + 3 * i;
+    if (odom_body.free_qpos_adr != -1)
+    {
+      const mjtNum w = (d->qpos + odom_body.free_qpos_adr)[3];
+      const mjtNum x = (d->qpos + odom_body.free_qpos_adr)[4];
+      const mjtNum y = (d->qpos + odom_body.free_qpos_adr)[5];
+      const mjtNum z = (d->qpos + odom_body.free_qpos_adr)[6];
 
       const mjtNum sinr_cosp = 2 * (w * x + y * z);
       const mjtNum cosr_cosp = 1 - 2 * (x * x + y * y);
-      mjtNum odom_ang_x_joint_pos = std::atan2(sinr_cosp, cosr_cosp);
+      odom_ang_joint_pos[0] = std::atan2(sinr_cosp, cosr_cosp);
 
       const mjtNum sinp = 2 * (w * y - z * x);
-      mjtNum odom_ang_y_joint_pos;
       if (mju_abs(sinp) >= 1)
       {
-        odom_ang_y_joint_pos = std::copysign(M_PI / 2, sinp); // use 90 degrees if out of range
+        odom_ang_joint_pos[1] = std::copysign(M_PI / 2, sinp); // use 90 degrees if out of range
       }
       else
       {
-        odom_ang_y_joint_pos = std::asin(sinp);
+        odom_ang_joint_pos[1] = std::asin(sinp);
       }
 
       const mjtNum siny_cosp = 2 * (w * z + x * y);
       const mjtNum cosy_cosp = 1 - 2 * (y * y + z * z);
-      mjtNum odom_ang_z_joint_pos = std::atan2(siny_cosp, cosy_cosp);
-
-      mjtNum *qvel = d->qvel + dof_adr;
-      qvel[0] = odom_velocity.second[0] * mju_cos(odom_ang_y_joint_pos) * mju_cos(odom_ang_z_joint_pos) + odom_velocity.second[1] * (mju_sin(odom_ang_x_joint_pos) * mju_sin(odom_ang_y_joint_pos) * mju_cos(odom_ang_z_joint_pos) - mju_cos(odom_ang_x_joint_pos) * mju_sin(odom_ang_z_joint_pos)) + odom_velocity.second[2] * (mju_cos(odom_ang_x_joint_pos) * mju_sin(odom_ang_y_joint_pos) * mju_cos(odom_ang_z_joint_pos) + mju_sin(odom_ang_x_joint_pos) * mju_sin(odom_ang_z_joint_pos));
-      qvel[1] = odom_velocity.second[0] * mju_cos(odom_ang_y_joint_pos) * mju_sin(odom_ang_z_joint_pos) + odom_velocity.second[1] * (mju_sin(odom_ang_x_joint_pos) * mju_sin(odom_ang_y_joint_pos) * mju_sin(odom_ang_z_joint_pos) + mju_cos(odom_ang_x_joint_pos) * mju_cos(odom_ang_z_joint_pos)) + odom_velocity.second[2] * (mju_cos(odom_ang_x_joint_pos) * mju_sin(odom_ang_y_joint_pos) * mju_sin(odom_ang_z_joint_pos) - mju_sin(odom_ang_x_joint_pos) * mju_cos(odom_ang_z_joint_pos));
-      qvel[2] = odom_velocity.second[0] * mju_sin(odom_ang_y_joint_pos) + odom_velocity.second[1] * mju_sin(odom_ang_x_joint_pos) * mju_cos(odom_ang_y_joint_pos) + odom_velocity.second[2] * mju_cos(odom_ang_x_joint_pos) * mju_cos(odom_ang_y_joint_pos);
-      qvel[3] = odom_velocity.second[3];
-      qvel[4] = odom_velocity.second[4];
-      qvel[5] = odom_velocity.second[5];
+      odom_ang_joint_pos[2] = std::atan2(siny_cosp, cosy_cosp);
     }
-    else if (m->body_dofnum[body_id] <= 6)
+    else
     {
-      mjtNum odom_ang_x_joint_pos = 0.0;
-      mjtNum odom_ang_y_joint_pos = 0.0;
-      mjtNum odom_ang_z_joint_pos = 0.0;
+      for (int k = 0; k < 3; k++)
+      {
+        odom_ang_joint_pos[k] = odom_body.hinge_qpos_adrs[k] != -1 ? d->qpos[odom_body.hinge_qpos_adrs[k]] : 0.0;
+      }
+    }
+  }
 
-      const int joint_adr = m->body_jntadr[body_id];
-      for (int joint_id = joint_adr; joint_id < joint_adr + m->body_jntnum[body_id]; joint_id++)
+  // Each sine and cosine is computed once per angle, the rotation below reuses them several times
+  for (size_t i = 0; i < n; i++)
+  {
+    sines[i] = std::sin(angles[i]);
+    cosines[i] = std::cos(angles[i]);
+  }
+
+  for (size_t i = 0; i < odom_bodies.size(); i++)
+  {
+    const OdomBody &odom_body = odom_bodies[i];
+    const mjtNum sx = sines[3 * i], sy = sines[3 * i + 1], sz = sines[3 * i + 2];
+    const mjtNum cx = cosines[3 * i], cy = cosines[3 * i + 1], cz = cosines[3 * i + 2];
+    const mjtNum *v = odom_body.velocity;
+    const mjtNum lin_vel[3] = {v[0] * cy * cz + v[1] * (sx * sy * cz - cx * sz) + v[2] * (cx * sy * cz + sx * sz),
+                               v[0] * cy * sz + v[1] * (sx * sy * sz + cx * cz) + v[2] * (cx * sy * sz - sx * cz),
+                               v[0] * sy + v[1] * sx * cy + v[2] * cx * cy};
+    if (odom_body.free_dof_adr != -1)
+    {
+      mjtNum *qvel = d->qvel + odom_body.free_dof_adr;
+      qvel[0] = lin_vel[0];
+      qvel[1] = lin_vel[1];
+      qvel[2] = lin_vel[2];
+      qvel[3] = v[3];
+      qvel[4] = v[4];
+      qvel[5] = v[5];
+      continue;
+    }
+    for (int k = 0; k < 3; k++)
+    {
+      for (const int slide_dof_adr : odom_body.slide_dof_adrs[k])
       {
-        const int qpos_adr = m->jnt_qposadr[joint_id];
-        if (m->jnt_type[joint_id] == mjtJoint::mjJNT_HINGE)
-        {
-          if (mju_abs(m->jnt_axis[3 * joint_id] - 1.0) < mjMINVAL && mju_abs(m->jnt_axis[3 * joint_id + 1]) < mjMINVAL && mju_abs(m->jnt_axis[3 * joint_id + 2]) < mjMINVAL)
-          {
-            odom_ang_x_joint_pos = d->qpos[qpos_adr];
-          }
-          else if (mju_abs(m->jnt_axis[3 * joint_id + 1] - 1.0) < mjMINVAL && mju_abs(m->jnt_axis[3 * joint_id + 2]) < mjMINVAL && mju_abs(m->jnt_axis[3 * joint_id]) < mjMINVAL)
-          {
-            odom_ang_y_joint_pos = d->qpos[qpos_adr];
-          }
-          else if (mju_abs(m->jnt_axis[3 * joint_id + 2] - 1.0) < mjMINVAL && mju_abs(m->jnt_axis[3 * joint_id]) < mjMINVAL && mju_abs(m->jnt_axis[3 * joint_id + 1]) < mjMINVAL)
-          {
-            odom_ang_z_joint_pos = d->qpos[qpos_adr];
-          }
-        }
+        d->qvel[slide_dof_adr] = lin_vel[k];
       }
-      for (int joint_num = 0; joint_num < m->body_jntnum[body_id]; joint_num++)
+      for (const int hinge_dof_adr : odom_body.hinge_dof_adrs[k])
       {
-        const int joint_id = joint_adr + joint_num;
-        if (m->jnt_type[joint_id] != mjtJoint::mjJNT_SLIDE && m->jnt_type[joint_id] != mjtJoint::mjJNT_HINGE)
-        {
-          continue;
-        }
-        const int dof_id = m->jnt_dofadr[joint_id];
-        if (m->jnt_type[joint_id] == mjtJoint::mjJNT_SLIDE)
-        {
-          if (mju_abs(m->jnt_axis[3 * joint_id] - 1.0) < mjMINVAL && mju_abs(m->jnt_axis[3 * joint_id + 1]) < mjMINVAL && mju_abs(m->jnt_axis[3 * joint_id + 2]) < mjMINVAL)
-          {
-            d->qvel[dof_id] = odom_velocity.second[0] * mju_cos(odom_ang_y_joint_pos) * mju_cos(odom_ang_z_joint_pos) + odom_velocity.second[1] * (mju_sin(odom_ang_x_joint_pos) * mju_sin(odom_ang_y_joint_pos) * mju_cos(odom_ang_z_joint_pos) - mju_cos(odom_ang_x_joint_pos) * mju_sin(odom_ang_z_joint_pos)) + odom_velocity.second[2] * (mju_cos(odom_ang_x_joint_pos) * mju_sin(odom_ang_y_joint_pos) * mju_cos(odom_ang_z_joint_pos) + mju_sin(odom_ang_x_joint_pos) * mju_sin(odom_ang_z_joint_pos));
-          }
-          else if (mju_abs(m->jnt_axis[3 * joint_id + 1] - 1.0) < mjMINVAL && mju_abs(m->jnt_axis[3 * joint_id + 2]) < mjMINVAL && mju_abs(m->jnt_axis[3 * joint_id]) < mjMINVAL)
-          {
-            d->qvel[dof_id] = odom_velocity.second[0] * mju_cos(odom_ang_y_joint_pos) * mju_sin(odom_ang_z_joint_pos) + odom_velocity.second[1] * (mju_sin(odom_ang_x_joint_pos) * mju_sin(odom_ang_y_joint_pos) * mju_sin(odom_ang_z_joint_pos) + mju_cos(odom_ang_x_joint_pos) * mju_cos(odom_ang_z_joint_pos)) + odom_velocity.second[2] * (mju_cos(odom_ang_x_joint_pos) * mju_sin(odom_ang_y_joint_pos) * mju_sin(odom_ang_z_joint_pos) - mju_sin(odom_ang_x_joint_pos) * mju_cos(odom_ang_z_joint_pos));
-          }
-          else if (mju_abs(m->jnt_axis[3 * joint_id + 2] - 1.0) < mjMINVAL && mju_abs(m->jnt_axis[3 * joint_id]) < mjMINVAL && mju_abs(m->jnt_axis[3 * joint_id + 1]) < mjMINVAL)
-          {
-            d->qvel[dof_id] = odom_velocity.second[0] * mju_sin(odom_ang_y_joint_pos) + odom_velocity.second[1] * mju_sin(odom_ang_x_joint_pos) * mju_cos(odom_ang_y_joint_pos) + odom_velocity.second[2] * mju_cos(odom_ang_x_joint_pos) * mju_cos(odom_ang_y_joint_pos);
-          }
-        }
-        else if (m->jnt_type[joint_id] == mjtJoint::mjJNT_HINGE)
-        {
-          if (mju_abs(m->jnt_axis[3 * joint_id] - 1.0) < mjMINVAL && mju_abs(m->jnt_axis[3 * joint_id + 1]) < mjMINVAL && mju_abs(m->jnt_axis[3 * joint_id + 2]) < mjMINVAL)
-          {
-            d->qvel[dof_id] = odom_velocity.second[3];
-          }
-          else if (mju_abs(m->jnt_axis[3 * joint_id + 1] - 1.0) < mjMINVAL && mju_abs(m->jnt_axis[3 * joint_id + 2]) < mjMINVAL && mju_abs(m->jnt_axis[3 * joint_id]) < mjMINVAL)
-          {
-            d->qvel[dof_id] = odom_velocity.second[4];
-          }
-          else if (mju_abs(m->jnt_axis[3 * joint_id + 2] - 1.0) < mjMINVAL && mju_abs(m->jnt_axis[3 * joint_id]) < mjMINVAL && mju_abs(m->jnt_axis[3 * joint_id + 1]) < mjMINVAL)
-          {
-            d->qvel[dof_id] = odom_velocity.second[5];
-          }
-        }
+        d->qvel[hinge_dof_adr] = v[3 + k];
       }
     }
   }
@@ -306,6 +508,16 @@ namespace mujoco::plugin::multiverse_connector
   constexpr char simulation_name_str[] = "simulation_name";
   constexpr char send_str[] = "send";
   constexpr char receive_str[] = "receive";
+  constexpr char async_str[] = "async";
+  constexpr char max_staleness_str[] = "max_staleness";
+  constexpr char sensors_str[] = "sensors";
+  constexpr char rollouts_str[] = "rollouts";
+  constexpr char rollout_timeout_str[] = "rollout_timeout";
+
+  // Rollout groups that wait for more mjData, keyed by the model and the plugin instance
+  std::map<std::pair<const mjModel *, int>, MultiverseConnector *> rollout_groups;
+
+  std::mutex rollout_groups_mtx;
 
   std::string GetStringAttr(const mjModel *m, int instance, const char *attr, const std::string &default_value = "")
   {
@@ -315,12 +527,47 @@ namespace mujoco::plugin::multiverse_connector
 
   MultiverseConnector *MultiverseConnector::Create(const mjModel *m, mjData *d, int instance)
   {
+    const int rollouts = std::max(1, std::stoi(GetStringAttr(m, instance, rollouts_str, "1")));
+    if (rollouts > 1)
+    {
+      // Join the group of an earlier mjData of the same model if it still waits for rollouts
+      rollout_groups_mtx.lock();
+      std::map<std::pair<const mjModel *, int>, MultiverseConnector *>::iterator rollout_group_it = rollout_groups.find({m, instance});
+      if (rollout_group_it != rollout_groups.end())
+      {
+        MultiverseConnector *multiverse_connector = rollout_group_it->second;
+        const bool is_complete = multiverse_connector->add_rollout(d);
+        if (is_complete)
+        {
+          rollout_groups.erase(rollout_group_it);
+        }
+        rollout_groups_mtx.unlock();
+
+        // The handshake blocks, so the other groups are not held up by it
+        if (is_complete)
+        {
+          multiverse_connector->connect_rollouts();
+        }
+        return multiverse_connector;
+      }
+      rollout_groups_mtx.unlock();
+    }
+
     MultiverseConfig config;
+    config.rollouts = rollouts;
     config.host = GetStringAttr(m, instance, host_str, config.host);
     config.server_port = GetStringAttr(m, instance, server_port_str, config.server_port);
     config.client_port = GetStringAttr(m, instance, client_port_str, config.client_port);
     config.world_name = GetStringAttr(m, instance, world_name_str, config.world_name);
     config.simulation_name = GetStringAttr(m, instance, simulation_name_str, config.simulation_name);
+    config.is_async = GetStringAttr(m, instance, async_str, "false") == "true";
+    config.max_staleness = std::stod(GetStringAttr(m, instance, max_staleness_str, std::to_string(config.max_staleness)));
+    config.rollout_timeout = std::stod(GetStringAttr(m, instance, rollout_timeout_str, std::to_string(config.rollout_timeout)));
+    if (config.is_async && config.rollouts > 1)
+    {
+      mju_warning("async is not supported with rollouts, the rollouts communicate synchronously\n");
+      config.is_async = false;
+    }
 
     Json::Reader reader;
 
@@ -357,7 +604,7 @@ namespace mujoco::plugin::multiverse_connector
           {
             const std::string attribute_name = attribute_json.asString();
             int attr_size = 0;
-            if (is_attribute_valid(object_name, attribute_name, object_type_int, attr_size, m))
+            if (is_attribute_valid(object_id, get_attribute(attribute_name), object_type_int, attr_size, m))
             {
               config.send_objects[object_name].insert(attribute_name);
             }
@@ -369,13 +616,15 @@ namespace mujoco::plugin::multiverse_connector
     for (const std::string &object_name : send_json.getMemberNames())
     {
       config.send_objects[object_name] = {};
+      const std::map<int, int> object_ids = get_object_ids(m, object_name);
       for (const Json::Value &attribute_json : send_json[object_name])
       {
         const std::string attribute_name = attribute_json.asString();
-        for (const int obj_type : {mjOBJ_BODY, mjOBJ_JOINT, mjOBJ_ACTUATOR})
+        const EAttribute attribute = get_attribute(attribute_name);
+        for (const std::pair<const int, int> &object_id : object_ids)
         {
           int attr_size = 0;
-          if (is_attribute_valid(object_name, attribute_name, obj_type, attr_size, m))
+          if (is_attribute_valid(object_id.second, attribute, object_id.first, attr_size, m))
           {
             config.send_objects[object_name].insert(attribute_name);
           }
@@ -389,13 +638,15 @@ namespace mujoco::plugin::multiverse_connector
     for (const std::string &object_name : receive_json.getMemberNames())
     {
       config.receive_objects[object_name] = {};
+      const std::map<int, int> object_ids = get_object_ids(m, object_name);
       for (const Json::Value &attribute_json : receive_json[object_name])
       {
         const std::string attribute_name = attribute_json.asString();
-        for (const int obj_type : {mjOBJ_BODY, mjOBJ_JOINT, mjOBJ_ACTUATOR})
+        const EAttribute attribute = get_attribute(attribute_name);
+        for (const std::pair<const int, int> &object_id : object_ids)
         {
           int attr_size = 0;
-          if (is_attribute_valid(object_name, attribute_name, obj_type, attr_size, m))
+          if (is_attribute_valid(object_id.second, attribute, object_id.first, attr_size, m))
           {
             config.receive_objects[object_name].insert(attribute_name);
           }
@@ -403,15 +654,241 @@ namespace mujoco::plugin::multiverse_connector
       }
     }
 
-    return new MultiverseConnector(config, m, d);
+    std::string sensors_json_str = GetStringAttr(m, instance, sensors_str);
+    const Json::Value sensors_json = string_to_json(sensors_json_str);
+    for (const Json::Value &sensor_json : sensors_json)
+    {
+      const std::string sensor_name = sensor_json.asString();
+      const int sensor_id = mj_name2id(m, mjOBJ_SENSOR, sensor_name.c_str());
+      if (sensor_id == -1)
+      {
+        mju_warning("Sensor %s not found\n", sensor_name.c_str());
+        continue;
+      }
+      config.sensor_ids.push_back(sensor_id);
+    }
+    if (!config.sensor_ids.empty())
+    {
+      config.send_objects[config.simulation_name].insert("sensors");
+    }
+
+    MultiverseConnector *multiverse_connector = new MultiverseConnector(config, m, d);
+    if (rollouts > 1)
+    {
+      rollout_groups_mtx.lock();
+      rollout_groups[{m, instance}] = multiverse_connector;
+      rollout_groups_mtx.unlock();
+    }
+    return multiverse_connector;
+  }
+
+  bool MultiverseConnector::add_rollout(mjData *d)
+  {
+    rollout_mtx.lock();
+    rollouts.emplace_back();
+    rollouts.back().d = d;
+    const bool is_complete = (int)rollouts.size() == config_.rollouts;
+    rollout_mtx.unlock();
+    return is_complete;
+  }
+
+  void MultiverseConnector::connect_rollouts()
+  {
+    connect();
+
+    communicate(true);
+
+    rollout_mtx.lock();
+    is_rollout_group_ready = true;
+    rollout_mtx.unlock();
+  }
+
+  bool MultiverseConnector::RemoveRollout(mjData *d)
+  {
+    if (config_.rollouts == 1)
+    {
+      return true;
+    }
+
+    rollout_groups_mtx.lock();
+    for (std::map<std::pair<const mjModel *, int>, MultiverseConnector *>::iterator rollout_group_it = rollout_groups.begin(); rollout_group_it != rollout_groups.end();)
+    {
+      rollout_group_it = rollout_group_it->second == this ? rollout_groups.erase(rollout_group_it) : std::next(rollout_group_it);
+    }
+    rollout_groups_mtx.unlock();
+
+    // The combined frame needs every rollout, so the remaining ones stop communicating
+    rollout_mtx.lock();
+    is_rollout_group_ready = false;
+    int rollout_num = 0;
+    for (Rollout &rollout : rollouts)
+    {
+      if (rollout.d == d)
+      {
+        rollout.d = nullptr;
+      }
+      rollout_num += rollout.d != nullptr ? 1 : 0;
+    }
+    rollout_mtx.unlock();
+    rollout_cv.notify_all();
+    return rollout_num == 0;
+  }
+
+  void MultiverseConnector::step_rollouts(mjData *d)
+  {
+    std::unique_lock<std::mutex> lock(rollout_mtx);
+    if (!is_rollout_group_ready)
+    {
+      return;
+    }
+
+    std::vector<Rollout>::iterator rollout_it = std::find_if(rollouts.begin(), rollouts.end(), [d](const Rollout &rollout)
+                                                             { return rollout.d == d; });
+    if (rollout_it == rollouts.end())
+    {
+      return;
+    }
+    Rollout &rollout = *rollout_it;
+    if (rollout.is_reset_requested)
+    {
+      d->time = 0.0;
+      rollout.is_reset_requested = false;
+    }
+
+    if (rollout.round != rollout_round)
+    {
+      // The rollout missed the last exchange, it sends its own values now and joins the next round with its next step
+      for (Rollout &other_rollout : rollouts)
+      {
+        other_rollout.is_exchanged = &other_rollout == &rollout;
+      }
+      communicate();
+      rollout.round = rollout_round;
+      return;
+    }
+
+    rollout.is_arrived = true;
+    const size_t round = rollout_round;
+    if (++rollout_arrivals < config_.rollouts)
+    {
+      const std::chrono::duration<mjtNum> rollout_timeout(config_.rollout_timeout);
+      if (rollout_cv.wait_for(lock, rollout_timeout, [this, round]
+                              { return rollout_round != round || !is_rollout_group_ready; }))
+      {
+        return;
+      }
+    }
+
+    // Only the rollouts that wait here are exchanged, after a timeout the others may still be stepping
+    for (Rollout &arrived_rollout : rollouts)
+    {
+      arrived_rollout.is_exchanged = arrived_rollout.is_arrived;
+      arrived_rollout.is_arrived = false;
+      arrived_rollout.round += arrived_rollout.is_exchanged ? 1 : 0;
+    }
+    communicate();
+    rollout_arrivals = 0;
+    rollout_round++;
+    rollout_cv.notify_all();
   }
 
   void MultiverseConnector::Reset(mjtNum *plugin_state) {}
 
   void MultiverseConnector::Compute(const mjModel *m, mjData *d, int instance)
   {
-    communicate();
-    // const std::vector<int> sensor_ids = get_sensor_ids(m, instance);
+    if (config_.rollouts > 1)
+    {
+      step_rollouts(d);
+      return;
+    }
+
+    if (!config_.is_async)
+    {
+      communicate();
+      return;
+    }
+
+    if (is_reset_requested.exchange(false))
+    {
+      d->time = 0.0;
+    }
+
+    // Skip the step if the communication thread is rebinding the meta data, the last controls stay applied
+    if (data_vec_mtx.try_lock())
+    {
+      if (is_response_meta_data_pending.exchange(false))
+      {
+        apply_response_meta_data(pending_response_meta_data_json);
+      }
+
+      calculate_contact_efforts(rollouts[0].contact_efforts, rollouts[0].contact_dof_chains, m, d);
+      std::vector<mjtNum> &state = state_buffer.write_buffer();
+      state.resize(send_data_vec.size() + 1);
+      state[0] = d->time;
+      gather_data_runs(send_data_runs, rollouts, state.data() + 1);
+      state_buffer.publish();
+      state_cv.notify_one();
+
+      apply_controls(m, d);
+      data_vec_mtx.unlock();
+    }
+
+    // Only wait for the server if the controls lag behind the simulation by more than max_staleness
+    while (is_communicating && config_.max_staleness >= 0.0 && d->time - control_time > config_.max_staleness)
+    {
+      {
+        std::unique_lock<std::mutex> lock(control_mtx);
+        control_cv.wait_for(lock, std::chrono::milliseconds(1), [this]
+                            { return control_buffer.has_update() || !is_communicating; });
+      }
+      if (data_vec_mtx.try_lock())
+      {
+        apply_controls(m, d);
+        data_vec_mtx.unlock();
+      }
+    }
+  }
+
+  bool MultiverseConnector::apply_controls(const mjModel *m, mjData *d)
+  {
+    if (!control_buffer.update())
+    {
+      return false;
+    }
+
+    const std::vector<mjtNum> &control = control_buffer.read_buffer();
+    control_time = control[0];
+    if (control.size() != receive_data_vec.size() + 1)
+    {
+      mju_warning("Mismatch between receive_data_vec [%zd] and the received controls [%zd]\n", receive_data_vec.size(), control.size() - 1);
+      return true;
+    }
+
+    calculate_odom_velocities(rollouts[0].odom_bodies, rollouts[0].odom_angles, d);
+
+    scatter_data_runs(receive_data_runs, rollouts, control.data() + 1);
+    return true;
+  }
+
+  void MultiverseConnector::run_communication()
+  {
+    while (is_communicating)
+    {
+      {
+        std::unique_lock<std::mutex> lock(state_mtx);
+        state_cv.wait_for(lock, std::chrono::milliseconds(1), [this]
+                          { return state_buffer.has_update() || !is_communicating; });
+      }
+
+      // Always send the latest state, the states in between are dropped
+      if (!is_communicating || !state_buffer.update())
+      {
+        continue;
+      }
+
+      communicate();
+      control_cv.notify_one();
+    }
   }
 
   void MultiverseConnector::Advance(const mjModel *m, mjData *d, int instance) const
@@ -431,7 +908,7 @@ namespace mujoco::plugin::multiverse_connector
     plugin.name = "mujoco.multiverse_connector";
     plugin.capabilityflags |= mjPLUGIN_PASSIVE;
 
-    std::vector<const char *> attributes = {host_str, server_port_str, client_port_str, world_name_str, simulation_name_str, send_str, receive_str};
+    std::vector<const char *> attributes = {host_str, server_port_str, client_port_str, world_name_str, simulation_name_str, send_str, receive_str, async_str, max_staleness_str, sensors_str, rollouts_str, rollout_timeout_str};
     plugin.nattribute = attributes.size();
     plugin.attributes = attributes.data();
     plugin.nstate = MultiverseConnector::StateSize;
@@ -447,7 +924,11 @@ namespace mujoco::plugin::multiverse_connector
     };
     plugin.destroy = +[](mjData *d, int instance)
     {
-      delete reinterpret_cast<MultiverseConnector *>(d->plugin_data[instance]);
+      MultiverseConnector *multiverse_connector = reinterpret_cast<MultiverseConnector *>(d->plugin_data[instance]);
+      if (multiverse_connector->RemoveRollout(d))
+      {
+        delete multiverse_connector;
+      }
       d->plugin_data[instance] = 0;
     };
     plugin.reset = +[](const mjModel *m, mjtNum *plugin_state, void *plugin_data,
@@ -476,9 +957,36 @@ namespace mujoco::plugin::multiverse_connector
 
     printf("Multiverse Server: %s:%s - Multiverse Client: %s:%s\n", host.c_str(), server_port.c_str(), host.c_str(), client_port.c_str());
 
+    rollouts.reserve(config_.rollouts);
+    rollouts.emplace_back();
+    rollouts.back().d = d;
+    if (config_.rollouts > 1)
+    {
+      // The group connects once the other rollouts joined
+      return;
+    }
+
     connect();
 
     communicate(true);
+
+    if (config_.is_async)
+    {
+      is_communicating = true;
+      communication_thread = std::thread(&MultiverseConnector::run_communication, this);
+    }
+  }
+
+  MultiverseConnector::~MultiverseConnector()
+  {
+    is_communicating = false;
+    state_cv.notify_one();
+    if (communication_thread.joinable())
+    {
+      // The communication thread may wait for the server without a timeout
+      interrupt();
+      communication_thread.join();
+    }
   }
 
   void MultiverseConnector::start_connect_to_server_thread()
@@ -501,6 +1009,7 @@ namespace mujoco::plugin::multiverse_connector
 
   bool MultiverseConnector::init_objects(bool from_request_meta_data)
   {
+    data_vec_mtx.lock();
     if (from_request_meta_data)
     {
       if (request_meta_data_json["receive"].empty())
@@ -513,6 +1022,11 @@ namespace mujoco::plugin::multiverse_connector
       }
       for (const std::string &object_name : request_meta_data_json["receive"].getMemberNames())
       {
+        std::string base_name;
+        if (get_rollout_index(object_name, config_.rollouts, base_name) > 0) // The replicas are added by compile_object_table
+        {
+          continue;
+        }
         for (const Json::Value &attribute_json : request_meta_data_json["receive"][object_name])
         {
           const std::string attribute_name = attribute_json.asString();
@@ -521,6 +1035,11 @@ namespace mujoco::plugin::multiverse_connector
       }
       for (const std::string &object_name : request_meta_data_json["send"].getMemberNames())
       {
+        std::string base_name;
+        if (get_rollout_index(object_name, config_.rollouts, base_name) > 0) // The replicas are added by compile_object_table
+        {
+          continue;
+        }
         for (const Json::Value &attribute_json : request_meta_data_json["send"][object_name])
         {
           const std::string attribute_name = attribute_json.asString();
@@ -549,7 +1068,8 @@ namespace mujoco::plugin::multiverse_connector
       bool stop = !send_object.second.empty(); // Skip if object has no attributes
       for (const std::string &attribute_name : send_object.second)
       {
-        if (strcmp(attribute_name.c_str(), "position") == 0 || strcmp(attribute_name.c_str(), "quaternion") == 0)
+        const EAttribute attribute = get_attribute(attribute_name);
+        if (attribute == EAttribute::Position || attribute == EAttribute::Quaternion)
         {
           stop = false;
         }
@@ -559,9 +1079,10 @@ namespace mujoco::plugin::multiverse_connector
         continue;
       }
 
-      if (mj_name2id(m_, mjtObj::mjOBJ_BODY, object_name.c_str()) == -1 &&
-          mj_name2id(m_, mjtObj::mjOBJ_JOINT, object_name.c_str()) == -1 &&
-          mj_name2id(m_, mjtObj::mjOBJ_ACTUATOR, object_name.c_str()) == -1 &&
+      const MujocoObject &object = resolve_object(object_name);
+      if (object.body_id == -1 &&
+          object.joint_id == -1 &&
+          object.actuator_id == -1 &&
           !(config_.receive_objects.count(object_name) > 0 &&
             config_.receive_objects[object_name].empty())) // If object does not exist as body or joint or actuator and has no receive attributes
       {
@@ -574,9 +1095,117 @@ namespace mujoco::plugin::multiverse_connector
         objects_to_destroy.insert(object_name); // Then add object to destroy
       }
     }
+
+    compile_object_table();
+    data_vec_mtx.unlock();
     return true;
   }
 
+  MujocoObject &MultiverseConnector::resolve_object(const std::string &object_name)
+  {
+    std::map<std::string, MujocoObject>::iterator object_it = object_table.find(object_name);
+    if (object_it != object_table.end())
+    {
+      return object_it->second;
+    }
+
+    std::string base_name;
+    const int rollout = get_rollout_index(object_name, config_.rollouts, base_name);
+    if (rollout > 0)
+    {
+      // Rollouts share the ids of the model
+      const MujocoObject base_object = resolve_object(base_name);
+      MujocoObject &object = object_table[object_name];
+      object = base_object;
+      object.name = object_name;
+      object.rollout = rollout;
+      object.send_attributes.clear();
+      object.receive_attributes.clear();
+      return object;
+    }
+
+    MujocoObject &object = object_table[object_name];
+    object.name = object_name;
+    object.body_id = mj_name2id(m_, mjtObj::mjOBJ_BODY, object_name.c_str());
+    if (object.body_id != -1)
+    {
+      object.mocap_id = m_->body_mocapid[object.body_id];
+      object.body_state = get_body_state(m_, object.body_id);
+      object.body_dof_adr = m_->body_dofadr[object.body_id];
+      if (m_->body_jntadr[object.body_id] != -1)
+      {
+        object.body_qpos_adr = m_->jnt_qposadr[m_->body_jntadr[object.body_id]];
+      }
+    }
+    object.joint_id = mj_name2id(m_, mjtObj::mjOBJ_JOINT, object_name.c_str());
+    if (object.joint_id != -1)
+    {
+      object.joint_type = m_->jnt_type[object.joint_id];
+      object.joint_qpos_adr = m_->jnt_qposadr[object.joint_id];
+      object.joint_dof_adr = m_->jnt_dofadr[object.joint_id];
+    }
+    object.actuator_id = mj_name2id(m_, mjtObj::mjOBJ_ACTUATOR, object_name.c_str());
+    object.is_sensor_object = object_name == config_.simulation_name && !config_.sensor_ids.empty();
+    return object;
+  }
+
+  void MultiverseConnector::compile_object_table()
+  {
+    // The rollouts of an object are sorted by name like all other objects, as the server orders the data
+    std::map<std::string, const MujocoObject *> send_objects;
+    for (const std::pair<const std::string, std::set<std::string>> &send_object : config_.send_objects)
+    {
+      for (int rollout = 0; rollout < config_.rollouts; rollout++)
+      {
+        MujocoObject &object = resolve_object(get_rollout_name(send_object.first, rollout));
+        object.send_attributes.clear();
+        for (const std::string &attribute_name : send_object.second)
+        {
+          object.send_attributes.emplace_back(attribute_name, get_attribute(attribute_name));
+        }
+        if (object.body_id != -1 || object.joint_id != -1 || object.actuator_id != -1 || object.is_sensor_object)
+        {
+          send_objects[object.name] = &object;
+        }
+      }
+    }
+
+    std::map<std::string, const MujocoObject *> receive_objects;
+    for (const std::pair<const std::string, std::set<std::string>> &receive_object : config_.receive_objects)
+    {
+      for (int rollout = 0; rollout < config_.rollouts; rollout++)
+      {
+        MujocoObject &object = resolve_object(get_rollout_name(receive_object.first, rollout));
+        object.receive_attributes.clear();
+        for (const std::string &attribute_name : receive_object.second)
+        {
+          object.receive_attributes.emplace_back(attribute_name, get_attribute(attribute_name));
+        }
+        if (object.body_id != -1 || object.joint_id != -1 || object.actuator_id != -1)
+        {
+          receive_objects[object.name] = &object;
+        }
+      }
+    }
+
+    send_table.clear();
+    for (const std::pair<const std::string, const MujocoObject *> &send_object : send_objects)
+    {
+      send_table.push_back(send_object.second);
+    }
+
+    receive_table.clear();
+    for (const std::pair<const std::string, const MujocoObject *> &receive_object : receive_objects)
+    {
+      receive_table.push_back(receive_object.second);
+    }
+  }
+
+  std::string MultiverseConnector::get_world_name() const
+  {
+    return config_.world_name;
+  }
+
   void MultiverseConnector::bind_request_meta_data()
   {
     const Json::Value api_callbacks = request_meta_data_json["api_callbacks"];
@@ -600,33 +1229,30 @@ namespace mujoco::plugin::multiverse_connector
     request_meta_data_json["meta_data"]["time_unit"] = "s";
     request_meta_data_json["meta_data"]["handedness"] = "rhs";
 
-    for (const std::pair<const std::string, std::set<std::string>> &send_object : config_.send_objects)
+    if (!config_.sensor_ids.empty())
     {
-      const int body_id = mj_name2id(m_, mjtObj::mjOBJ_BODY, send_object.first.c_str());
-      const int joint_id = mj_name2id(m_, mjtObj::mjOBJ_JOINT, send_object.first.c_str());
-      const int actuator_id = mj_name2id(m_, mjtObj::mjOBJ_ACTUATOR, send_object.first.c_str());
-      if (body_id != -1 || joint_id != -1 || actuator_id != -1)
+      int sensor_size = 0;
+      for (const int sensor_id : config_.sensor_ids)
       {
-        const std::string object_name = send_object.first;
-        for (const std::string &attribute_name : send_object.second)
-        {
-          request_meta_data_json["send"][object_name].append(attribute_name);
-        }
+        sensor_size += m_->sensor_dim[sensor_id];
       }
+      request_meta_data_json["meta_data"]["tensors"]["sensors"]["dtype"] = "double";
+      request_meta_data_json["meta_data"]["tensors"]["sensors"]["shape"].append(sensor_size);
     }
 
-    for (const std::pair<const std::string, std::set<std::string>> &receive_object : config_.receive_objects)
+    for (const MujocoObject *send_object : send_table)
     {
-      const int body_id = mj_name2id(m_, mjtObj::mjOBJ_BODY, receive_object.first.c_str());
-      const int joint_id = mj_name2id(m_, mjtObj::mjOBJ_JOINT, receive_object.first.c_str());
-      const int actuator_id = mj_name2id(m_, mjtObj::mjOBJ_ACTUATOR, receive_object.first.c_str());
-      if (body_id != -1 || joint_id != -1 || actuator_id != -1)
+      for (const std::pair<std::string, EAttribute> &send_attribute : send_object->send_attributes)
       {
-        const std::string object_name = receive_object.first;
-        for (const std::string &attribute_name : receive_object.second)
-        {
-          request_meta_data_json["receive"][object_name].append(attribute_name);
-        }
+        request_meta_data_json["send"][send_object->name].append(send_attribute.first);
+      }
+    }
+
+    for (const MujocoObject *receive_object : receive_table)
+    {
+      for (const std::pair<std::string, EAttribute> &receive_attribute : receive_object->receive_attributes)
+      {
+        request_meta_data_json["receive"][receive_object->name].append(receive_attribute.first);
       }
     }
 
@@ -635,35 +1261,55 @@ namespace mujoco::plugin::multiverse_connector
 
   void MultiverseConnector::bind_response_meta_data()
   {
-    for (const std::pair<const std::string, std::set<std::string>> &send_object : config_.send_objects)
+    data_vec_mtx.lock();
+    if (is_communicating)
     {
-      const int body_id = mj_name2id(m_, mjtObj::mjOBJ_BODY, send_object.first.c_str());
-      const int joint_id = mj_name2id(m_, mjtObj::mjOBJ_JOINT, send_object.first.c_str());
-      const int mocap_id = m_->body_mocapid[body_id];
-      const int actuator_id = mj_name2id(m_, mjtObj::mjOBJ_ACTUATOR, send_object.first.c_str());
+      // MuJoCo may be stepping, so the response meta data is applied in the next Compute
+      pending_response_meta_data_json = response_meta_data_json;
+      is_response_meta_data_pending = true;
+    }
+    else
+    {
+      apply_response_meta_data(response_meta_data_json);
+    }
+    data_vec_mtx.unlock();
+  }
+
+  void MultiverseConnector::apply_response_meta_data(const Json::Value &response_meta_data)
+  {
+    for (const MujocoObject *send_object : send_table)
+    {
+      Rollout &rollout = rollouts[send_object->rollout];
+      mjData *d = rollout.d;
+      const int body_id = send_object->body_id;
+      const int joint_id = send_object->joint_id;
+      const int mocap_id = send_object->mocap_id;
+      const int actuator_id = send_object->actuator_id;
       if (body_id != -1)
       {
-        const BodyState body_state = get_body_state(m_, body_id);
+        const BodyState body_state = send_object->body_state;
         switch (body_state)
         {
         case BodyState::STATIC:
         {
-          for (const std::string &attribute_name : send_object.second)
+          for (const std::pair<std::string, EAttribute> &send_attribute : send_object->send_attributes)
           {
-            const Json::Value attribute_data = response_meta_data_json["send"][send_object.first][attribute_name];
-            if (strcmp(attribute_name.c_str(), "position") == 0)
+            const std::string &attribute_name = send_attribute.first;
+            const EAttribute attribute = send_attribute.second;
+            const Json::Value attribute_data = response_meta_data["send"][send_object->name][attribute_name];
+            if (attribute == EAttribute::Position)
             {
               const Json::Value x_json = attribute_data[0];
               const Json::Value y_json = attribute_data[1];
               const Json::Value z_json = attribute_data[2];
               if (!x_json.isNull() && !y_json.isNull() && !z_json.isNull())
               {
-                d_->mocap_pos[3 * mocap_id] = x_json.asDouble();
-                d_->mocap_pos[3 * mocap_id + 1] = y_json.asDouble();
-                d_->mocap_pos[3 * mocap_id + 2] = z_json.asDouble();
+                d->mocap_pos[3 * mocap_id] = x_json.asDouble();
+                d->mocap_pos[3 * mocap_id + 1] = y_json.asDouble();
+                d->mocap_pos[3 * mocap_id + 2] = z_json.asDouble();
               }
             }
-            else if (strcmp(attribute_name.c_str(), "quaternion") == 0)
+            else if (attribute == EAttribute::Quaternion)
             {
               const Json::Value w_json = attribute_data[0];
               const Json::Value x_json = attribute_data[1];
@@ -671,10 +1317,10 @@ namespace mujoco::plugin::multiverse_connector
               const Json::Value z_json = attribute_data[3];
               if (!w_json.isNull() && !x_json.isNull() && !y_json.isNull() && !z_json.isNull())
               {
-                d_->mocap_quat[4 * mocap_id] = w_json.asDouble();
-                d_->mocap_quat[4 * mocap_id + 1] = x_json.asDouble();
-                d_->mocap_quat[4 * mocap_id + 2] = y_json.asDouble();
-                d_->mocap_quat[4 * mocap_id + 3] = z_json.asDouble();
+                d->mocap_quat[4 * mocap_id] = w_json.asDouble();
+                d->mocap_quat[4 * mocap_id + 1] = x_json.asDouble();
+                d->mocap_quat[4 * mocap_id + 2] = y_json.asDouble();
+                d->mocap_quat[4 * mocap_id + 3] = z_json.asDouble();
               }
             }
           }
@@ -683,13 +1329,15 @@ namespace mujoco::plugin::multiverse_connector
 
         case BodyState::FREE:
         {
-          mjtNum *xpos_desired = d_->xpos + 3 * body_id;
-          mjtNum *xquat_desired = d_->xquat + 4 * body_id;
+          mjtNum *xpos_desired = d->xpos + 3 * body_id;
+          mjtNum *xquat_desired = d->xquat + 4 * body_id;
 
-          for (const std::string &attribute_name : send_object.second)
+          for (const std::pair<std::string, EAttribute> &send_attribute : send_object->send_attributes)
           {
-            const Json::Value attribute_data = response_meta_data_json["send"][send_object.first][attribute_name];
-            if (strcmp(attribute_name.c_str(), "position") == 0)
+            const std::string &attribute_name = send_attribute.first;
+            const EAttribute attribute = send_attribute.second;
+            const Json::Value attribute_data = response_meta_data["send"][send_object->name][attribute_name];
+            if (attribute == EAttribute::Position)
             {
               const Json::Value x_json = attribute_data[0];
               const Json::Value y_json = attribute_data[1];
@@ -701,7 +1349,7 @@ namespace mujoco::plugin::multiverse_connector
                 xpos_desired[2] = z_json.asDouble();
               }
             }
-            else if (strcmp(attribute_name.c_str(), "quaternion") == 0)
+            else if (attribute == EAttribute::Quaternion)
             {
               const Json::Value w_json = attribute_data[0];
               const Json::Value x_json = attribute_data[1];
@@ -715,7 +1363,7 @@ namespace mujoco::plugin::multiverse_connector
                 xquat_desired[3] = z_json.asDouble();
               }
             }
-            else if (strcmp(attribute_name.c_str(), "relative_velocity") == 0)
+            else if (attribute == EAttribute::RelativeVelocity)
             {
               const Json::Value qvel_lin_x = attribute_data[0];
               const Json::Value qvel_lin_y = attribute_data[1];
@@ -725,16 +1373,16 @@ namespace mujoco::plugin::multiverse_connector
               const Json::Value qvel_ang_z = attribute_data[5];
               if (!qvel_lin_x.isNull() && !qvel_lin_y.isNull() && !qvel_lin_z.isNull() && !qvel_ang_x.isNull() && !qvel_ang_y.isNull() && !qvel_ang_z.isNull())
               {
-                const int qvel_adr = m_->body_dofadr[body_id];
-                d_->qvel[qvel_adr] = qvel_lin_x.asDouble();
-                d_->qvel[qvel_adr + 1] = qvel_lin_y.asDouble();
-                d_->qvel[qvel_adr + 2] = qvel_lin_z.asDouble();
-                d_->qvel[qvel_adr + 3] = qvel_ang_x.asDouble();
-                d_->qvel[qvel_adr + 4] = qvel_ang_y.asDouble();
-                d_->qvel[qvel_adr + 5] = qvel_ang_z.asDouble();
+                const int qvel_adr = send_object->body_dof_adr;
+                d->qvel[qvel_adr] = qvel_lin_x.asDouble();
+                d->qvel[qvel_adr + 1] = qvel_lin_y.asDouble();
+                d->qvel[qvel_adr + 2] = qvel_lin_z.asDouble();
+                d->qvel[qvel_adr + 3] = qvel_ang_x.asDouble();
+                d->qvel[qvel_adr + 4] = qvel_ang_y.asDouble();
+                d->qvel[qvel_adr + 5] = qvel_ang_z.asDouble();
               }
             }
-            else if (strcmp(attribute_name.c_str(), "odometric_velocity") == 0)
+            else if (attribute == EAttribute::OdometricVelocity)
             {
               const Json::Value odom_vel_lin_x = attribute_data[0];
               const Json::Value odom_vel_lin_y = attribute_data[1];
@@ -742,36 +1390,39 @@ namespace mujoco::plugin::multiverse_connector
               const Json::Value odom_vel_ang_x = attribute_data[3];
               const Json::Value odom_vel_ang_y = attribute_data[4];
               const Json::Value odom_vel_ang_z = attribute_data[5];
-              if (!odom_vel_lin_x.isNull() && !odom_vel_lin_y.isNull() && !odom_vel_lin_z.isNull() && !odom_vel_ang_x.isNull() && !odom_vel_ang_y.isNull() && !odom_vel_ang_z.isNull())
+              if (rollout.odom_velocities.count(body_id) > 0 &&
+                  !odom_vel_lin_x.isNull() && !odom_vel_lin_y.isNull() && !odom_vel_lin_z.isNull() && !odom_vel_ang_x.isNull() && !odom_vel_ang_y.isNull() && !odom_vel_ang_z.isNull())
               {
-                odom_velocities[body_id][0] = odom_vel_lin_x.asDouble();
-                odom_velocities[body_id][1] = odom_vel_lin_y.asDouble();
-                odom_velocities[body_id][2] = odom_vel_lin_z.asDouble();
-                odom_velocities[body_id][3] = odom_vel_ang_x.asDouble();
-                odom_velocities[body_id][4] = odom_vel_ang_y.asDouble();
-                odom_velocities[body_id][5] = odom_vel_ang_z.asDouble();
+                rollout.odom_velocities[body_id][0] = odom_vel_lin_x.asDouble();
+                rollout.odom_velocities[body_id][1] = odom_vel_lin_y.asDouble();
+                rollout.odom_velocities[body_id][2] = odom_vel_lin_z.asDouble();
+                rollout.odom_velocities[body_id][3] = odom_vel_ang_x.asDouble();
+                rollout.odom_velocities[body_id][4] = odom_vel_ang_y.asDouble();
+                rollout.odom_velocities[body_id][5] = odom_vel_ang_z.asDouble();
               }
             }
           }
 
-          const int qpos_adr = m_->jnt_qposadr[m_->body_jntadr[body_id]];
-          d_->qpos[qpos_adr] = xpos_desired[0];
-          d_->qpos[qpos_adr + 1] = xpos_desired[1];
-          d_->qpos[qpos_adr + 2] = xpos_desired[2];
-          d_->qpos[qpos_adr + 3] = xquat_desired[0];
-          d_->qpos[qpos_adr + 4] = xquat_desired[1];
-          d_->qpos[qpos_adr + 5] = xquat_desired[2];
-          d_->qpos[qpos_adr + 6] = xquat_desired[3];
+          const int qpos_adr = send_object->body_qpos_adr;
+          d->qpos[qpos_adr] = xpos_desired[0];
+          d->qpos[qpos_adr + 1] = xpos_desired[1];
+          d->qpos[qpos_adr + 2] = xpos_desired[2];
+          d->qpos[qpos_adr + 3] = xquat_desired[0];
+          d->qpos[qpos_adr + 4] = xquat_desired[1];
+          d->qpos[qpos_adr + 5] = xquat_desired[2];
+          d->qpos[qpos_adr + 6] = xquat_desired[3];
 
           break;
         }
 
         case BodyState::HANGING:
         {
-          for (const std::string &attribute_name : send_object.second)
+          for (const std::pair<std::string, EAttribute> &send_attribute : send_object->send_attributes)
           {
-            const Json::Value attribute_data = response_meta_data_json["send"][send_object.first][attribute_name];
-            if (strcmp(attribute_name.c_str(), "quaternion") == 0)
+            const std::string &attribute_name = send_attribute.first;
+            const EAttribute attribute = send_attribute.second;
+            const Json::Value attribute_data = response_meta_data["send"][send_object->name][attribute_name];
+            if (attribute == EAttribute::Quaternion)
             {
               const Json::Value w_json = attribute_data[0];
               const Json::Value x_json = attribute_data[1];
@@ -781,11 +1432,11 @@ namespace mujoco::plugin::multiverse_connector
               if (!w_json.isNull() && !x_json.isNull() && !y_json.isNull() && !z_json.isNull())
               {
                 const mjtNum xquat_desired[4] = {w_json.asDouble(), x_json.asDouble(), y_json.asDouble(), z_json.asDouble()};
-                mjtNum *xquat_current_neg = d_->xquat + 4 * body_id;
+                mjtNum *xquat_current_neg = d->xquat + 4 * body_id;
                 mju_negQuat(xquat_current_neg, xquat_current_neg);
 
-                const int qpos_id = m_->jnt_qposadr[m_->body_jntadr[body_id]];
-                mju_mulQuat(d_->qpos + qpos_id, xquat_current_neg, xquat_desired);
+                const int qpos_id = send_object->body_qpos_adr;
+                mju_mulQuat(d->qpos + qpos_id, xquat_current_neg, xquat_desired);
               }
             }
           }
@@ -800,31 +1451,33 @@ namespace mujoco::plugin::multiverse_connector
 
         if (body_state != BodyState::STATIC)
         {
-          for (const std::string &attribute_name : send_object.second)
+          for (const std::pair<std::string, EAttribute> &send_attribute : send_object->send_attributes)
           {
-            const Json::Value attribute_data = response_meta_data_json["send"][send_object.first][attribute_name];
-            if (strcmp(attribute_name.c_str(), "force") == 0)
+            const std::string &attribute_name = send_attribute.first;
+            const EAttribute attribute = send_attribute.second;
+            const Json::Value attribute_data = response_meta_data["send"][send_object->name][attribute_name];
+            if (attribute == EAttribute::Force)
             {
               const Json::Value x_json = attribute_data[0];
               const Json::Value y_json = attribute_data[1];
               const Json::Value z_json = attribute_data[2];
               if (!x_json.isNull() && !y_json.isNull() && !z_json.isNull())
               {
-                d_->xfrc_applied[6 * body_id] = x_json.asDouble();
-                d_->xfrc_applied[6 * body_id + 1] = y_json.asDouble();
-                d_->xfrc_applied[6 * body_id + 2] = z_json.asDouble();
+                d->xfrc_applied[6 * body_id] = x_json.asDouble();
+                d->xfrc_applied[6 * body_id + 1] = y_json.asDouble();
+                d->xfrc_applied[6 * body_id + 2] = z_json.asDouble();
               }
             }
-            else if (strcmp(attribute_name.c_str(), "torque") == 0)
+            else if (attribute == EAttribute::Torque)
             {
               const Json::Value x_json = attribute_data[0];
               const Json::Value y_json = attribute_data[1];
               const Json::Value z_json = attribute_data[2];
               if (!x_json.isNull() && !y_json.isNull() && !z_json.isNull())
               {
-                d_->xfrc_applied[6 * body_id + 3] = x_json.asDouble();
-                d_->xfrc_applied[6 * body_id + 4] = y_json.asDouble();
-                d_->xfrc_applied[6 * body_id + 5] = z_json.asDouble();
+                d->xfrc_applied[6 * body_id + 3] = x_json.asDouble();
+                d->xfrc_applied[6 * body_id + 4] = y_json.asDouble();
+                d->xfrc_applied[6 * body_id + 5] = z_json.asDouble();
               }
             }
           }
@@ -832,53 +1485,55 @@ namespace mujoco::plugin::multiverse_connector
       }
       if (joint_id != -1)
       {
-        const bool is_revolute_joint = m_->jnt_type[joint_id] == mjtJoint::mjJNT_HINGE;
-        const bool is_prismatic_joint = m_->jnt_type[joint_id] == mjtJoint::mjJNT_SLIDE;
-        const bool is_ball_joint = m_->jnt_type[joint_id] == mjtJoint::mjJNT_BALL;
-        for (const std::string &attribute_name : send_object.second)
+        const bool is_revolute_joint = send_object->joint_type == mjtJoint::mjJNT_HINGE;
+        const bool is_prismatic_joint = send_object->joint_type == mjtJoint::mjJNT_SLIDE;
+        const bool is_ball_joint = send_object->joint_type == mjtJoint::mjJNT_BALL;
+        for (const std::pair<std::string, EAttribute> &send_attribute : send_object->send_attributes)
         {
-          const Json::Value attribute_data = response_meta_data_json["send"][send_object.first][attribute_name];
-          if ((strcmp(attribute_name.c_str(), "joint_rvalue") == 0 && is_revolute_joint) ||
-              (strcmp(attribute_name.c_str(), "joint_tvalue") == 0 && is_prismatic_joint))
+          const std::string &attribute_name = send_attribute.first;
+          const EAttribute attribute = send_attribute.second;
+          const Json::Value attribute_data = response_meta_data["send"][send_object->name][attribute_name];
+          if ((attribute == EAttribute::JointRvalue && is_revolute_joint) ||
+              (attribute == EAttribute::JointTvalue && is_prismatic_joint))
           {
             const Json::Value v_json = attribute_data[0];
             if (!v_json.isNull())
             {
-              const int qpos_id = m_->jnt_qposadr[joint_id];
-              d_->qpos[qpos_id] = v_json.asDouble();
+              const int qpos_id = send_object->joint_qpos_adr;
+              d->qpos[qpos_id] = v_json.asDouble();
             }
           }
-          else if ((strcmp(attribute_name.c_str(), "joint_angular_velocity") == 0 && is_revolute_joint) ||
-                   (strcmp(attribute_name.c_str(), "joint_linear_velocity") == 0 && is_prismatic_joint))
+          else if ((attribute == EAttribute::JointAngularVelocity && is_revolute_joint) ||
+                   (attribute == EAttribute::JointLinearVelocity && is_prismatic_joint))
           {
             const Json::Value v_json = attribute_data[0];
             if (!v_json.isNull())
             {
-              const int dof_id = m_->jnt_dofadr[joint_id];
-              d_->qvel[dof_id] = v_json.asDouble();
+              const int dof_id = send_object->joint_dof_adr;
+              d->qvel[dof_id] = v_json.asDouble();
             }
           }
-          else if ((strcmp(attribute_name.c_str(), "joint_angular_acceleration") == 0 && is_revolute_joint) ||
-                   (strcmp(attribute_name.c_str(), "joint_linear_acceleration") == 0 && is_prismatic_joint))
+          else if ((attribute == EAttribute::JointAngularAcceleration && is_revolute_joint) ||
+                   (attribute == EAttribute::JointLinearAcceleration && is_prismatic_joint))
           {
             const Json::Value v_json = attribute_data[0];
             if (!v_json.isNull())
             {
-              const int dof_id = m_->jnt_dofadr[joint_id];
-              d_->qacc[dof_id] = v_json.asDouble();
+              const int dof_id = send_object->joint_dof_adr;
+              d->qacc[dof_id] = v_json.asDouble();
             }
           }
-          else if ((strcmp(attribute_name.c_str(), "joint_torque") == 0 && is_revolute_joint) ||
-                   (strcmp(attribute_name.c_str(), "joint_force") == 0 && is_prismatic_joint))
+          else if ((attribute == EAttribute::JointTorque && is_revolute_joint) ||
+                   (attribute == EAttribute::JointForce && is_prismatic_joint))
           {
             const Json::Value v_json = attribute_data[0];
             if (!v_json.isNull())
             {
-              const int dof_id = m_->jnt_dofadr[joint_id];
-              d_->qfrc_applied[dof_id] = v_json.asDouble();
+              const int dof_id = send_object->joint_dof_adr;
+              d->qfrc_applied[dof_id] = v_json.asDouble();
             }
           }
-          else if ((strcmp(attribute_name.c_str(), "joint_quaternion") == 0 && is_ball_joint))
+          else if ((attribute == EAttribute::JointQuaternion && is_ball_joint))
           {
             const Json::Value w_json = attribute_data[0];
             const Json::Value x_json = attribute_data[1];
@@ -887,27 +1542,29 @@ namespace mujoco::plugin::multiverse_connector
 
             if (!w_json.isNull() && !x_json.isNull() && !y_json.isNull() && !z_json.isNull())
             {
-              const int qpos_adr = m_->jnt_qposadr[joint_id];
-              d_->qpos[qpos_adr] = w_json.asDouble();
-              d_->qpos[qpos_adr + 1] = x_json.asDouble();
-              d_->qpos[qpos_adr + 2] = y_json.asDouble();
-              d_->qpos[qpos_adr + 3] = z_json.asDouble();
+              const int qpos_adr = send_object->joint_qpos_adr;
+              d->qpos[qpos_adr] = w_json.asDouble();
+              d->qpos[qpos_adr + 1] = x_json.asDouble();
+              d->qpos[qpos_adr + 2] = y_json.asDouble();
+              d->qpos[qpos_adr + 3] = z_json.asDouble();
             }
           }
         }
       }
       if (actuator_id != -1)
       {
-        for (const std::string &attribute_name : send_object.second)
+        for (const std::pair<std::string, EAttribute> &send_attribute : send_object->send_attributes)
         {
-          if (strcmp(attribute_name.c_str(), "cmd_joint_rvalue") == 0 ||
-              strcmp(attribute_name.c_str(), "cmd_joint_tvalue") == 0 ||
-              strcmp(attribute_name.c_str(), "cmd_joint_angular_velocity") == 0 ||
-              strcmp(attribute_name.c_str(), "cmd_joint_linear_velocity") == 0 ||
-              strcmp(attribute_name.c_str(), "cmd_joint_torque") == 0 ||
-              strcmp(attribute_name.c_str(), "cmd_joint_force") == 0)
+          const std::string &attribute_name = send_attribute.first;
+          const EAttribute attribute = send_attribute.second;
+          if (attribute == EAttribute::CmdJointRvalue ||
+              attribute == EAttribute::CmdJointTvalue ||
+              attribute == EAttribute::CmdJointAngularVelocity ||
+              attribute == EAttribute::CmdJointLinearVelocity ||
+              attribute == EAttribute::CmdJointTorque ||
+              attribute == EAttribute::CmdJointForce)
           {
-            d_->ctrl[actuator_id] = response_meta_data_json["send"][send_object.first][attribute_name][0].asDouble();
+            d->ctrl[actuator_id] = response_meta_data["send"][send_object->name][attribute_name][0].asDouble();
           }
         }
       }
@@ -924,46 +1581,85 @@ namespace mujoco::plugin::multiverse_connector
 
   void MultiverseConnector::clean_up()
   {
+    data_vec_mtx.lock();
     send_data_vec.clear();
+    receive_data_vec.clear();
+    send_data_rollouts.clear();
+    receive_data_rollouts.clear();
+    send_data_runs.clear();
+    receive_data_runs.clear();
 
-    for (std::pair<const int, mjtNum *> &contact_effort : contact_efforts)
+    for (Rollout &rollout : rollouts)
     {
-      free(contact_effort.second);
+      for (std::pair<const int, mjtNum *> &contact_effort : rollout.contact_efforts)
+      {
+        free(contact_effort.second);
+      }
+      rollout.contact_efforts.clear();
+      rollout.contact_dof_chains.clear();
+
+      for (std::pair<const int, mjtNum *> &odom_velocity : rollout.odom_velocities)
+      {
+        free(odom_velocity.second);
+      }
+      rollout.odom_velocities.clear();
+      rollout.odom_bodies.clear();
     }
-    contact_efforts.clear();
+    data_vec_mtx.unlock();
   }
 
   void MultiverseConnector::reset()
   {
-    d_->time = 0.0;
+    if (config_.is_async)
+    {
+      // MuJoCo may be stepping, so the time is reset in the next Compute
+      is_reset_requested = true;
+      return;
+    }
+    for (Rollout &rollout : rollouts)
+    {
+      if (rollout.is_exchanged)
+      {
+        rollout.d->time = 0.0;
+      }
+      else
+      {
+        rollout.is_reset_requested = true;
+      }
+    }
   }
 
   void MultiverseConnector::init_send_and_receive_data()
   {
-    for (const std::pair<const std::string, std::set<std::string>> &send_object : config_.send_objects)
+    data_vec_mtx.lock();
+    for (const MujocoObject *send_object : send_table)
     {
-      const int body_id = mj_name2id(m_, mjtObj::mjOBJ_BODY, send_object.first.c_str());
-      const int mocap_id = m_->body_mocapid[body_id];
-      const int joint_id = mj_name2id(m_, mjtObj::mjOBJ_JOINT, send_object.first.c_str());
+      Rollout &rollout = rollouts[send_object->rollout];
+      mjData *d = rollout.d;
+      const int body_id = send_object->body_id;
+      const int mocap_id = send_object->mocap_id;
+      const int joint_id = send_object->joint_id;
       if (body_id != -1)
       {
-        const std::string body_name = send_object.first;
+        const std::string body_name = send_object->name;
         if (mocap_id != -1)
         {
-          for (const std::string &attribute_name : send_object.second)
+          for (const std::pair<std::string, EAttribute> &send_attribute : send_object->send_attributes)
           {
-            if (strcmp(attribute_name.c_str(), "position") == 0)
+            const std::string &attribute_name = send_attribute.first;
+            const EAttribute attribute = send_attribute.second;
+            if (attribute == EAttribute::Position)
             {
-              send_data_vec.emplace_back(&d_->mocap_pos[3 * mocap_id]);
-              send_data_vec.emplace_back(&d_->mocap_pos[3 * mocap_id + 1]);
-              send_data_vec.emplace_back(&d_->mocap_pos[3 * mocap_id + 2]);
+              send_data_vec.emplace_back(&d->mocap_pos[3 * mocap_id]);
+              send_data_vec.emplace_back(&d->mocap_pos[3 * mocap_id + 1]);
+              send_data_vec.emplace_back(&d->mocap_pos[3 * mocap_id + 2]);
             }
-            else if (strcmp(attribute_name.c_str(), "quaternion") == 0)
+            else if (attribute == EAttribute::Quaternion)
             {
-              send_data_vec.emplace_back(&d_->mocap_quat[4 * mocap_id]);
-              send_data_vec.emplace_back(&d_->mocap_quat[4 * mocap_id + 1]);
-              send_data_vec.emplace_back(&d_->mocap_quat[4 * mocap_id + 2]);
-              send_data_vec.emplace_back(&d_->mocap_quat[4 * mocap_id + 3]);
+              send_data_vec.emplace_back(&d->mocap_quat[4 * mocap_id]);
+              send_data_vec.emplace_back(&d->mocap_quat[4 * mocap_id + 1]);
+              send_data_vec.emplace_back(&d->mocap_quat[4 * mocap_id + 2]);
+              send_data_vec.emplace_back(&d->mocap_quat[4 * mocap_id + 3]);
             }
             else
             {
@@ -973,107 +1669,110 @@ namespace mujoco::plugin::multiverse_connector
         }
         else
         {
-          const int dof_id = m_->body_dofadr[body_id];
-          const BodyState body_state = get_body_state(m_, body_id);
-          for (const std::string &attribute_name : send_object.second)
+          const int dof_id = send_object->body_dof_adr;
+          const BodyState body_state = send_object->body_state;
+          for (const std::pair<std::string, EAttribute> &send_attribute : send_object->send_attributes)
           {
-            if (strcmp(attribute_name.c_str(), "position") == 0)
+            const EAttribute attribute = send_attribute.second;
+            if (attribute == EAttribute::Position)
             {
-              send_data_vec.emplace_back(&d_->xpos[3 * body_id]);
-              send_data_vec.emplace_back(&d_->xpos[3 * body_id + 1]);
-              send_data_vec.emplace_back(&d_->xpos[3 * body_id + 2]);
+              send_data_vec.emplace_back(&d->xpos[3 * body_id]);
+              send_data_vec.emplace_back(&d->xpos[3 * body_id + 1]);
+              send_data_vec.emplace_back(&d->xpos[3 * body_id + 2]);
             }
-            else if (strcmp(attribute_name.c_str(), "quaternion") == 0)
+            else if (attribute == EAttribute::Quaternion)
             {
-              send_data_vec.emplace_back(&d_->xquat[4 * body_id]);
-              send_data_vec.emplace_back(&d_->xquat[4 * body_id + 1]);
-              send_data_vec.emplace_back(&d_->xquat[4 * body_id + 2]);
-              send_data_vec.emplace_back(&d_->xquat[4 * body_id + 3]);
+              send_data_vec.emplace_back(&d->xquat[4 * body_id]);
+              send_data_vec.emplace_back(&d->xquat[4 * body_id + 1]);
+              send_data_vec.emplace_back(&d->xquat[4 * body_id + 2]);
+              send_data_vec.emplace_back(&d->xquat[4 * body_id + 3]);
             }
-            else if (strcmp(attribute_name.c_str(), "force") == 0 && body_state == BodyState::FREE)
+            else if (attribute == EAttribute::Force && body_state == BodyState::FREE)
             {
-              if (contact_efforts.count(body_id) == 0)
+              if (rollout.contact_efforts.count(body_id) == 0)
               {
-                contact_efforts[body_id] = (mjtNum *)calloc(6, sizeof(mjtNum));
+                rollout.contact_efforts[body_id] = (mjtNum *)calloc(6, sizeof(mjtNum));
               }
 
-              send_data_vec.emplace_back(&contact_efforts[body_id][0]);
-              send_data_vec.emplace_back(&contact_efforts[body_id][1]);
-              send_data_vec.emplace_back(&contact_efforts[body_id][2]);
+              send_data_vec.emplace_back(&rollout.contact_efforts[body_id][0]);
+              send_data_vec.emplace_back(&rollout.contact_efforts[body_id][1]);
+              send_data_vec.emplace_back(&rollout.contact_efforts[body_id][2]);
             }
-            else if (strcmp(attribute_name.c_str(), "torque") == 0 && body_state == BodyState::FREE)
+            else if (attribute == EAttribute::Torque && body_state == BodyState::FREE)
             {
-              if (contact_efforts.count(body_id) == 0)
+              if (rollout.contact_efforts.count(body_id) == 0)
               {
-                contact_efforts[body_id] = (mjtNum *)calloc(6, sizeof(mjtNum));
+                rollout.contact_efforts[body_id] = (mjtNum *)calloc(6, sizeof(mjtNum));
               }
 
-              send_data_vec.emplace_back(&contact_efforts[body_id][3]);
-              send_data_vec.emplace_back(&contact_efforts[body_id][4]);
-              send_data_vec.emplace_back(&contact_efforts[body_id][5]);
+              send_data_vec.emplace_back(&rollout.contact_efforts[body_id][3]);
+              send_data_vec.emplace_back(&rollout.contact_efforts[body_id][4]);
+              send_data_vec.emplace_back(&rollout.contact_efforts[body_id][5]);
             }
-            else if (strcmp(attribute_name.c_str(), "relative_velocity") == 0 && body_state == BodyState::FREE)
+            else if (attribute == EAttribute::RelativeVelocity && body_state == BodyState::FREE)
             {
-              send_data_vec.emplace_back(&d_->qvel[dof_id]);
-              send_data_vec.emplace_back(&d_->qvel[dof_id + 1]);
-              send_data_vec.emplace_back(&d_->qvel[dof_id + 2]);
-              send_data_vec.emplace_back(&d_->qvel[dof_id + 3]);
-              send_data_vec.emplace_back(&d_->qvel[dof_id + 4]);
-              send_data_vec.emplace_back(&d_->qvel[dof_id + 5]);
+              send_data_vec.emplace_back(&d->qvel[dof_id]);
+              send_data_vec.emplace_back(&d->qvel[dof_id + 1]);
+              send_data_vec.emplace_back(&d->qvel[dof_id + 2]);
+              send_data_vec.emplace_back(&d->qvel[dof_id + 3]);
+              send_data_vec.emplace_back(&d->qvel[dof_id + 4]);
+              send_data_vec.emplace_back(&d->qvel[dof_id + 5]);
             }
-            else if (strcmp(attribute_name.c_str(), "odometric_velocity") == 0 && m_->body_dofnum[body_id] <= 6 && m_->body_jntadr[body_id] != -1)
+            else if (attribute == EAttribute::OdometricVelocity && m_->body_dofnum[body_id] <= 6 && m_->body_jntadr[body_id] != -1)
             {
-              odom_velocities[body_id] = (mjtNum *)calloc(6, sizeof(mjtNum));
-              send_data_vec.emplace_back(&odom_velocities[body_id][0]);
-              send_data_vec.emplace_back(&odom_velocities[body_id][1]);
-              send_data_vec.emplace_back(&odom_velocities[body_id][2]);
-              send_data_vec.emplace_back(&odom_velocities[body_id][3]);
-              send_data_vec.emplace_back(&odom_velocities[body_id][4]);
-              send_data_vec.emplace_back(&odom_velocities[body_id][5]);
+              rollout.odom_velocities[body_id] = (mjtNum *)calloc(6, sizeof(mjtNum));
+              send_data_vec.emplace_back(&rollout.odom_velocities[body_id][0]);
+              send_data_vec.emplace_back(&rollout.odom_velocities[body_id][1]);
+              send_data_vec.emplace_back(&rollout.odom_velocities[body_id][2]);
+              send_data_vec.emplace_back(&rollout.odom_velocities[body_id][3]);
+              send_data_vec.emplace_back(&rollout.odom_velocities[body_id][4]);
+              send_data_vec.emplace_back(&rollout.odom_velocities[body_id][5]);
             }
           }
         }
       }
       else if (joint_id != -1)
       {
-        const std::string joint_name = send_object.first;
-        const int qpos_id = m_->jnt_qposadr[joint_id];
-        const int dof_id = m_->jnt_dofadr[joint_id];
-        for (const std::string &attribute_name : send_object.second)
+        const std::string joint_name = send_object->name;
+        const int qpos_id = send_object->joint_qpos_adr;
+        const int dof_id = send_object->joint_dof_adr;
+        for (const std::pair<std::string, EAttribute> &send_attribute : send_object->send_attributes)
         {
-          const bool is_revolute_joint = m_->jnt_type[joint_id] == mjtJoint::mjJNT_HINGE;
-          const bool is_prismatic_joint = m_->jnt_type[joint_id] == mjtJoint::mjJNT_SLIDE;
-          const bool is_ball_joint = m_->jnt_type[joint_id] == mjtJoint::mjJNT_BALL;
-          if ((strcmp(attribute_name.c_str(), "joint_rvalue") == 0 && is_revolute_joint) ||
-              (strcmp(attribute_name.c_str(), "joint_tvalue") == 0 && is_prismatic_joint))
+          const std::string &attribute_name = send_attribute.first;
+          const EAttribute attribute = send_attribute.second;
+          const bool is_revolute_joint = send_object->joint_type == mjtJoint::mjJNT_HINGE;
+          const bool is_prismatic_joint = send_object->joint_type == mjtJoint::mjJNT_SLIDE;
+          const bool is_ball_joint = send_object->joint_type == mjtJoint::mjJNT_BALL;
+          if ((attribute == EAttribute::JointRvalue && is_revolute_joint) ||
+              (attribute == EAttribute::JointTvalue && is_prismatic_joint))
           {
-            send_data_vec.emplace_back(&d_->qpos[qpos_id]);
+            send_data_vec.emplace_back(&d->qpos[qpos_id]);
           }
-          else if ((strcmp(attribute_name.c_str(), "joint_angular_velocity") == 0 && is_revolute_joint) ||
-                   (strcmp(attribute_name.c_str(), "joint_linear_velocity") == 0 && is_prismatic_joint))
+          else if ((attribute == EAttribute::JointAngularVelocity && is_revolute_joint) ||
+                   (attribute == EAttribute::JointLinearVelocity && is_prismatic_joint))
           {
-            send_data_vec.emplace_back(&d_->qvel[dof_id]);
+            send_data_vec.emplace_back(&d->qvel[dof_id]);
           }
-          else if ((strcmp(attribute_name.c_str(), "joint_angular_acceleration") == 0 && is_revolute_joint) ||
-                   (strcmp(attribute_name.c_str(), "joint_linear_acceleration") == 0 && is_prismatic_joint))
+          else if ((attribute == EAttribute::JointAngularAcceleration && is_revolute_joint) ||
+                   (attribute == EAttribute::JointLinearAcceleration && is_prismatic_joint))
           {
-            send_data_vec.emplace_back(&d_->qacc[dof_id]);
+            send_data_vec.emplace_back(&d->qacc[dof_id]);
           }
-          else if ((strcmp(attribute_name.c_str(), "joint_torque") == 0 && is_revolute_joint) ||
-                   (strcmp(attribute_name.c_str(), "joint_force") == 0 && is_prismatic_joint))
+          else if ((attribute == EAttribute::JointTorque && is_revolute_joint) ||
+                   (attribute == EAttribute::JointForce && is_prismatic_joint))
           {
-            send_data_vec.emplace_back(&d_->qfrc_inverse[dof_id]);
+            send_data_vec.emplace_back(&d->qfrc_inverse[dof_id]);
           }
-          else if (strcmp(attribute_name.c_str(), "joint_position") == 0)
+          else if (attribute == EAttribute::JointPosition)
           {
             mju_warning("Send %s for %s not supported yet\n", attribute_name.c_str(), joint_name.c_str());
           }
-          else if (strcmp(attribute_name.c_str(), "joint_quaternion") == 0 && is_prismatic_joint && is_ball_joint)
+          else if (attribute == EAttribute::JointQuaternion && is_prismatic_joint && is_ball_joint)
           {
-            send_data_vec.emplace_back(&d_->qpos[qpos_id]);
-            send_data_vec.emplace_back(&d_->qpos[qpos_id + 1]);
-            send_data_vec.emplace_back(&d_->qpos[qpos_id + 2]);
-            send_data_vec.emplace_back(&d_->qpos[qpos_id + 3]);
+            send_data_vec.emplace_back(&d->qpos[qpos_id]);
+            send_data_vec.emplace_back(&d->qpos[qpos_id + 1]);
+            send_data_vec.emplace_back(&d->qpos[qpos_id + 2]);
+            send_data_vec.emplace_back(&d->qpos[qpos_id + 3]);
           }
           else
           {
@@ -1081,141 +1780,167 @@ namespace mujoco::plugin::multiverse_connector
           }
         }
       }
+      else if (send_object->is_sensor_object)
+      {
+        for (const std::pair<std::string, EAttribute> &send_attribute : send_object->send_attributes)
+        {
+          if (send_attribute.second != EAttribute::Sensors)
+          {
+            continue;
+          }
+          // Sensors that are next to each other in sensordata end up in one data run
+          for (const int sensor_id : config_.sensor_ids)
+          {
+            for (int i = 0; i < m_->sensor_dim[sensor_id]; i++)
+            {
+              send_data_vec.emplace_back(&d->sensordata[m_->sensor_adr[sensor_id] + i]);
+            }
+          }
+        }
+      }
+      send_data_rollouts.resize(send_data_vec.size(), send_object->rollout);
     }
 
-    for (const std::pair<const std::string, std::set<std::string>> &receive_object : config_.receive_objects)
+    for (const MujocoObject *receive_object : receive_table)
     {
-      const int body_id = mj_name2id(m_, mjtObj::mjOBJ_BODY, receive_object.first.c_str());
-      const int mocap_id = m_->body_mocapid[body_id];
-      const int joint_id = mj_name2id(m_, mjtObj::mjOBJ_JOINT, receive_object.first.c_str());
-      const int actuator_id = mj_name2id(m_, mjtObj::mjOBJ_ACTUATOR, receive_object.first.c_str());
+      Rollout &rollout = rollouts[receive_object->rollout];
+      mjData *d = rollout.d;
+      const int body_id = receive_object->body_id;
+      const int mocap_id = receive_object->mocap_id;
+      const int joint_id = receive_object->joint_id;
+      const int actuator_id = receive_object->actuator_id;
       if (body_id != -1)
       {
-        const std::string body_name = receive_object.first;
-        const BodyState body_state = get_body_state(m_, body_id);
+        const std::string body_name = receive_object->name;
+        const BodyState body_state = receive_object->body_state;
         if (body_state == BodyState::STATIC)
         {
-          for (const std::string &attribute_name : receive_object.second)
+          for (const std::pair<std::string, EAttribute> &receive_attribute : receive_object->receive_attributes)
           {
-            if (strcmp(attribute_name.c_str(), "position") == 0)
+            const EAttribute attribute = receive_attribute.second;
+            if (attribute == EAttribute::Position)
             {
-              receive_data_vec.emplace_back(&d_->mocap_pos[3 * mocap_id]);
-              receive_data_vec.emplace_back(&d_->mocap_pos[3 * mocap_id + 1]);
-              receive_data_vec.emplace_back(&d_->mocap_pos[3 * mocap_id + 2]);
+              receive_data_vec.emplace_back(&d->mocap_pos[3 * mocap_id]);
+              receive_data_vec.emplace_back(&d->mocap_pos[3 * mocap_id + 1]);
+              receive_data_vec.emplace_back(&d->mocap_pos[3 * mocap_id + 2]);
             }
-            else if (strcmp(attribute_name.c_str(), "quaternion") == 0)
+            else if (attribute == EAttribute::Quaternion)
             {
-              receive_data_vec.emplace_back(&d_->mocap_quat[4 * mocap_id]);
-              receive_data_vec.emplace_back(&d_->mocap_quat[4 * mocap_id + 1]);
-              receive_data_vec.emplace_back(&d_->mocap_quat[4 * mocap_id + 2]);
-              receive_data_vec.emplace_back(&d_->mocap_quat[4 * mocap_id + 3]);
+              receive_data_vec.emplace_back(&d->mocap_quat[4 * mocap_id]);
+              receive_data_vec.emplace_back(&d->mocap_quat[4 * mocap_id + 1]);
+              receive_data_vec.emplace_back(&d->mocap_quat[4 * mocap_id + 2]);
+              receive_data_vec.emplace_back(&d->mocap_quat[4 * mocap_id + 3]);
             }
           }
         }
         else
         {
-          const int dof_id = m_->body_dofadr[body_id];
-          for (const std::string &attribute_name : receive_object.second)
+          const int dof_id = receive_object->body_dof_adr;
+          for (const std::pair<std::string, EAttribute> &receive_attribute : receive_object->receive_attributes)
           {
-            if (strcmp(attribute_name.c_str(), "position") == 0 && body_state == BodyState::FREE)
+            const EAttribute attribute = receive_attribute.second;
+            if (attribute == EAttribute::Position && body_state == BodyState::FREE)
             {
-              int qpos_id = m_->jnt_qposadr[m_->body_jntadr[body_id]];
-              receive_data_vec.emplace_back(&d_->qpos[qpos_id]);
-              receive_data_vec.emplace_back(&d_->qpos[qpos_id + 1]);
-              receive_data_vec.emplace_back(&d_->qpos[qpos_id + 2]);
+              int qpos_id = receive_object->body_qpos_adr;
+              receive_data_vec.emplace_back(&d->qpos[qpos_id]);
+              receive_data_vec.emplace_back(&d->qpos[qpos_id + 1]);
+              receive_data_vec.emplace_back(&d->qpos[qpos_id + 2]);
             }
-            else if (strcmp(attribute_name.c_str(), "quaternion") == 0)
+            else if (attribute == EAttribute::Quaternion)
             {
               if (body_state == BodyState::FREE)
               {
-                int qpos_id = m_->jnt_qposadr[m_->body_jntadr[body_id]];
-                receive_data_vec.emplace_back(&d_->qpos[qpos_id + 3]);
-                receive_data_vec.emplace_back(&d_->qpos[qpos_id + 4]);
-                receive_data_vec.emplace_back(&d_->qpos[qpos_id + 5]);
-                receive_data_vec.emplace_back(&d_->qpos[qpos_id + 6]);
+                int qpos_id = receive_object->body_qpos_adr;
+                receive_data_vec.emplace_back(&d->qpos[qpos_id + 3]);
+                receive_data_vec.emplace_back(&d->qpos[qpos_id + 4]);
+                receive_data_vec.emplace_back(&d->qpos[qpos_id + 5]);
+                receive_data_vec.emplace_back(&d->qpos[qpos_id + 6]);
               }
               else if (m_->body_dofnum[body_id] == 3 && body_state == BodyState::HANGING)
               {
-                int qpos_id = m_->jnt_qposadr[m_->body_jntadr[body_id]];
-                receive_data_vec.emplace_back(&d_->qpos[qpos_id]);
-                receive_data_vec.emplace_back(&d_->qpos[qpos_id + 1]);
-                receive_data_vec.emplace_back(&d_->qpos[qpos_id + 2]);
-                receive_data_vec.emplace_back(&d_->qpos[qpos_id + 3]);
+                int qpos_id = receive_object->body_qpos_adr;
+                receive_data_vec.emplace_back(&d->qpos[qpos_id]);
+                receive_data_vec.emplace_back(&d->qpos[qpos_id + 1]);
+                receive_data_vec.emplace_back(&d->qpos[qpos_id + 2]);
+                receive_data_vec.emplace_back(&d->qpos[qpos_id + 3]);
               }
             }
-            else if (strcmp(attribute_name.c_str(), "force") == 0)
+            else if (attribute == EAttribute::Force)
             {
-              receive_data_vec.emplace_back(&d_->xfrc_applied[6 * body_id]);
-              receive_data_vec.emplace_back(&d_->xfrc_applied[6 * body_id + 1]);
-              receive_data_vec.emplace_back(&d_->xfrc_applied[6 * body_id + 2]);
+              receive_data_vec.emplace_back(&d->xfrc_applied[6 * body_id]);
+              receive_data_vec.emplace_back(&d->xfrc_applied[6 * body_id + 1]);
+              receive_data_vec.emplace_back(&d->xfrc_applied[6 * body_id + 2]);
             }
-            else if (strcmp(attribute_name.c_str(), "torque") == 0)
+            else if (attribute == EAttribute::Torque)
             {
-              receive_data_vec.emplace_back(&d_->xfrc_applied[6 * body_id + 3]);
-              receive_data_vec.emplace_back(&d_->xfrc_applied[6 * body_id + 4]);
-              receive_data_vec.emplace_back(&d_->xfrc_applied[6 * body_id + 5]);
+              receive_data_vec.emplace_back(&d->xfrc_applied[6 * body_id + 3]);
+              receive_data_vec.emplace_back(&d->xfrc_applied[6 * body_id + 4]);
+              receive_data_vec.emplace_back(&d->xfrc_applied[6 * body_id + 5]);
             }
-            else if (strcmp(attribute_name.c_str(), "relative_velocity") == 0 && body_state == BodyState::FREE && odom_velocities.count(body_id) == 0)
+            else if (attribute == EAttribute::RelativeVelocity && body_state == BodyState::FREE && rollout.odom_velocities.count(body_id) == 0)
             {
-              receive_data_vec.emplace_back(&d_->qvel[dof_id]);
-              receive_data_vec.emplace_back(&d_->qvel[dof_id + 1]);
-              receive_data_vec.emplace_back(&d_->qvel[dof_id + 2]);
-              receive_data_vec.emplace_back(&d_->qvel[dof_id + 3]);
-              receive_data_vec.emplace_back(&d_->qvel[dof_id + 4]);
-              receive_data_vec.emplace_back(&d_->qvel[dof_id + 5]);
+              receive_data_vec.emplace_back(&d->qvel[dof_id]);
+              receive_data_vec.emplace_back(&d->qvel[dof_id + 1]);
+              receive_data_vec.emplace_back(&d->qvel[dof_id + 2]);
+              receive_data_vec.emplace_back(&d->qvel[dof_id + 3]);
+              receive_data_vec.emplace_back(&d->qvel[dof_id + 4]);
+              receive_data_vec.emplace_back(&d->qvel[dof_id + 5]);
             }
-            else if (strcmp(attribute_name.c_str(), "odometric_velocity") == 0 && m_->body_dofnum[body_id] <= 6 && m_->body_jntadr[body_id] != -1 && odom_velocities.count(body_id) == 0)
+            else if (attribute == EAttribute::OdometricVelocity && m_->body_dofnum[body_id] <= 6 && m_->body_jntadr[body_id] != -1 && rollout.odom_velocities.count(body_id) == 0)
             {
-              odom_velocities[body_id] = (mjtNum *)calloc(6, sizeof(mjtNum));
-              receive_data_vec.emplace_back(&odom_velocities[body_id][0]);
-              receive_data_vec.emplace_back(&odom_velocities[body_id][1]);
-              receive_data_vec.emplace_back(&odom_velocities[body_id][2]);
-              receive_data_vec.emplace_back(&odom_velocities[body_id][3]);
-              receive_data_vec.emplace_back(&odom_velocities[body_id][4]);
-              receive_data_vec.emplace_back(&odom_velocities[body_id][5]);
+              rollout.odom_velocities[body_id] = (mjtNum *)calloc(6, sizeof(mjtNum));
+              receive_data_vec.emplace_back(&rollout.odom_velocities[body_id][0]);
+              receive_data_vec.emplace_back(&rollout.odom_velocities[body_id][1]);
+              receive_data_vec.emplace_back(&rollout.odom_velocities[body_id][2]);
+              receive_data_vec.emplace_back(&rollout.odom_velocities[body_id][3]);
+              receive_data_vec.emplace_back(&rollout.odom_velocities[body_id][4]);
+              receive_data_vec.emplace_back(&rollout.odom_velocities[body_id][5]);
             }
           }
         }
       }
       else if (joint_id != -1)
       {
-        const std::string joint_name = receive_object.first;
-        const int qpos_id = m_->jnt_qposadr[joint_id];
-        const int dof_id = m_->jnt_dofadr[joint_id];
-        const bool is_revolute_joint = m_->jnt_type[joint_id] == mjtJoint::mjJNT_HINGE;
-        const bool is_prismatic_joint = m_->jnt_type[joint_id] == mjtJoint::mjJNT_SLIDE;
-        for (const std::string &attribute_name : receive_object.second)
+        const std::string joint_name = receive_object->name;
+        const int qpos_id = receive_object->joint_qpos_adr;
+        const int dof_id = receive_object->joint_dof_adr;
+        const bool is_revolute_joint = receive_object->joint_type == mjtJoint::mjJNT_HINGE;
+        const bool is_prismatic_joint = receive_object->joint_type == mjtJoint::mjJNT_SLIDE;
+        for (const std::pair<std::string, EAttribute> &receive_attribute : receive_object->receive_attributes)
         {
-          if ((strcmp(attribute_name.c_str(), "joint_rvalue") == 0 && is_revolute_joint) ||
-              (strcmp(attribute_name.c_str(), "joint_tvalue") == 0 && is_prismatic_joint))
+          const EAttribute attribute = receive_attribute.second;
+          if ((attribute == EAttribute::JointRvalue && is_revolute_joint) ||
+              (attribute == EAttribute::JointTvalue && is_prismatic_joint))
           {
-            receive_data_vec.emplace_back(&d_->qpos[qpos_id]);
+            receive_data_vec.emplace_back(&d->qpos[qpos_id]);
           }
-          else if ((strcmp(attribute_name.c_str(), "joint_angular_velocity") == 0 && is_revolute_joint) ||
-                   (strcmp(attribute_name.c_str(), "joint_linear_velocity") == 0 && is_prismatic_joint))
+          else if ((attribute == EAttribute::JointAngularVelocity && is_revolute_joint) ||
+                   (attribute == EAttribute::JointLinearVelocity && is_prismatic_joint))
           {
-            receive_data_vec.emplace_back(&d_->qvel[dof_id]);
+            receive_data_vec.emplace_back(&d->qvel[dof_id]);
           }
-          else if ((strcmp(attribute_name.c_str(), "joint_torque") == 0 && is_revolute_joint) ||
-                   (strcmp(attribute_name.c_str(), "joint_force") == 0 && is_prismatic_joint))
+          else if ((attribute == EAttribute::JointTorque && is_revolute_joint) ||
+                   (attribute == EAttribute::JointForce && is_prismatic_joint))
           {
-            receive_data_vec.emplace_back(&d_->qfrc_applied[dof_id]);
+            receive_data_vec.emplace_back(&d->qfrc_applied[dof_id]);
           }
         }
       }
       else if (actuator_id != -1)
       {
-        const std::string actuator_name = receive_object.first;
-        for (const std::string &attribute_name : receive_object.second)
+        const std::string actuator_name = receive_object->name;
+        for (const std::pair<std::string, EAttribute> &receive_attribute : receive_object->receive_attributes)
         {
-          if (strcmp(attribute_name.c_str(), "cmd_joint_rvalue") == 0 ||
-              strcmp(attribute_name.c_str(), "cmd_joint_tvalue") == 0 ||
-              strcmp(attribute_name.c_str(), "cmd_joint_angular_velocity") == 0 ||
-              strcmp(attribute_name.c_str(), "cmd_joint_linear_velocity") == 0 ||
-              strcmp(attribute_name.c_str(), "cmd_joint_torque") == 0 ||
-              strcmp(attribute_name.c_str(), "cmd_joint_force") == 0)
+          const std::string &attribute_name = receive_attribute.first;
+          const EAttribute attribute = receive_attribute.second;
+          if (attribute == EAttribute::CmdJointRvalue ||
+              attribute == EAttribute::CmdJointTvalue ||
+              attribute == EAttribute::CmdJointAngularVelocity ||
+              attribute == EAttribute::CmdJointLinearVelocity ||
+              attribute == EAttribute::CmdJointTorque ||
+              attribute == EAttribute::CmdJointForce)
           {
-            receive_data_vec.emplace_back(&d_->ctrl[actuator_id]);
+            receive_data_vec.emplace_back(&d->ctrl[actuator_id]);
           }
           else
           {
@@ -1223,40 +1948,89 @@ namespace mujoco::plugin::multiverse_connector
           }
         }
       }
+      receive_data_rollouts.resize(receive_data_vec.size(), receive_object->rollout);
     }
+
+    for (Rollout &rollout : rollouts)
+    {
+      for (const std::pair<const int, mjtNum *> &contact_effort : rollout.contact_efforts)
+      {
+        rollout.contact_dof_chains[contact_effort.first] = get_dof_chain(m_, contact_effort.first);
+      }
+
+      rollout.odom_bodies = get_odom_bodies(rollout.odom_velocities, m_);
+    }
+
+    send_data_runs = get_data_runs(send_data_vec, send_data_rollouts);
+    receive_data_runs = get_data_runs(receive_data_vec, receive_data_rollouts);
+    data_vec_mtx.unlock();
   }
 
   void MultiverseConnector::bind_send_data()
   {
-    *world_time = d_->time;
+    if (config_.is_async)
+    {
+      const std::vector<mjtNum> &state = state_buffer.read_buffer();
+      *world_time = state.empty() ? 0.0 : state[0];
+      if (state.size() != send_buffer.buffer_double.size + 1)
+      {
+        mju_warning("Mismatch between the published state [%zd] and send_buffer.buffer_double.size [%zd]\n", state.size() - 1, send_buffer.buffer_double.size);
+        return;
+      }
+
+      std::copy(state.begin() + 1, state.end(), send_buffer.buffer_double.data);
+      return;
+    }
+
+    // The time of the first exchanged rollout, the others may be stepping
+    std::vector<Rollout>::const_iterator time_rollout_it = std::find_if(rollouts.begin(), rollouts.end(), [](const Rollout &rollout)
+                                                                        { return rollout.is_exchanged; });
+    *world_time = time_rollout_it != rollouts.end() ? time_rollout_it->d->time : d_->time;
     if (send_data_vec.size() != send_buffer.buffer_double.size)
     {
       mju_warning("Mismatch between send_data_vec [%zd] and send_buffer.buffer_double.size [%zd]\n", send_data_vec.size(), send_buffer.buffer_double.size);
       return;
     }
 
-    calculate_contact_efforts(contact_efforts, m_, d_);
-
-    for (size_t i = 0; i < send_buffer.buffer_double.size; i++)
+    for (Rollout &rollout : rollouts)
     {
-      send_buffer.buffer_double.data[i] = *send_data_vec[i];
+      if (rollout.is_exchanged)
+      {
+        calculate_contact_efforts(rollout.contact_efforts, rollout.contact_dof_chains, m_, rollout.d);
+      }
     }
+
+    gather_data_runs(send_data_runs, rollouts, send_buffer.buffer_double.data);
   }
 
   void MultiverseConnector::bind_receive_data()
   {
+    if (config_.is_async)
+    {
+      // Compute applies the controls together with the time of the state they respond to
+      std::vector<mjtNum> &control = control_buffer.write_buffer();
+      control.resize(receive_buffer.buffer_double.size + 1);
+      control[0] = state_buffer.read_buffer().empty() ? 0.0 : state_buffer.read_buffer()[0];
+      std::copy(receive_buffer.buffer_double.data, receive_buffer.buffer_double.data + receive_buffer.buffer_double.size, control.begin() + 1);
+      control_buffer.publish();
+      return;
+    }
+
     if (receive_data_vec.size() != receive_buffer.buffer_double.size)
     {
       mju_warning("Mismatch between receive_data_vec [%zd] and receive_buffer.buffer_double.size [%zd]\n", receive_data_vec.size(), receive_buffer.buffer_double.size);
       return;
     }
 
-    calculate_odom_velocities(odom_velocities, m_, d_);
-
-    for (size_t i = 0; i < receive_buffer.buffer_double.size; i++)
+    for (Rollout &rollout : rollouts)
     {
-      *receive_data_vec[i] = receive_buffer.buffer_double.data[i];
+      if (rollout.is_exchanged)
+      {
+        calculate_odom_velocities(rollout.odom_bodies, rollout.odom_angles, rollout.d);
+      }
     }
+
+    scatter_data_runs(receive_data_runs, rollouts, receive_buffer.buffer_double.data);
   }
 
 } // namespace mujoco::plugin::multiverse_connector
@@ -23,7 +23,11 @@
 
 #include "multiverse_client_json.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <set>
+#include <thread>
 
 #include <mujoco/mjdata.h>
 #include <mujoco/mjmodel.h>
@@ -40,6 +44,147 @@ namespace mujoco::plugin::multiverse_connector
     std::string simulation_name = "mujoco_simulation";
     std::map<std::string, std::set<std::string>> send_objects = {};
     std::map<std::string, std::set<std::string>> receive_objects = {};
+    bool is_async = false;
+    mjtNum max_staleness = 0.01;
+    std::vector<int> sensor_ids = {}; // Sent as the "sensors" tensor of the object simulation_name
+    int rollouts = 1; // Number of mjData of the model that share one session
+    mjtNum rollout_timeout = 0.1; // Seconds a rollout waits for the others before it exchanges the data of the group alone
+  };
+
+  enum class BodyState : uint8_t
+  {
+    UNKNOWN = 0,
+    STATIC = 1,
+    FREE = 2,
+    HANGING = 3,
+  };
+
+  enum class EAttribute : uint8_t
+  {
+    Unknown,
+    Position,
+    Quaternion,
+    RelativeVelocity,
+    OdometricVelocity,
+    Force,
+    Torque,
+    JointRvalue,
+    JointTvalue,
+    JointAngularVelocity,
+    JointLinearVelocity,
+    JointAngularAcceleration,
+    JointLinearAcceleration,
+    JointTorque,
+    JointForce,
+    JointPosition,
+    JointQuaternion,
+    CmdJointRvalue,
+    CmdJointTvalue,
+    CmdJointAngularVelocity,
+    CmdJointLinearVelocity,
+    CmdJointTorque,
+    CmdJointForce,
+    Sensors,
+  };
+
+  // The ids and addresses of a named object, resolved once so that the binding passes do not look up names.
+  // A name can be a body, a joint and an actuator at the same time, -1 marks what it is not.
+  struct MujocoObject
+  {
+    std::string name;
+    int body_id = -1;
+    int mocap_id = -1;
+    BodyState body_state = BodyState::UNKNOWN;
+    int body_qpos_adr = -1; // qpos address of the first joint of the body
+    int body_dof_adr = -1;
+    int joint_id = -1;
+    int joint_type = -1;
+    int joint_qpos_adr = -1;
+    int joint_dof_adr = -1;
+    int actuator_id = -1;
+    bool is_sensor_object = false;
+    int rollout = 0; // Index of the mjData the object belongs to, the names of rollout k > 0 end with _rollout_k
+    std::vector<std::pair<std::string, EAttribute>> send_attributes;
+    std::vector<std::pair<std::string, EAttribute>> receive_attributes;
+  };
+
+  // Consecutive values of a data buffer that map to consecutive mjtNum of mjData, copied with one mju_copy.
+  struct DataRun
+  {
+    mjtNum *data = nullptr;
+    size_t offset = 0;
+    size_t size = 0;
+    int rollout = 0; // Index of the mjData of the values, a run never spans two rollouts
+  };
+
+  // A body that converts odometric_velocity into qvel, with the axes of its joints classified once at bind time.
+  struct OdomBody
+  {
+    mjtNum *velocity = nullptr;
+    int free_qpos_adr = -1; // -1 if the body moves on hinge and slide joints instead of a free joint
+    int free_dof_adr = -1;
+    int hinge_qpos_adrs[3] = {-1, -1, -1}; // Indexed by the axis x, y or z of the joint, the last hinge of an axis gives its angle
+    std::vector<int> hinge_dof_adrs[3]; // Every hinge and slide of an axis gets the velocity of the axis
+    std::vector<int> slide_dof_adrs[3];
+  };
+
+  // The state of one mjData of a rollout group, the binding tables are shared by the whole group.
+  struct Rollout
+  {
+    mjData *d = nullptr;
+
+    std::map<int, mjtNum *> contact_efforts;
+
+    // The dofs that move each body of contact_efforts, from the last dof of the body up to the root.
+    std::map<int, std::vector<int>> contact_dof_chains;
+
+    std::map<int, mjtNum *> odom_velocities;
+
+    std::vector<OdomBody> odom_bodies;
+
+    // The Euler angles of odom_bodies followed by their sines and cosines, reused on every step.
+    std::vector<mjtNum> odom_angles;
+
+    // Whether the rollout waits in Compute for the exchange of the current round.
+    bool is_arrived = false;
+
+    // Whether the mjData takes part in the running exchange, the values of the others are neither read nor written.
+    bool is_exchanged = true;
+
+    // The round of the next exchange of the rollout, behind rollout_round if it missed the last one.
+    size_t round = 0;
+
+    // Set if a reset arrived while the rollout was not exchanged, applied when it reaches Compute.
+    bool is_reset_requested = false;
+  };
+
+  // Hands the latest values from one writer thread to one reader thread, neither of them blocks.
+  struct TripleBuffer
+  {
+    std::vector<mjtNum> buffers[3];
+    int write_index = 0;
+    int read_index = 1;
+    std::atomic<int> middle_index{2}; // The bit 4 marks that the middle buffer has new values
+
+    std::vector<mjtNum> &write_buffer() { return buffers[write_index]; }
+
+    const std::vector<mjtNum> &read_buffer() const { return buffers[read_index]; }
+
+    bool has_update() const { return (middle_index.load() & 4) != 0; }
+
+    // Swaps the write buffer with the middle buffer and marks it as new.
+    void publish() { write_index = middle_index.exchange(write_index | 4) & 3; }
+
+    // Swaps the middle buffer with the read buffer if it is new, returns whether it was.
+    bool update()
+    {
+      if (!has_update())
+      {
+        return false;
+      }
+      read_index = middle_index.exchange(read_index) & 3;
+      return true;
+    }
   };
 
   // An multiverse_connector plugin which implements configurable MULTIVERSE_CONNECTOR control.
@@ -68,9 +213,16 @@ namespace mujoco::plugin::multiverse_connector
     // Adds the MULTIVERSE_CONNECTOR plugin to the global registry of MuJoCo plugins.
     static void RegisterPlugin();
 
+    // Removes the mjData from the instance, returns whether the instance has no mjData left and can be deleted.
+    bool RemoveRollout(mjData *d);
+
   private:
     MultiverseConnector(MultiverseConfig config, const mjModel *m, mjData *d);
 
+  public:
+    ~MultiverseConnector() override;
+
+  private:
     MultiverseConfig config_;
 
   private:
@@ -78,13 +230,98 @@ namespace mujoco::plugin::multiverse_connector
 
     mjData *d_ = nullptr;
 
+    // One entry per mjData, d_ is the data of the first rollout.
+    std::vector<Rollout> rollouts;
+
     std::vector<mjtNum*> send_data_vec;
 
     std::vector<mjtNum*> receive_data_vec;
 
-    std::map<int, mjtNum *> contact_efforts;
+    // The rollout of every entry of send_data_vec and receive_data_vec.
+    std::vector<int> send_data_rollouts;
 
-    std::map<int, mjtNum *> odom_velocities;
+    std::vector<int> receive_data_rollouts;
+
+    // send_data_vec and receive_data_vec grouped into runs of contiguous addresses.
+    std::vector<DataRun> send_data_runs;
+
+    std::vector<DataRun> receive_data_runs;
+
+  private:
+    // Adds an mjData to the rollout group, returns whether the group is complete.
+    bool add_rollout(mjData *d);
+
+    // Connects the complete rollout group to the server.
+    void connect_rollouts();
+
+    // Waits until every rollout of the group reached Compute, the last one exchanges the data of all of them.
+    // A rollout that waits longer than rollout_timeout exchanges only the rollouts that arrived so far, the others
+    // may still be stepping. A rollout that missed an exchange exchanges its own values once it arrives.
+    void step_rollouts(mjData *d);
+
+    std::mutex rollout_mtx;
+
+    std::condition_variable rollout_cv;
+
+    int rollout_arrivals = 0;
+
+    size_t rollout_round = 0;
+
+    // True while all rollouts of the group exist and the session is connected.
+    bool is_rollout_group_ready = false;
+
+  private:
+    // Returns the table entry of the object, the ids are looked up only the first time the name is seen.
+    MujocoObject &resolve_object(const std::string &object_name);
+
+    // Compiles the attributes of config_ into object_table, called whenever config_ changes.
+    void compile_object_table();
+
+    std::map<std::string, MujocoObject> object_table;
+
+    // The objects of config_.send_objects and config_.receive_objects that exist in the model, in config order.
+    std::vector<const MujocoObject *> send_table;
+
+    std::vector<const MujocoObject *> receive_table;
+
+  private:
+    // In async mode, the communication thread exchanges the buffers with the server while MuJoCo steps.
+    void run_communication();
+
+    // Applies the latest controls from the communication thread, returns whether there were new ones.
+    bool apply_controls(const mjModel *m, mjData *d);
+
+    std::thread communication_thread;
+
+    std::atomic<bool> is_communicating{false};
+
+    std::atomic<bool> is_reset_requested{false};
+
+    TripleBuffer state_buffer;
+
+    TripleBuffer control_buffer;
+
+    // The simulation time of the state that the applied controls respond to.
+    mjtNum control_time = 0.0;
+
+    std::mutex state_mtx;
+
+    std::condition_variable state_cv;
+
+    std::mutex control_mtx;
+
+    std::condition_variable control_cv;
+
+    // Guards send_data_vec, receive_data_vec and the objects they point to while the meta data is rebound.
+    std::mutex data_vec_mtx;
+
+    // Writes the initial values of the response meta data into mjData, called with data_vec_mtx held.
+    void apply_response_meta_data(const Json::Value &response_meta_data);
+
+    // The response meta data received by the communication thread, applied in the next Compute.
+    Json::Value pending_response_meta_data_json;
+
+    std::atomic<bool> is_response_meta_data_pending{false};
 
   private:
     void start_connect_to_server_thread() override;
@@ -99,6 +336,8 @@ namespace mujoco::plugin::multiverse_connector
 
     void bind_request_meta_data() override;
 
+    std::string get_world_name() const override;
+
     void bind_api_callbacks() override;
 
     void bind_api_callbacks_response() override;
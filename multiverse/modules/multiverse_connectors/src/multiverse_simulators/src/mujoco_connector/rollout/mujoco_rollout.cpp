@@ -0,0 +1,384 @@
+// Copyright (c) 2023, Giang Hoang Nguyen - Institute for Artificial Intelligence, University Bremen
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <mujoco/mujoco.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+
+class MujocoRollout
+{
+public:
+    /**
+     * @brief Create number_of_envs mjData instances of a copy of the model and
+     * the worker threads that step them
+     *
+     * @param model_address The address of the mjModel, MjModel._address in Python
+     * @param number_of_envs The number of environments
+     * @param number_of_threads The number of threads that step the environments,
+     * the calling thread included, 0 for one per CPU core
+     */
+    MujocoRollout(const uintptr_t model_address, const int number_of_envs, const int number_of_threads = 0)
+    {
+        if (model_address == 0)
+        {
+            throw std::invalid_argument("The model address is null");
+        }
+        if (number_of_envs < 1)
+        {
+            throw std::invalid_argument("The number of environments must be at least 1, got " + std::to_string(number_of_envs));
+        }
+        if (number_of_threads < 0)
+        {
+            throw std::invalid_argument("The number of threads must not be negative, got " + std::to_string(number_of_threads));
+        }
+
+        const mjModel *src_m = reinterpret_cast<const mjModel *>(model_address);
+        if (src_m->nplugin > 0)
+        {
+            throw std::invalid_argument("Models with plugins can not be rolled out, the plugins are registered in a different MuJoCo library");
+        }
+
+        m = mj_copyModel(nullptr, src_m);
+        if (m == nullptr)
+        {
+            throw std::runtime_error("Failed to copy the model");
+        }
+
+        d_vec.reserve(number_of_envs);
+        for (int env_id = 0; env_id < number_of_envs; env_id++)
+        {
+            mjData *d = mj_makeData(m);
+            if (d == nullptr)
+            {
+                clean_up();
+                throw std::runtime_error("Failed to make the data of environment " + std::to_string(env_id));
+            }
+            d_vec.push_back(d);
+        }
+
+        // The batches are laid out env by env, each row is the state of one environment
+        qpos.resize(number_of_envs * m->nq);
+        qvel.resize(number_of_envs * m->nv);
+        act.resize(number_of_envs * m->na);
+        ctrl.resize(number_of_envs * m->nu);
+        qfrc_applied.resize(number_of_envs * m->nv);
+        time.resize(number_of_envs);
+        xpos.resize(number_of_envs * m->nbody * 3);
+        xquat.resize(number_of_envs * m->nbody * 4);
+        energy.resize(number_of_envs * 2);
+        for (int env_id = 0; env_id < number_of_envs; env_id++)
+        {
+            gather(env_id, true);
+        }
+
+        // The calling thread steps environments as well, so it needs one worker less
+        int number_of_workers = number_of_threads > 0 ? number_of_threads : (int)std::thread::hardware_concurrency();
+        number_of_workers = std::min(std::max(number_of_workers, 1), number_of_envs) - 1;
+        workers.reserve(number_of_workers);
+        for (int worker_id = 0; worker_id < number_of_workers; worker_id++)
+        {
+            workers.emplace_back(&MujocoRollout::run_worker, this);
+        }
+    }
+
+    ~MujocoRollout()
+    {
+        pool_mtx.lock();
+        should_shut_down = true;
+        pool_mtx.unlock();
+        start_cv.notify_all();
+        for (std::thread &worker : workers)
+        {
+            worker.join();
+        }
+
+        clean_up();
+    }
+
+public:
+    /**
+     * @brief Scatter the batches into the environments, step every environment
+     * number_of_steps times in parallel and gather the batches back
+     *
+     * @param number_of_steps The number of steps, 0 only recomputes the derived
+     * quantities (xpos, xquat, energy) with mj_forward
+     */
+    void step(const int number_of_steps = 1)
+    {
+        if (number_of_steps < 0)
+        {
+            throw std::invalid_argument("The number of steps must not be negative, got " + std::to_string(number_of_steps));
+        }
+
+        std::unique_lock<std::mutex> lock(pool_mtx);
+        steps_per_round = number_of_steps;
+        next_env_id.store(0);
+        busy_workers = workers.size();
+        pool_round++;
+        lock.unlock();
+        start_cv.notify_all();
+
+        run_envs();
+
+        lock.lock();
+        done_cv.wait(lock, [this]
+                     { return busy_workers == 0; });
+    }
+
+    inline int get_number_of_envs() const
+    {
+        return d_vec.size();
+    }
+
+    inline int get_number_of_threads() const
+    {
+        return workers.size() + 1;
+    }
+
+    inline pybind11::array_t<mjtNum> get_qpos()
+    {
+        return get_batch_array(qpos, {get_number_of_envs(), m->nq});
+    }
+
+    inline pybind11::array_t<mjtNum> get_qvel()
+    {
+        return get_batch_array(qvel, {get_number_of_envs(), m->nv});
+    }
+
+    inline pybind11::array_t<mjtNum> get_act()
+    {
+        return get_batch_array(act, {get_number_of_envs(), m->na});
+    }
+
+    inline pybind11::array_t<mjtNum> get_ctrl()
+    {
+        return get_batch_array(ctrl, {get_number_of_envs(), m->nu});
+    }
+
+    inline pybind11::array_t<mjtNum> get_qfrc_applied()
+    {
+        return get_batch_array(qfrc_applied, {get_number_of_envs(), m->nv});
+    }
+
+    inline pybind11::array_t<mjtNum> get_time()
+    {
+        return get_batch_array(time, {get_number_of_envs()});
+    }
+
+    inline pybind11::array_t<mjtNum> get_xpos()
+    {
+        return get_batch_array(xpos, {get_number_of_envs(), m->nbody, 3});
+    }
+
+    inline pybind11::array_t<mjtNum> get_xquat()
+    {
+        return get_batch_array(xquat, {get_number_of_envs(), m->nbody, 4});
+    }
+
+    inline pybind11::array_t<mjtNum> get_energy()
+    {
+        return get_batch_array(energy, {get_number_of_envs(), 2});
+    }
+
+private:
+    /**
+     * @brief Wrap a batch in an array without copying, the array keeps the
+     * rollout alive
+     *
+     */
+    inline pybind11::array_t<mjtNum> get_batch_array(std::vector<mjtNum> &batch, const std::vector<pybind11::ssize_t> &shape)
+    {
+        return pybind11::array_t<mjtNum>(shape, batch.data(), pybind11::cast(this, pybind11::return_value_policy::reference));
+    }
+
+    void run_worker()
+    {
+        size_t seen_round = 0;
+        while (true)
+        {
+            std::unique_lock<std::mutex> lock(pool_mtx);
+            start_cv.wait(lock, [this, seen_round]
+                          { return should_shut_down || pool_round != seen_round; });
+            if (should_shut_down)
+            {
+                return;
+            }
+            seen_round = pool_round;
+            lock.unlock();
+
+            run_envs();
+
+            lock.lock();
+            if (--busy_workers == 0)
+            {
+                done_cv.notify_one();
+            }
+        }
+    }
+
+    /**
+     * @brief Claim environments one at a time until all of them are stepped,
+     * threads that finish early keep taking the remaining environments
+     *
+     */
+    void run_envs()
+    {
+        const int number_of_envs = get_number_of_envs();
+        for (int env_id = next_env_id.fetch_add(1); env_id < number_of_envs; env_id = next_env_id.fetch_add(1))
+        {
+            scatter(env_id);
+            mjData *d = d_vec[env_id];
+            if (steps_per_round == 0)
+            {
+                mj_forward(m, d);
+            }
+            for (int step_id = 0; step_id < steps_per_round; step_id++)
+            {
+                mj_step(m, d);
+            }
+            gather(env_id, false);
+        }
+    }
+
+    void scatter(const int env_id)
+    {
+        mjData *d = d_vec[env_id];
+        memcpy(d->qpos, qpos.data() + env_id * m->nq, m->nq * sizeof(mjtNum));
+        memcpy(d->qvel, qvel.data() + env_id * m->nv, m->nv * sizeof(mjtNum));
+        memcpy(d->act, act.data() + env_id * m->na, m->na * sizeof(mjtNum));
+        memcpy(d->ctrl, ctrl.data() + env_id * m->nu, m->nu * sizeof(mjtNum));
+        memcpy(d->qfrc_applied, qfrc_applied.data() + env_id * m->nv, m->nv * sizeof(mjtNum));
+        d->time = time[env_id];
+    }
+
+    /**
+     * @brief Gather the state of an environment into the batches, the inputs
+     * (ctrl, qfrc_applied) are only gathered on initialization since stepping
+     * does not change them
+     *
+     */
+    void gather(const int env_id, const bool include_inputs)
+    {
+        const mjData *d = d_vec[env_id];
+        memcpy(qpos.data() + env_id * m->nq, d->qpos, m->nq * sizeof(mjtNum));
+        memcpy(qvel.data() + env_id * m->nv, d->qvel, m->nv * sizeof(mjtNum));
+        memcpy(act.data() + env_id * m->na, d->act, m->na * sizeof(mjtNum));
+        time[env_id] = d->time;
+        memcpy(xpos.data() + env_id * m->nbody * 3, d->xpos, m->nbody * 3 * sizeof(mjtNum));
+        memcpy(xquat.data() + env_id * m->nbody * 4, d->xquat, m->nbody * 4 * sizeof(mjtNum));
+        memcpy(energy.data() + env_id * 2, d->energy, 2 * sizeof(mjtNum));
+        if (include_inputs)
+        {
+            memcpy(ctrl.data() + env_id * m->nu, d->ctrl, m->nu * sizeof(mjtNum));
+            memcpy(qfrc_applied.data() + env_id * m->nv, d->qfrc_applied, m->nv * sizeof(mjtNum));
+        }
+    }
+
+    void clean_up()
+    {
+        for (mjData *d : d_vec)
+        {
+            mj_deleteData(d);
+        }
+        d_vec.clear();
+        if (m != nullptr)
+        {
+            mj_deleteModel(m);
+            m = nullptr;
+        }
+    }
+
+private:
+    mjModel *m = nullptr;
+
+    std::vector<mjData *> d_vec;
+
+    std::vector<mjtNum> qpos;
+
+    std::vector<mjtNum> qvel;
+
+    std::vector<mjtNum> act;
+
+    std::vector<mjtNum> ctrl;
+
+    std::vector<mjtNum> qfrc_applied;
+
+    std::vector<mjtNum> time;
+
+    std::vector<mjtNum> xpos;
+
+    std::vector<mjtNum> xquat;
+
+    std::vector<mjtNum> energy;
+
+private:
+    std::vector<std::thread> workers;
+
+    std::mutex pool_mtx;
+
+    std::condition_variable start_cv;
+
+    std::condition_variable done_cv;
+
+    size_t pool_round = 0;
+
+    size_t busy_workers = 0;
+
+    int steps_per_round = 0;
+
+    std::atomic<int> next_env_id{0};
+
+    bool should_shut_down = false;
+};
+
+PYBIND11_MODULE(mujoco_rollout, handle)
+{
+    handle.doc() = "Step a batch of MuJoCo environments in parallel on the CPU";
+
+    handle.def("mj_version", &mj_version);
+
+    pybind11::class_<MujocoRollout>(handle, "MujocoRollout")
+        .def(pybind11::init<const uintptr_t, const int, const int>(),
+             pybind11::arg("model_address"),
+             pybind11::arg("number_of_envs"),
+             pybind11::arg("number_of_threads") = 0)
+        .def("step", &MujocoRollout::step, pybind11::arg("number_of_steps") = 1, pybind11::call_guard<pybind11::gil_scoped_release>())
+        .def_property_readonly("number_of_envs", &MujocoRollout::get_number_of_envs)
+        .def_property_readonly("number_of_threads", &MujocoRollout::get_number_of_threads)
+        .def_property_readonly("qpos", &MujocoRollout::get_qpos)
+        .def_property_readonly("qvel", &MujocoRollout::get_qvel)
+        .def_property_readonly("act", &MujocoRollout::get_act)
+        .def_property_readonly("ctrl", &MujocoRollout::get_ctrl)
+        .def_property_readonly("qfrc_applied", &MujocoRollout::get_qfrc_applied)
+        .def_property_readonly("time", &MujocoRollout::get_time)
+        .def_property_readonly("xpos", &MujocoRollout::get_xpos)
+        .def_property_readonly("xquat", &MujocoRollout::get_xquat)
+        .def_property_readonly("energy", &MujocoRollout::get_energy);
+}
@@ -43,6 +43,9 @@ class MultiverseMujocoConnector(MultiverseSimulator):
     use_mjx: bool = False
     """Use MJX (https://mujoco.readthedocs.io/en/stable/mjx.html)"""
 
+    _rollout = None
+    """Steps the environments on the CPU threads if number_of_envs > 1 without MJX"""
+
     def __init__(self,
                  file_path: str,
                  viewer: Optional[MultiverseViewer] = None,
@@ -96,6 +99,29 @@ class MultiverseMujocoConnector(MultiverseSimulator):
                                    self._mjx_data.replace(qpos=qpos, qvel=qvel, act=act, ctrl=ctrl))(qpos0, qvel0,
                                                                                                      act0, ctrl0)
             self._jit_step = jax.jit(jax.vmap(mjx.step, in_axes=(None, 0)))
+        elif number_of_envs > 1:
+            self._init_rollout(number_of_envs, int(kwargs.get('number_of_threads', 0)))
+
+    def _init_rollout(self, number_of_envs: int, number_of_threads: int):
+        from mujoco_rollout import MujocoRollout, mj_version
+        if mj_version() != mujoco.mj_version():
+            raise RuntimeError(f"mujoco_rollout is built against MuJoCo {mj_version()}, "
+                               f"but MuJoCo {mujoco.mj_version()} is imported")
+        self._rollout = MujocoRollout(self._mj_model._address, number_of_envs, number_of_threads)
+        self._reset_rollout()
+
+    def _reset_rollout(self):
+        """Set every environment to the state of _mj_data"""
+        for attr in ["qpos", "qvel", "act", "ctrl", "qfrc_applied", "time"]:
+            getattr(self._rollout, attr)[:] = getattr(self._mj_data, attr)
+        self._rollout.step(0)
+
+    def _sync_rollout(self):
+        """Mirror the first environment into _mj_data for the viewer"""
+        for attr in ["qpos", "qvel", "act", "ctrl", "qfrc_applied"]:
+            getattr(self._mj_data, attr)[:] = getattr(self._rollout, attr)[0]
+        self._mj_data.time = self._rollout.time[0]
+        mujoco.mj_forward(self._mj_model, self._mj_data)
 
     def start_callback(self):
         if not self.headless:
@@ -167,6 +193,10 @@ class MultiverseMujocoConnector(MultiverseSimulator):
             self._batch = self._jit_step(self._mjx_model, self._batch)
             if not self.headless:
                 self._mj_data = mjx.get_data(self._mj_model, self._batch)
+        elif self._rollout is not None:
+            self._rollout.step()
+            if not self.headless:
+                self._sync_rollout()
         else:
             mujoco.mj_step(self._mj_model, self._mj_data)
 
@@ -181,10 +211,12 @@ class MultiverseMujocoConnector(MultiverseSimulator):
             self._batch = jax.vmap(lambda qpos, qvel, act, ctrl:
                                    self._mjx_data.replace(qpos=qpos, qvel=qvel, act=act, ctrl=ctrl))(qpos0, qvel0,
                                                                                                      act0, ctrl0)
+        elif self._rollout is not None:
+            self._reset_rollout()
 
     def write_data_to_simulator(self, write_data: numpy.ndarray):
-        if not self.use_mjx and write_data.shape[0] > 1:
-            raise NotImplementedError("Multiple environments for non MJX is not supported yet")
+        if not self.use_mjx and self._rollout is None and write_data.shape[0] > 1:
+            raise NotImplementedError("Multiple environments need number_of_envs > 1")
         if self.use_mjx:
             batch_data = {}
             for attr, indices in self._write_ids.items():
@@ -206,6 +238,23 @@ class MultiverseMujocoConnector(MultiverseSimulator):
                     batch_data[attr] = numpy.array(getattr(self._batch, attr))
                     batch_data[attr][:, indices[0]] = write_data[:, indices[1]]
             self._batch = self._batch.replace(**batch_data)
+        elif self._rollout is not None:
+            # The batches of the rollout are written in place, the next step picks them up
+            for attr, indices in self._write_ids.items():
+                if attr in {"xpos", "xquat"}:
+                    for i, body_id in enumerate(indices[0]):
+                        jntid = self._mj_model.body(body_id).jntadr[0]
+                        jnt = self._mj_model.jnt(jntid)
+                        assert jnt.type == mujoco.mjtJoint.mjJNT_FREE
+                        qpos_adr = jnt.qposadr[0]
+                        if attr == "xpos":
+                            self._rollout.qpos[:, qpos_adr:qpos_adr + 3] = write_data[:, indices[1][3 * i:3 * i + 3]]
+                        elif attr == "xquat":
+                            self._rollout.qpos[:, qpos_adr + 3:qpos_adr + 7] = write_data[:, indices[1][4 * i:4 * i + 4]]
+                elif attr == "energy":
+                    raise NotImplementedError("Not supported")
+                else:
+                    getattr(self._rollout, attr)[:, indices[0]] = write_data[:, indices[1]]
         else:
             for attr, indices in self._write_ids.items():
                 if attr in {"xpos", "xquat"}:
@@ -224,8 +273,8 @@ class MultiverseMujocoConnector(MultiverseSimulator):
                     getattr(self._mj_data, attr)[indices[0]] = write_data[0][indices[1]]
 
     def read_data_from_simulator(self, read_data: numpy.ndarray):
-        if not self.use_mjx and read_data.shape[0] > 1:
-            raise NotImplementedError("Multiple environments for non MJX is not supported yet")
+        if not self.use_mjx and self._rollout is None and read_data.shape[0] > 1:
+            raise NotImplementedError("Multiple environments need number_of_envs > 1")
         if self.use_mjx:
             for attr, indices in self._read_ids.items():
                 if attr == "energy":
@@ -233,6 +282,13 @@ class MultiverseMujocoConnector(MultiverseSimulator):
                 else:
                     attr_values = getattr(self._batch, attr)
                     read_data[:, indices[1]] = attr_values[:, indices[0]].reshape(attr_values.shape[0], -1)
+        elif self._rollout is not None:
+            for attr, indices in self._read_ids.items():
+                if attr == "energy":
+                    read_data[:, indices[1]] = self._rollout.energy
+                else:
+                    attr_values = getattr(self._rollout, attr)
+                    read_data[:, indices[1]] = attr_values[:, indices[0]].reshape(attr_values.shape[0], -1)
         else:
             for attr, indices in self._read_ids.items():
                 if attr == "energy":
@@ -263,6 +319,8 @@ class MultiverseMujocoConnector(MultiverseSimulator):
                 key.delete()
         self._mj_model, self._mj_data = self._mj_spec.recompile(self._mj_model, self._mj_data)
         self._renderer._sim().load(self._mj_model, self._mj_data, "")
+        if self._rollout is not None:
+            self._init_rollout(self._rollout.number_of_envs, self._rollout.number_of_threads)
 
     @property
     def file_path(self) -> str:
@@ -270,7 +328,11 @@ class MultiverseMujocoConnector(MultiverseSimulator):
 
     @property
     def current_simulation_time(self) -> float:
-        return self._mj_data.time if not self.use_mjx else self._batch.time[0]
+        if self.use_mjx:
+            return self._batch.time[0]
+        if self._rollout is not None:
+            return self._rollout.time[0]
+        return self._mj_data.time
 
     @property
     def renderer(self):
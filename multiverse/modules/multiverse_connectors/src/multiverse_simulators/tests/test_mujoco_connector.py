@@ -1,7 +1,9 @@
+import copy
 import os
 import time
 import unittest
 import xml.etree.ElementTree as ET
+from threading import Thread
 
 import mujoco
 import mujoco.viewer
@@ -456,6 +458,81 @@ class MultiverseMujocoConnectorComplexTestCase(MultiverseMujocoConnectorBaseTest
             time.sleep(1)
         self.assertIs(simulator.state, MultiverseSimulatorState.STOPPED)
 
+    def test_running_with_rollout_in_10s(self):
+        simulator = MultiverseMujocoConnector(file_path=os.path.join(resources_path, "mjcf/unitree/h1_scene.xml"),
+                                              number_of_envs=8,
+                                              headless=False,
+                                              real_time_factor=-1,
+                                              step_size=0.001)
+        constraints = MultiverseSimulatorConstraints(max_simulation_time=10.0)
+        simulator.start(constraints=constraints)
+        while simulator.state != MultiverseSimulatorState.STOPPED:
+            time.sleep(1)
+        self.assertIs(simulator.state, MultiverseSimulatorState.STOPPED)
+        self.assertEqual(simulator._rollout.qpos.shape, (8, simulator._mj_model.nq))
+        numpy.testing.assert_allclose(simulator._rollout.time, simulator._rollout.time[0])
+
+
+class MujocoRolloutTestCase(unittest.TestCase):
+    model_xml = """
+    <mujoco>
+        <worldbody>
+            <geom name="floor" type="plane" size="2 2 0.1"/>
+            <body name="box" pos="0 0 0.5">
+                <freejoint name="box_joint"/>
+                <geom type="box" size="0.1 0.1 0.1" mass="1"/>
+            </body>
+            <body name="arm" pos="1 0 1">
+                <joint name="hinge" type="hinge" axis="0 1 0"/>
+                <geom type="capsule" size="0.05" fromto="0 0 0 0.5 0 0" mass="1"/>
+            </body>
+        </worldbody>
+        <actuator>
+            <motor name="motor" joint="hinge"/>
+        </actuator>
+    </mujoco>
+    """
+
+    def assert_rollout_equal(self, rollout, ds):
+        for env_id, d in enumerate(ds):
+            numpy.testing.assert_allclose(rollout.qpos[env_id], d.qpos, rtol=1e-10, atol=1e-12)
+            numpy.testing.assert_allclose(rollout.qvel[env_id], d.qvel, rtol=1e-10, atol=1e-12)
+            self.assertAlmostEqual(rollout.time[env_id], d.time)
+
+    def test_rollout_matches_sequential_steps(self):
+        from mujoco_rollout import MujocoRollout
+
+        m = mujoco.MjModel.from_xml_string(self.model_xml)
+        number_of_envs = 4
+        rollout = MujocoRollout(m._address, number_of_envs, 2)
+        ds = [mujoco.MjData(m) for _ in range(number_of_envs)]
+        hinge_qpos_adr = m.joint("hinge").qposadr[0]
+        for env_id, d in enumerate(ds):
+            d.qpos[hinge_qpos_adr] = 0.1 * env_id
+            d.ctrl[:] = 0.5
+            for attr in ["qpos", "qvel", "act", "ctrl", "qfrc_applied"]:
+                getattr(rollout, attr)[env_id] = getattr(d, attr)
+            rollout.time[env_id] = d.time
+
+        # Each environment of the rollout steps like its own mjData stepped sequentially from the same state
+        rollout.step(100)
+        for d in ds:
+            for _ in range(100):
+                mujoco.mj_step(m, d)
+        self.assert_rollout_equal(rollout, ds)
+
+        # A ctrl write between the steps applies to the next step of that environment only
+        d_unchanged = copy.deepcopy(ds[1])
+        rollout.ctrl[1] = -2.0
+        ds[1].ctrl[:] = -2.0
+        rollout.step(10)
+        for d in ds + [d_unchanged]:
+            for _ in range(10):
+                mujoco.mj_step(m, d)
+        self.assert_rollout_equal(rollout, ds)
+        hinge_dof_adr = m.joint("hinge").dofadr[0]
+        self.assertLess(rollout.qvel[1][hinge_dof_adr], d_unchanged.qvel[hinge_dof_adr])
+
 
 @unittest.skip("This test is not meant to be run in CI")
 class MujocoSpeedTestCase(unittest.TestCase):
@@ -517,5 +594,261 @@ class MujocoSpeedTestCase(unittest.TestCase):
         self.assertEqual(d.time, 0.0)
 
 
+@unittest.skip("This test must be run with 'multiverse_server' running")
+class MultiverseConnectorPluginTestCase(unittest.TestCase):
+    lib_path = MujocoSpeedTestCase.lib_path
+    server_port = "7000"
+    model_xml = """
+    <mujoco>
+        <worldbody>
+            <geom name="floor" type="plane" size="2 2 0.1"/>
+            <body name="box" pos="0 0 0.5">
+                <freejoint name="box_joint"/>
+                <geom type="box" size="0.1 0.1 0.1" mass="1"/>
+            </body>
+        </worldbody>
+    </mujoco>
+    """
+
+    model_xml_bodies_and_joints = """
+    <mujoco>
+        <option gravity="0 0 0"/>
+        <worldbody>
+            <body name="box_1" pos="0 0 0.5">
+                <freejoint name="box_1_joint"/>
+                <geom type="box" size="0.1 0.1 0.1" mass="1"/>
+            </body>
+            <body name="box_2" pos="1 0 0.5">
+                <freejoint name="box_2_joint"/>
+                <geom type="box" size="0.1 0.1 0.1" mass="1"/>
+            </body>
+            <body name="arm" pos="0 1 0.5">
+                <joint name="hinge" type="hinge" axis="0 0 1"/>
+                <geom type="capsule" size="0.05" fromto="0 0 0 0.5 0 0" mass="1"/>
+            </body>
+        </worldbody>
+    </mujoco>
+    """
+
+    def load_model(self, client_port, world_name, configs, model_xml=None):
+        mujoco.mj_loadPluginLibrary(self.lib_path)
+        root = ET.fromstring(self.model_xml if model_xml is None else model_xml)
+        instance = ET.SubElement(ET.SubElement(ET.SubElement(root, "extension"), "plugin",
+                                               plugin="mujoco.multiverse_connector"), "instance", name="mujoco_client")
+        configs = {"host": "tcp://127.0.0.1", "server_port": self.server_port, "client_port": client_port,
+                   "world_name": world_name, "simulation_name": f"{world_name}_mujoco", **configs}
+        for key, value in configs.items():
+            ET.SubElement(instance, "config", key=key, value=value)
+        return mujoco.MjModel.from_xml_string(ET.tostring(root, encoding='unicode', method='xml'))
+
+    def create_multiverse_client(self, port, world_name, simulation_name, send_objects, receive_objects):
+        from multiverse_client_py import MultiverseClient, MultiverseMetaData
+
+        class MultiverseClientTest(MultiverseClient):
+            def loginfo(self, message: str) -> None:
+                print(message)
+
+            def logwarn(self, message: str) -> None:
+                print(message)
+
+            def _run(self) -> None:
+                self._connect_and_start()
+
+            def send_and_receive_data(self):
+                self._communicate(False)
+
+        multiverse_meta_data = MultiverseMetaData(world_name=world_name, simulation_name=simulation_name)
+        multiverse_client = MultiverseClientTest(client_addr=port, multiverse_meta_data=multiverse_meta_data)
+        multiverse_client.request_meta_data["send"] = send_objects
+        multiverse_client.request_meta_data["receive"] = receive_objects
+        multiverse_client.run()
+        return multiverse_client
+
+    def step_concurrently(self, m, ds):
+        threads = [Thread(target=mujoco.mj_step, args=(m, d)) for d in ds]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+
+    def test_rollouts_combined_frame(self):
+        world_name = "world_plugin_rollouts"
+        m = self.load_model("7510", world_name,
+                            {"send": "{'box': ['position']}", "rollouts": "2", "rollout_timeout": "0.5"})
+        ds = [mujoco.MjData(m) for _ in range(2)]
+        ds[1].qpos[0] = 1.0
+        box_id = m.body("box").id
+        multiverse_client_test_receive = self.create_multiverse_client("7511", world_name, "sim_test_receive", {},
+                                                                       {"box": ["position"],
+                                                                        "box_rollout_1": ["position"]})
+
+        # Both rollouts wait for each other, so one frame carries the positions of the same step of both
+        for _ in range(10):
+            self.step_concurrently(m, ds)
+            multiverse_client_test_receive.send_data = [ds[0].time]
+            multiverse_client_test_receive.send_and_receive_data()
+            numpy.testing.assert_allclose(multiverse_client_test_receive.receive_data[1:],
+                                          numpy.concatenate([d.xpos[box_id] for d in ds]))
+
+        # A rollout that steps alone exchanges only its own values after the timeout
+        rollout_1_position = ds[1].xpos[box_id].copy()
+        mujoco.mj_step(m, ds[0])
+        multiverse_client_test_receive.send_data = [ds[0].time]
+        multiverse_client_test_receive.send_and_receive_data()
+        numpy.testing.assert_allclose(multiverse_client_test_receive.receive_data[1:],
+                                      numpy.concatenate([ds[0].xpos[box_id], rollout_1_position]))
+
+        # The rollout that missed the exchange sends its values as soon as it steps
+        mujoco.mj_step(m, ds[1])
+        multiverse_client_test_receive.send_data = [ds[0].time]
+        multiverse_client_test_receive.send_and_receive_data()
+        numpy.testing.assert_allclose(multiverse_client_test_receive.receive_data[4:], ds[1].xpos[box_id])
+
+        multiverse_client_test_receive.stop()
+
+    def test_odometric_velocity(self):
+        world_name = "world_plugin_odometry"
+        model_xml = """
+        <mujoco>
+            <option gravity="0 0 0"/>
+            <worldbody>
+                <body name="box" pos="0 0 0.5" quat="0.7071068 0 0 0.7071068">
+                    <freejoint name="box_joint"/>
+                    <geom type="box" size="0.1 0.1 0.1" mass="1"/>
+                </body>
+            </worldbody>
+        </mujoco>
+        """
+        multiverse_client_test_send = self.create_multiverse_client("7521", world_name, "sim_test_send",
+                                                                    {"box": ["odometric_velocity"]}, {})
+        multiverse_client_test_send.send_data = [0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.5]
+        multiverse_client_test_send.send_and_receive_data()
+
+        m = self.load_model("7520", world_name, {"receive": "{'box': ['odometric_velocity']}"}, model_xml)
+        d = mujoco.MjData(m)
+
+        # The forward velocity of the box is rotated by its yaw of 90 degrees, the angular velocity is kept
+        mujoco.mj_step(m, d)
+        numpy.testing.assert_allclose(d.qvel, [0.0, 1.0, 0.0, 0.0, 0.0, 0.5], atol=1e-6)
+
+        multiverse_client_test_send.stop()
+
+    def test_async(self):
+        world_name = "world_plugin_async"
+        m = self.load_model("7570", world_name,
+                            {"send": "{'box': ['position']}", "async": "true", "max_staleness": "-1"})
+        d = mujoco.MjData(m)
+        box_id = m.body("box").id
+        multiverse_client_test_receive = self.create_multiverse_client("7571", world_name, "sim_test_receive", {},
+                                                                       {"box": ["position"]})
+
+        # The steps never wait for the server, the communication thread sends the latest state in the background
+        for _ in range(100):
+            mujoco.mj_step(m, d)
+        time.sleep(0.1)
+        multiverse_client_test_receive.send_data = [d.time]
+        multiverse_client_test_receive.send_and_receive_data()
+        numpy.testing.assert_allclose(multiverse_client_test_receive.receive_data[1:], d.xpos[box_id])
+
+        # A reset that the communication thread receives is applied in the next step
+        multiverse_client_test_reset = self.create_multiverse_client("7572", world_name, "sim_test_reset", {}, {})
+        multiverse_client_test_reset.send_data = [0.0]
+        multiverse_client_test_reset.send_and_receive_data()
+        time_before_reset = d.time
+        for _ in range(100):
+            mujoco.mj_step(m, d)
+            if d.time < time_before_reset:
+                break
+            time.sleep(0.01)
+        self.assertLess(d.time, time_before_reset)
+
+        multiverse_client_test_reset.stop()
+        multiverse_client_test_receive.stop()
+
+    def test_binding_table(self):
+        world_name = "world_plugin_binding_table"
+        m = self.load_model("7530", world_name,
+                            {"send": "{'box_1': ['position', 'quaternion'], 'hinge': ['joint_rvalue']}"},
+                            self.model_xml_bodies_and_joints)
+        d = mujoco.MjData(m)
+        d.qpos[m.joint("hinge").qposadr[0]] = 0.3
+        box_1_id = m.body("box_1").id
+        multiverse_client_test_receive = self.create_multiverse_client("7531", world_name, "sim_test_receive", {},
+                                                                       {"box_1": ["position", "quaternion"],
+                                                                        "hinge": ["joint_rvalue"]})
+
+        # The names are resolved once, each step reads the values of the bodies and joints they refer to
+        for _ in range(3):
+            mujoco.mj_step(m, d)
+            multiverse_client_test_receive.send_data = [d.time]
+            multiverse_client_test_receive.send_and_receive_data()
+            numpy.testing.assert_allclose(multiverse_client_test_receive.receive_data[1:],
+                                          numpy.concatenate([d.xpos[box_1_id], d.xquat[box_1_id], [0.3]]))
+
+        multiverse_client_test_receive.stop()
+
+    def test_receive_runs(self):
+        world_name = "world_plugin_receive_runs"
+        multiverse_client_test_send = self.create_multiverse_client("7541", world_name, "sim_test_send",
+                                                                    {"box_2": ["position", "quaternion"],
+                                                                     "hinge": ["joint_rvalue"]}, {})
+        multiverse_client_test_send.send_data = [0.0, 1.0, 2.0, 0.5, 0.0, 0.0, 0.0, 1.0, 0.7]
+        multiverse_client_test_send.send_and_receive_data()
+
+        m = self.load_model("7540", world_name,
+                            {"receive": "{'box_2': ['position', 'quaternion'], 'hinge': ['joint_rvalue']}"},
+                            self.model_xml_bodies_and_joints)
+        d = mujoco.MjData(m)
+        box_2_qpos_adr = m.joint("box_2_joint").qposadr[0]
+
+        # The pose of the free body is one contiguous run in qpos, the hinge value is another
+        mujoco.mj_step(m, d)
+        numpy.testing.assert_allclose(d.qpos[box_2_qpos_adr:box_2_qpos_adr + 7], [1.0, 2.0, 0.5, 0.0, 0.0, 0.0, 1.0])
+        self.assertAlmostEqual(d.qpos[m.joint("hinge").qposadr[0]], 0.7)
+
+        multiverse_client_test_send.stop()
+
+    def test_contact_efforts(self):
+        world_name = "world_plugin_contact_efforts"
+        m = self.load_model("7550", world_name, {"send": "{'box': ['force', 'torque']}"})
+        d = mujoco.MjData(m)
+        multiverse_client_test_receive = self.create_multiverse_client("7551", world_name, "sim_test_receive", {},
+                                                                       {"box": ["force", "torque"]})
+
+        # Once the box rests on the floor, the contacts carry its weight and no torque
+        for _ in range(1500):
+            mujoco.mj_step(m, d)
+        multiverse_client_test_receive.send_data = [d.time]
+        multiverse_client_test_receive.send_and_receive_data()
+        weight = -m.body_mass[m.body("box").id] * m.opt.gravity
+        numpy.testing.assert_allclose(multiverse_client_test_receive.receive_data[1:],
+                                      numpy.concatenate([weight, numpy.zeros(3)]), atol=0.05)
+
+        multiverse_client_test_receive.stop()
+
+    def test_sensors(self):
+        world_name = "world_plugin_sensors"
+        root = ET.fromstring(self.model_xml)
+        sensor = ET.SubElement(root, "sensor")
+        ET.SubElement(sensor, "framepos", name="box_position", objtype="body", objname="box")
+        ET.SubElement(sensor, "framequat", name="box_quaternion", objtype="body", objname="box")
+        m = self.load_model("7560", world_name, {"sensors": "['box_quaternion', 'box_position']"},
+                            ET.tostring(root, encoding='unicode', method='xml'))
+        d = mujoco.MjData(m)
+        multiverse_client_test_receive = self.create_multiverse_client("7561", world_name, "sim_test_receive", {},
+                                                                       {f"{world_name}_mujoco": ["sensors"]})
+
+        # The sensors tensor holds the sensor values in the listed order, not in the model order
+        for _ in range(3):
+            mujoco.mj_step(m, d)
+            multiverse_client_test_receive.send_data = [d.time]
+            multiverse_client_test_receive.send_and_receive_data()
+            numpy.testing.assert_allclose(multiverse_client_test_receive.receive_data[1:],
+                                          numpy.concatenate([d.sensor("box_quaternion").data,
+                                                             d.sensor("box_position").data]))
+
+        multiverse_client_test_receive.stop()
+
+
 if __name__ == '__main__':
     unittest.main()
@@ -20,15 +20,23 @@
 
 #pragma once
 
+#include "multiverse_compression.h"
 #include <map>
 #include <string>
 #include <atomic>
+#include <vector>
+#include <cstdint>
 
 template<class T>
 struct TypedBuffer
 {
     T *data;
     size_t size = 0;
+    std::vector<T> last_data;
+    std::vector<uint32_t> delta_ranges;
+    std::vector<char> delta_data;
+    std::vector<char> compressed_data;
+    LZ4HashTable hash_table;
 };
 
 struct Buffer
@@ -36,6 +44,8 @@ struct Buffer
     TypedBuffer<double> buffer_double;
     TypedBuffer<uint8_t> buffer_uint8_t;
     TypedBuffer<uint16_t> buffer_uint16_t;
+    TypedBuffer<float> buffer_float;
+    TypedBuffer<uint16_t> buffer_half;
 };
 
 enum class EMultiverseClientState : unsigned char;
@@ -78,6 +88,43 @@ public:
      */
     void disconnect();
 
+    /**
+     * @brief Request the values of attributes at, or interpolated to, a past
+     * time from the history of the world, can be called between two
+     * communicate calls
+     *
+     * @param history_request_str The history request in JSON, e.g.
+     * {"time": 1.5, "interpolate": true, "receive": {"object": ["position"]}}
+     * @return std::string The history response in JSON, empty if the client is
+     * not communicating
+     */
+    std::string request_history(const std::string &history_request_str);
+
+    /**
+     * @brief Set whether communicate returns while the server reply is
+     * pending instead of blocking, poll then finishes the communication
+     *
+     * @param in_is_non_blocking true to return while the reply is pending
+     */
+    void set_non_blocking(const bool in_is_non_blocking);
+
+    /**
+     * @brief Finish a pending communication if the server reply has arrived,
+     * never blocks
+     *
+     * @return true if no communication is pending anymore
+     * @return false if the server reply is still pending
+     */
+    bool poll();
+
+    /**
+     * @brief Get the file descriptor that signals the events of the socket,
+     * an event loop can watch it and call poll when it is readable
+     *
+     * @return intptr_t The file descriptor, -1 if the socket is not open
+     */
+    intptr_t get_socket_fd() const;
+
 public:
     /**
      * @brief Get the current time in time_unit
@@ -99,6 +146,13 @@ protected:
      */
     void connect_to_server();
 
+    /**
+     * @brief Unblock a communication that waits for the server, can be
+     * called from another thread, all further communications fail
+     *
+     */
+    void interrupt();
+
 protected:
     /**
      * @brief Start connect_to_server thread
@@ -137,6 +191,14 @@ protected:
      */
     virtual void bind_request_meta_data() = 0;
 
+    /**
+     * @brief Get the world name, a router uses it to route the client to the
+     * server that hosts the world
+     *
+     * @return std::string The world name, empty for the default world
+     */
+    virtual std::string get_world_name() const;
+
     /**
      * @brief Compute request_meta_data and response_meta_data from response_meta_data_str
      *
@@ -255,6 +317,13 @@ private:
      */
     void init_buffer();
 
+private:
+    /**
+     * @brief If true, communicate and poll return while the server reply is pending
+     *
+     */
+    bool is_non_blocking = false;
+
 protected:
     /**
      * @brief The host IP address of the server
@@ -310,6 +379,27 @@ protected:
      */
     double *world_time = (double *)calloc(1, sizeof(double));
 
+    /**
+     * @brief True if the send data should be sent as delta frames, set from
+     * "delta_encoding" in the response meta data
+     * 
+     */
+    bool is_delta_encoding = false;
+
+    /**
+     * @brief The compression of the uint8 buffers (rgb), set from
+     * "compression" in the response meta data
+     * 
+     */
+    ECompression compression_uint8_t = ECompression::None;
+
+    /**
+     * @brief The compression of the uint16 buffers (depth), set from
+     * "compression" in the response meta data
+     * 
+     */
+    ECompression compression_uint16_t = ECompression::None;
+
 private:
     /**
      * @brief The socket address of the client
@@ -327,7 +417,7 @@ private:
      * @brief The client socket
      * 
      */
-    void *client_socket;
+    void *client_socket = nullptr;
 
     /**
      * @brief True if the client should be shut down
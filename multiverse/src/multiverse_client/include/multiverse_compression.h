@@ -0,0 +1,669 @@
+// Copyright (c) 2023, Giang Hoang Nguyen - Institute for Artificial Intelligence, University Bremen
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Compression of the uint8 buffer (rgb) and the uint16 buffer (depth),
+ * negotiated with "compression" in the meta data, e.g.
+ * {"rgb": "lz4", "depth": "delta_bitpack"}.
+ *
+ */
+enum class ECompression : unsigned char
+{
+    None,
+    LZ4,
+    DeltaBitpack
+};
+
+/**
+ * @brief Get the compression from its name in the meta data
+ *
+ * @param compression_name "none", "lz4" or "delta_bitpack"
+ * @param compression The compression
+ * @return true if the name is known
+ */
+inline bool get_compression(const std::string &compression_name, ECompression &compression)
+{
+    if (compression_name.empty() || compression_name == "none")
+    {
+        compression = ECompression::None;
+    }
+    else if (compression_name == "lz4")
+    {
+        compression = ECompression::LZ4;
+    }
+    else if (compression_name == "delta_bitpack")
+    {
+        compression = ECompression::DeltaBitpack;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief The LZ4 hash table of a buffer, kept between the frames. The
+ * positions of a frame are stored with the offset of the frame, so the
+ * entries of the previous frames are ignored without clearing the table.
+ *
+ */
+struct LZ4HashTable
+{
+    std::vector<uint32_t> positions;
+    uint32_t offset = 0;
+};
+
+/**
+ * @brief Compress the data into an LZ4 block (greedy, 64 KB window)
+ *
+ * @param src The data
+ * @param src_size The size of the data in bytes
+ * @param dst The LZ4 block
+ * @param hash_table The hash table of the buffer
+ */
+inline void lz4_compress(const uint8_t *src, const size_t src_size, std::vector<char> &dst, LZ4HashTable &hash_table)
+{
+    const size_t min_match = 4;
+    const size_t last_literals = 5;
+    const size_t match_find_limit = 12;
+    const size_t hash_log = 16;
+
+    dst.clear();
+    dst.reserve(src_size + src_size / 255 + 16);
+
+    auto write_length = [&dst](size_t length)
+    {
+        for (; length >= 255; length -= 255)
+        {
+            dst.push_back((char)255);
+        }
+        dst.push_back((char)length);
+    };
+
+    auto write_sequence = [&dst, &src, &write_length](const size_t anchor, const size_t literal_length, const size_t offset, const size_t match_length, const bool has_match)
+    {
+        const size_t token_pos = dst.size();
+        dst.push_back(0);
+        uint8_t token = (uint8_t)((literal_length >= 15 ? 15 : literal_length) << 4);
+        if (literal_length >= 15)
+        {
+            write_length(literal_length - 15);
+        }
+        dst.insert(dst.end(), src + anchor, src + anchor + literal_length);
+        if (has_match)
+        {
+            dst.push_back((char)(offset & 0xFF));
+            dst.push_back((char)(offset >> 8));
+            const size_t extra_match_length = match_length - min_match;
+            token |= (uint8_t)(extra_match_length >= 15 ? 15 : extra_match_length);
+            if (extra_match_length >= 15)
+            {
+                write_length(extra_match_length - 15);
+            }
+        }
+        dst[token_pos] = (char)token;
+    };
+
+    size_t anchor = 0;
+    if (src_size > match_find_limit)
+    {
+        if (hash_table.positions.size() != (1 << hash_log) || (uint64_t)hash_table.offset + src_size + 1 > UINT32_MAX)
+        {
+            hash_table.positions.assign(1 << hash_log, 0);
+            hash_table.offset = 0;
+        }
+        uint32_t *positions = hash_table.positions.data();
+        const uint32_t offset = hash_table.offset;
+        hash_table.offset += (uint32_t)src_size + 1;
+
+        const size_t match_limit = src_size - last_literals;
+        for (size_t i = 0; i + match_find_limit <= src_size;)
+        {
+            uint32_t sequence;
+            memcpy(&sequence, src + i, sizeof(uint32_t));
+            const uint32_t hash = (sequence * 2654435761u) >> (32 - hash_log);
+            const size_t candidate = positions[hash] > offset ? positions[hash] - offset : 0;
+            positions[hash] = offset + (uint32_t)(i + 1);
+
+            if (candidate == 0 || i - (candidate - 1) > 65535 || memcmp(src + candidate - 1, &sequence, sizeof(uint32_t)) != 0)
+            {
+                i++;
+                continue;
+            }
+
+            const size_t match = candidate - 1;
+            size_t match_length = min_match;
+            while (i + match_length < match_limit && src[match + match_length] == src[i + match_length])
+            {
+                match_length++;
+            }
+
+            write_sequence(anchor, i - anchor, i - match, match_length, true);
+            i += match_length;
+            anchor = i;
+        }
+    }
+    write_sequence(anchor, src_size - anchor, 0, 0, false);
+}
+
+/**
+ * @brief Decompress an LZ4 block
+ *
+ * @param src The LZ4 block
+ * @param src_size The size of the LZ4 block in bytes
+ * @param dst The data
+ * @param dst_size The size of the data in bytes
+ * @return true if the block is valid and fills exactly dst_size bytes
+ */
+inline bool lz4_decompress(const char *src, const size_t src_size, uint8_t *dst, const size_t dst_size)
+{
+    const uint8_t *in = reinterpret_cast<const uint8_t *>(src);
+    size_t ip = 0;
+    size_t op = 0;
+
+    auto read_length = [in, src_size, &ip](size_t &length) -> bool
+    {
+        uint8_t byte;
+        do
+        {
+            if (ip >= src_size)
+            {
+                return false;
+            }
+            byte = in[ip++];
+            length += byte;
+        } while (byte == 255);
+        return true;
+    };
+
+    while (ip < src_size)
+    {
+        const uint8_t token = in[ip++];
+        size_t literal_length = token >> 4;
+        if (literal_length == 15 && !read_length(literal_length))
+        {
+            return false;
+        }
+        if (ip + literal_length > src_size || op + literal_length > dst_size)
+        {
+            return false;
+        }
+        memcpy(dst + op, in + ip, literal_length);
+        ip += literal_length;
+        op += literal_length;
+
+        if (ip == src_size)
+        {
+            break;
+        }
+
+        if (ip + 2 > src_size)
+        {
+            return false;
+        }
+        const size_t offset = in[ip] | (in[ip + 1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > op)
+        {
+            return false;
+        }
+
+        size_t match_length = token & 15;
+        if (match_length == 15 && !read_length(match_length))
+        {
+            return false;
+        }
+        match_length += 4;
+        if (op + match_length > dst_size)
+        {
+            return false;
+        }
+
+        // The match may overlap with the output, so copy byte by byte
+        for (size_t i = 0; i < match_length; i++, op++)
+        {
+            dst[op] = dst[op - offset];
+        }
+    }
+    return op == dst_size;
+}
+
+/**
+ * @brief Compress 16-bit data (e.g. depth images) by zigzag encoding the
+ * differences to the previous value and bit-packing them in blocks of 128
+ * values, each block starts with its bit width
+ *
+ * @param src The data
+ * @param count The number of values
+ * @param dst The compressed data
+ */
+inline void delta_bitpack_compress(const uint16_t *src, const size_t count, std::vector<char> &dst)
+{
+    const size_t block_size = 128;
+
+    dst.clear();
+    dst.reserve(count * sizeof(uint16_t) + count / block_size + 1);
+
+    uint16_t zigzags[block_size];
+    uint16_t previous = 0;
+    for (size_t block_start = 0; block_start < count; block_start += block_size)
+    {
+        const size_t block_count = count - block_start < block_size ? count - block_start : block_size;
+        uint16_t bits = 0;
+        for (size_t i = 0; i < block_count; i++)
+        {
+            const int16_t delta = (int16_t)(uint16_t)(src[block_start + i] - previous);
+            previous = src[block_start + i];
+            zigzags[i] = (uint16_t)((uint16_t)(delta << 1) ^ (uint16_t)(delta >> 15));
+            bits |= zigzags[i];
+        }
+
+        uint8_t bit_width = 0;
+        for (; bits != 0; bits >>= 1)
+        {
+            bit_width++;
+        }
+        dst.push_back((char)bit_width);
+
+        uint32_t accumulator = 0;
+        uint8_t accumulator_bits = 0;
+        for (size_t i = 0; i < block_count && bit_width > 0; i++)
+        {
+            accumulator |= (uint32_t)zigzags[i] << accumulator_bits;
+            accumulator_bits += bit_width;
+            for (; accumulator_bits >= 8; accumulator_bits -= 8, accumulator >>= 8)
+            {
+                dst.push_back((char)(accumulator & 0xFF));
+            }
+        }
+        if (accumulator_bits > 0)
+        {
+            dst.push_back((char)(accumulator & 0xFF));
+        }
+    }
+}
+
+/**
+ * @brief Decompress the data from delta_bitpack_compress
+ *
+ * @param src The compressed data
+ * @param src_size The size of the compressed data in bytes
+ * @param dst The data
+ * @param count The number of values
+ * @return true if the compressed data is valid and fills exactly count values
+ */
+inline bool delta_bitpack_decompress(const char *src, const size_t src_size, uint16_t *dst, const size_t count)
+{
+    const size_t block_size = 128;
+    const uint8_t *in = reinterpret_cast<const uint8_t *>(src);
+    size_t ip = 0;
+
+    uint16_t previous = 0;
+    for (size_t block_start = 0; block_start < count; block_start += block_size)
+    {
+        const size_t block_count = count - block_start < block_size ? count - block_start : block_size;
+        if (ip >= src_size)
+        {
+            return false;
+        }
+        const uint8_t bit_width = in[ip++];
+        if (bit_width > 16 || ip + (block_count * bit_width + 7) / 8 > src_size)
+        {
+            return false;
+        }
+
+        const uint32_t mask = (1u << bit_width) - 1;
+        uint32_t accumulator = 0;
+        uint8_t accumulator_bits = 0;
+        for (size_t i = 0; i < block_count; i++)
+        {
+            for (; accumulator_bits < bit_width; accumulator_bits += 8)
+            {
+                accumulator |= (uint32_t)in[ip++] << accumulator_bits;
+            }
+            const uint16_t zigzag = (uint16_t)(accumulator & mask);
+            accumulator >>= bit_width;
+            accumulator_bits -= bit_width;
+
+            const uint16_t delta = (uint16_t)((zigzag >> 1) ^ (uint16_t)-(int16_t)(zigzag & 1));
+            previous = (uint16_t)(previous + delta);
+            dst[block_start + i] = previous;
+        }
+    }
+    return ip == src_size;
+}
+
+/**
+ * @brief Compress the uint8 data with LZ4
+ *
+ */
+inline void compress_data(const uint8_t *data, const size_t count, std::vector<char> &compressed_data, LZ4HashTable &hash_table)
+{
+    lz4_compress(data, count * sizeof(uint8_t), compressed_data, hash_table);
+}
+
+/**
+ * @brief Compress the uint16 data with the given compression
+ *
+ */
+inline void compress_data(const uint16_t *data, const size_t count, const ECompression compression, std::vector<char> &compressed_data, LZ4HashTable &hash_table)
+{
+    if (compression == ECompression::DeltaBitpack)
+    {
+        delta_bitpack_compress(data, count, compressed_data);
+    }
+    else
+    {
+        lz4_compress(reinterpret_cast<const uint8_t *>(data), count * sizeof(uint16_t), compressed_data, hash_table);
+    }
+}
+
+/**
+ * @brief Decompress the uint8 data with LZ4
+ *
+ */
+inline bool decompress_data(const char *compressed_data, const size_t compressed_size, uint8_t *data, const size_t count)
+{
+    return lz4_decompress(compressed_data, compressed_size, data, count * sizeof(uint8_t));
+}
+
+/**
+ * @brief Decompress the uint16 data with the given compression
+ *
+ */
+inline bool decompress_data(const char *compressed_data, const size_t compressed_size, const ECompression compression, uint16_t *data, const size_t count)
+{
+    if (compression == ECompression::DeltaBitpack)
+    {
+        return delta_bitpack_decompress(compressed_data, compressed_size, data, count);
+    }
+    return lz4_decompress(compressed_data, compressed_size, reinterpret_cast<uint8_t *>(data), count * sizeof(uint16_t));
+}
+
+/**
+ * @brief Compress the uint8 and uint16 buffers into their compressed_data
+ *
+ * @tparam BufferType Buffer with buffer_uint8_t and buffer_uint16_t
+ */
+template <class BufferType>
+inline void compress_buffer(BufferType &buffer, const ECompression compression_uint8_t, const ECompression compression_uint16_t)
+{
+    if (compression_uint8_t != ECompression::None && buffer.buffer_uint8_t.size > 0)
+    {
+        compress_data(buffer.buffer_uint8_t.data, buffer.buffer_uint8_t.size, buffer.buffer_uint8_t.compressed_data, buffer.buffer_uint8_t.hash_table);
+    }
+    if (compression_uint16_t != ECompression::None && buffer.buffer_uint16_t.size > 0)
+    {
+        compress_data(buffer.buffer_uint16_t.data, buffer.buffer_uint16_t.size, compression_uint16_t, buffer.buffer_uint16_t.compressed_data, buffer.buffer_uint16_t.hash_table);
+    }
+}
+
+/**
+ * @brief Delta frames use the message spec of the full frames (at most 7 with
+ * the double, uint8, uint16, float and half buffers) plus this offset. Each
+ * buffer of a delta frame contains the number of ranges, the ranges
+ * as (start, length) pairs and the values of the ranges, all other values stay
+ * the same as in the previous frame.
+ *
+ */
+static const int delta_message_spec_offset = 8;
+
+/**
+ * @brief Encode the changes of the typed buffer since the last call into its
+ * delta_data, the ranges are merged if the gap is cheaper than a new range
+ *
+ * @tparam TypedBufferType Typed buffer with data, size, last_data, delta_ranges and delta_data
+ * @return The size of the delta data in bytes
+ */
+template <class TypedBufferType>
+inline size_t encode_delta(TypedBufferType &typed_buffer)
+{
+    typedef typename std::remove_pointer<decltype(typed_buffer.data)>::type T;
+    std::vector<uint32_t> &delta_ranges = typed_buffer.delta_ranges;
+    delta_ranges.clear();
+    if (typed_buffer.last_data.size() != typed_buffer.size)
+    {
+        typed_buffer.last_data.resize(typed_buffer.size);
+        delta_ranges.push_back(0);
+        delta_ranges.push_back(typed_buffer.size);
+    }
+    else
+    {
+        const T *data = typed_buffer.data;
+        const T *last_data = typed_buffer.last_data.data();
+        for (size_t i = 0; i < typed_buffer.size;)
+        {
+            if (memcmp(&data[i], &last_data[i], sizeof(T)) == 0)
+            {
+                i++;
+                continue;
+            }
+
+            const size_t start = i;
+            for (i++; i < typed_buffer.size && memcmp(&data[i], &last_data[i], sizeof(T)) != 0; i++)
+            {
+            }
+
+            // Merge with the previous range if the gap is cheaper than a new range
+            const size_t range_count = delta_ranges.size();
+            if (range_count > 0 && (start - delta_ranges[range_count - 2] - delta_ranges[range_count - 1]) * sizeof(T) <= 2 * sizeof(uint32_t))
+            {
+                delta_ranges[range_count - 1] = i - delta_ranges[range_count - 2];
+            }
+            else
+            {
+                delta_ranges.push_back(start);
+                delta_ranges.push_back(i - start);
+            }
+        }
+    }
+
+    size_t value_count = 0;
+    for (size_t i = 1; i < delta_ranges.size(); i += 2)
+    {
+        value_count += delta_ranges[i];
+    }
+
+    const uint32_t range_count = delta_ranges.size() / 2;
+    const size_t header_size = sizeof(uint32_t) * (1 + delta_ranges.size());
+    typed_buffer.delta_data.resize(header_size + value_count * sizeof(T));
+    char *delta_data = typed_buffer.delta_data.data();
+    memcpy(delta_data, &range_count, sizeof(uint32_t));
+    memcpy(delta_data + sizeof(uint32_t), delta_ranges.data(), delta_ranges.size() * sizeof(uint32_t));
+    delta_data += header_size;
+    for (size_t i = 0; i < delta_ranges.size(); i += 2)
+    {
+        memcpy(delta_data, typed_buffer.data + delta_ranges[i], delta_ranges[i + 1] * sizeof(T));
+        delta_data += delta_ranges[i + 1] * sizeof(T);
+    }
+
+    memcpy(typed_buffer.last_data.data(), typed_buffer.data, typed_buffer.size * sizeof(T));
+    return typed_buffer.delta_data.size();
+}
+
+/**
+ * @brief Apply a delta from encode_delta to the data
+ *
+ * @param delta_data The delta
+ * @param delta_size The size of the delta in bytes
+ * @param data The data
+ * @param count The number of values
+ * @return true if the delta is valid and fits into count values
+ */
+template <class T>
+inline bool decode_delta(const char *delta_data, const size_t delta_size, T *data, const size_t count)
+{
+    uint32_t range_count;
+    if (delta_size < sizeof(uint32_t))
+    {
+        return false;
+    }
+    memcpy(&range_count, delta_data, sizeof(uint32_t));
+
+    const size_t header_size = sizeof(uint32_t) * (1 + 2 * (size_t)range_count);
+    if (delta_size < header_size)
+    {
+        return false;
+    }
+
+    size_t offset = header_size;
+    for (size_t i = 0; i < range_count; i++)
+    {
+        uint32_t range[2];
+        memcpy(range, delta_data + sizeof(uint32_t) * (1 + 2 * i), 2 * sizeof(uint32_t));
+        if ((size_t)range[0] + range[1] > count || offset + range[1] * sizeof(T) > delta_size)
+        {
+            return false;
+        }
+        memcpy(data + range[0], delta_data + offset, range[1] * sizeof(T));
+        offset += range[1] * sizeof(T);
+    }
+    return offset == delta_size;
+}
+
+/**
+ * @brief Encode the deltas of all non-empty typed buffers
+ *
+ * @tparam BufferType Buffer with the double, uint8, uint16, float and half buffers
+ * @return true if the delta frame is smaller than the full frame
+ */
+template <class BufferType>
+inline bool encode_delta_buffer(BufferType &buffer)
+{
+    size_t full_size = 0;
+    size_t delta_size = 0;
+    if (buffer.buffer_double.size > 0)
+    {
+        full_size += buffer.buffer_double.size * sizeof(double);
+        delta_size += encode_delta(buffer.buffer_double);
+    }
+    if (buffer.buffer_uint8_t.size > 0)
+    {
+        full_size += buffer.buffer_uint8_t.size * sizeof(uint8_t);
+        delta_size += encode_delta(buffer.buffer_uint8_t);
+    }
+    if (buffer.buffer_uint16_t.size > 0)
+    {
+        full_size += buffer.buffer_uint16_t.size * sizeof(uint16_t);
+        delta_size += encode_delta(buffer.buffer_uint16_t);
+    }
+    if (buffer.buffer_float.size > 0)
+    {
+        full_size += buffer.buffer_float.size * sizeof(float);
+        delta_size += encode_delta(buffer.buffer_float);
+    }
+    if (buffer.buffer_half.size > 0)
+    {
+        full_size += buffer.buffer_half.size * sizeof(uint16_t);
+        delta_size += encode_delta(buffer.buffer_half);
+    }
+    return delta_size < full_size;
+}
+
+/**
+ * @brief Convert a float to an IEEE 754 half precision value, rounded to the
+ * nearest even, used by the half transport buffer
+ *
+ */
+inline uint16_t float_to_half(const float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    const uint16_t sign = (bits >> 16) & 0x8000;
+    const uint32_t abs_bits = bits & 0x7FFFFFFF;
+    if (abs_bits >= 0x7F800000)
+    {
+        return sign | (abs_bits > 0x7F800000 ? 0x7E00 : 0x7C00);
+    }
+    if (abs_bits >= 0x477FF000)
+    {
+        return sign | 0x7C00;
+    }
+    if (abs_bits < 0x38800000)
+    {
+        if (abs_bits < 0x33000000)
+        {
+            return sign;
+        }
+        const uint32_t shift = 126 - (abs_bits >> 23);
+        const uint32_t mantissa = (abs_bits & 0x007FFFFF) | 0x00800000;
+        uint32_t half = mantissa >> shift;
+        const uint32_t remainder = mantissa & ((1u << shift) - 1);
+        const uint32_t halfway = 1u << (shift - 1);
+        if (remainder > halfway || (remainder == halfway && (half & 1)))
+        {
+            half++;
+        }
+        return sign | half;
+    }
+    uint32_t half = ((abs_bits - 0x38000000) >> 13);
+    const uint32_t remainder = abs_bits & 0x1FFF;
+    if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1)))
+    {
+        half++;
+    }
+    return sign | half;
+}
+
+/**
+ * @brief Convert an IEEE 754 half precision value to a float
+ *
+ */
+inline float half_to_float(const uint16_t value)
+{
+    const uint32_t sign = (uint32_t)(value & 0x8000) << 16;
+    const uint32_t exponent = (value >> 10) & 0x1F;
+    uint32_t mantissa = value & 0x03FF;
+    uint32_t bits;
+    if (exponent == 0x1F)
+    {
+        bits = sign | 0x7F800000 | (mantissa << 13);
+    }
+    else if (exponent != 0)
+    {
+        bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    }
+    else if (mantissa == 0)
+    {
+        bits = sign;
+    }
+    else
+    {
+        uint32_t shifted_exponent = 113;
+        while ((mantissa & 0x0400) == 0)
+        {
+            mantissa <<= 1;
+            shifted_exponent--;
+        }
+        bits = sign | (shifted_exponent << 23) | ((mantissa & 0x03FF) << 13);
+    }
+    float result;
+    memcpy(&result, &bits, sizeof(result));
+    return result;
+}
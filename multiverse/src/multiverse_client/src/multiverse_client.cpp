@@ -42,6 +42,100 @@ enum class EMultiverseClientState : unsigned char
     BindReceiveData
 };
 
+template <class T>
+static bool receive_delta(TypedBuffer<T> &typed_buffer, void *client_socket)
+{
+    zmq_msg_t message;
+    zmq_msg_init(&message);
+    zmq_msg_recv(&message, client_socket, 0);
+    const bool is_valid = decode_delta(static_cast<const char *>(zmq_msg_data(&message)), zmq_msg_size(&message), typed_buffer.data, typed_buffer.size);
+    zmq_msg_close(&message);
+    return is_valid;
+}
+
+template <class T>
+static void send_typed_data(void *client_socket, const TypedBuffer<T> &typed_buffer, const bool is_delta_frame, const ECompression compression, const int flags)
+{
+    if (is_delta_frame)
+    {
+        zmq_send(client_socket, typed_buffer.delta_data.data(), typed_buffer.delta_data.size(), flags);
+    }
+    else if (compression == ECompression::None)
+    {
+        zmq_send(client_socket, typed_buffer.data, typed_buffer.size * sizeof(T), flags);
+    }
+    else
+    {
+        zmq_send(client_socket, typed_buffer.compressed_data.data(), typed_buffer.compressed_data.size(), flags);
+    }
+}
+
+template <class T>
+static void receive_typed_data(void *client_socket, TypedBuffer<T> &typed_buffer, const bool is_delta_frame)
+{
+    if (is_delta_frame)
+    {
+        if (!receive_delta(typed_buffer, client_socket))
+        {
+            throw std::runtime_error("The delta message does not match the receive buffers.");
+        }
+        return;
+    }
+    zmq_recv(client_socket, typed_buffer.data, typed_buffer.size * sizeof(T), 0);
+}
+
+static void receive_typed_data(void *client_socket, TypedBuffer<uint8_t> &typed_buffer, const bool is_delta_frame, const ECompression compression)
+{
+    if (is_delta_frame || compression == ECompression::None)
+    {
+        receive_typed_data(client_socket, typed_buffer, is_delta_frame);
+        return;
+    }
+
+    zmq_msg_t message;
+    zmq_msg_init(&message);
+    zmq_msg_recv(&message, client_socket, 0);
+    const bool is_valid = decompress_data(static_cast<const char *>(zmq_msg_data(&message)), zmq_msg_size(&message), typed_buffer.data, typed_buffer.size);
+    zmq_msg_close(&message);
+    if (!is_valid)
+    {
+        throw std::runtime_error("The compressed message does not match the receive buffers.");
+    }
+}
+
+static void receive_typed_data(void *client_socket, TypedBuffer<uint16_t> &typed_buffer, const bool is_delta_frame, const ECompression compression)
+{
+    if (is_delta_frame || compression == ECompression::None)
+    {
+        receive_typed_data(client_socket, typed_buffer, is_delta_frame);
+        return;
+    }
+
+    zmq_msg_t message;
+    zmq_msg_init(&message);
+    zmq_msg_recv(&message, client_socket, 0);
+    const bool is_valid = decompress_data(static_cast<const char *>(zmq_msg_data(&message)), zmq_msg_size(&message), compression, typed_buffer.data, typed_buffer.size);
+    zmq_msg_close(&message);
+    if (!is_valid)
+    {
+        throw std::runtime_error("The compressed message does not match the receive buffers.");
+    }
+}
+
+static const int history_message_spec = -1;
+
+static int get_buffer_count(const Buffer &buffer)
+{
+    return (buffer.buffer_double.size > 0) + (buffer.buffer_uint8_t.size > 0) + (buffer.buffer_uint16_t.size > 0) + (buffer.buffer_float.size > 0) + (buffer.buffer_half.size > 0);
+}
+
+static bool has_message(void *socket)
+{
+    int events = 0;
+    size_t events_size = sizeof(events);
+    return zmq_getsockopt(socket, ZMQ_EVENTS, &events, &events_size) == 0 && (events & ZMQ_POLLIN) != 0;
+}
+
 void MultiverseClient::connect_to_server()
 {
     zmq_disconnect(client_socket, socket_addr.c_str());
@@ -65,6 +159,12 @@ void MultiverseClient::connect_to_server()
     zmq_msg_init_size(&request, socket_addr.size());
     memcpy(zmq_msg_data(&request), socket_addr.c_str(), socket_addr.size());
     printf("[Client %s] Sending request %s to %s.\n", client_port.c_str(), socket_addr.c_str(), server_socket_addr.c_str());
+    zmq_msg_send(&request, client_socket, ZMQ_SNDMORE);
+    zmq_msg_close(&request);
+
+    const std::string world_name = get_world_name();
+    zmq_msg_init_size(&request, world_name.size());
+    memcpy(zmq_msg_data(&request), world_name.c_str(), world_name.size());
     zmq_msg_send(&request, client_socket, 0);
     printf("[Client %s] Sent request %s to %s.\n", client_port.c_str(), socket_addr.c_str(), server_socket_addr.c_str());
     zmq_msg_close(&request);
@@ -146,6 +246,11 @@ void MultiverseClient::connect()
     start_connect_to_server_thread();
 }
 
+std::string MultiverseClient::get_world_name() const
+{
+    return "";
+}
+
 double MultiverseClient::get_time_now() const
 {
     return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count() / 1000000.0;
@@ -179,6 +284,11 @@ void MultiverseClient::run()
             break;
 
         case EMultiverseClientState::ReceiveResponseMetaData:
+            if (is_non_blocking && !has_message(client_socket))
+            {
+                return;
+            }
+
             receive_data();
 
             check_response_meta_data();
@@ -196,14 +306,18 @@ void MultiverseClient::run()
             clean_up();
             init_send_and_receive_data();
 
-            printf("[Client %s] Starting the communication (send: [%zu - %zu - %zu], receive: [%zu - %zu - %zu]).\n",
+            printf("[Client %s] Starting the communication (send: [%zu - %zu - %zu - %zu - %zu], receive: [%zu - %zu - %zu - %zu - %zu]).\n",
                    client_port.c_str(),
                    send_buffer.buffer_double.size,
                    send_buffer.buffer_uint8_t.size,
                    send_buffer.buffer_uint16_t.size,
+                   send_buffer.buffer_float.size,
+                   send_buffer.buffer_half.size,
                    receive_buffer.buffer_double.size,
                    receive_buffer.buffer_uint8_t.size,
-                   receive_buffer.buffer_uint16_t.size);
+                   receive_buffer.buffer_uint16_t.size,
+                   receive_buffer.buffer_float.size,
+                   receive_buffer.buffer_half.size);
 
             flag = EMultiverseClientState::BindSendData;
             break;
@@ -221,6 +335,11 @@ void MultiverseClient::run()
             break;
 
         case EMultiverseClientState::ReceiveData:
+            if (is_non_blocking && !has_message(client_socket))
+            {
+                return;
+            }
+
             receive_data();
             break;
 
@@ -256,6 +375,10 @@ void MultiverseClient::run()
             free(receive_buffer.buffer_double.data);
             free(receive_buffer.buffer_uint8_t.data);
             free(receive_buffer.buffer_uint16_t.data);
+            free(send_buffer.buffer_float.data);
+            free(send_buffer.buffer_half.data);
+            free(receive_buffer.buffer_float.data);
+            free(receive_buffer.buffer_half.data);
         }
 
         clean_up();
@@ -264,6 +387,31 @@ void MultiverseClient::run()
     }
 }
 
+std::string MultiverseClient::request_history(const std::string &history_request_str)
+{
+    if (should_shut_down || flag.load() != EMultiverseClientState::BindSendData)
+    {
+        return "";
+    }
+
+    zmq_send(client_socket, &history_message_spec, sizeof(int), 2);
+    zmq_send(client_socket, history_request_str.c_str(), history_request_str.size(), 0);
+
+    int message_spec_int;
+    if (zmq_recv(client_socket, &message_spec_int, sizeof(int), 0) == -1 || message_spec_int != history_message_spec)
+    {
+        should_shut_down = true;
+        return "";
+    }
+
+    zmq_msg_t message;
+    zmq_msg_init(&message);
+    zmq_msg_recv(&message, client_socket, 0);
+    const std::string history_response_str(static_cast<char *>(zmq_msg_data(&message)), zmq_msg_size(&message));
+    zmq_msg_close(&message);
+    return history_response_str;
+}
+
 void MultiverseClient::send_and_receive_meta_data()
 {
     flag = EMultiverseClientState::SendRequestMetaData;
@@ -288,42 +436,38 @@ void MultiverseClient::send_request_meta_data()
 
 void MultiverseClient::send_send_data()
 {
-    const int message_spec_int = 2 + (send_buffer.buffer_double.size > 0) + (send_buffer.buffer_uint8_t.size > 0) + (send_buffer.buffer_uint16_t.size > 0);
+    const int buffer_count = get_buffer_count(send_buffer);
+    const bool is_compressed = compression_uint8_t != ECompression::None || compression_uint16_t != ECompression::None;
+    const bool is_delta_frame = is_delta_encoding && !is_compressed && buffer_count > 0 && encode_delta_buffer(send_buffer);
+    if (is_compressed)
+    {
+        compress_buffer(send_buffer, compression_uint8_t, compression_uint16_t);
+    }
+    const int message_spec_int = 2 + buffer_count + (is_delta_frame ? delta_message_spec_offset : 0);
     zmq_send(client_socket, &message_spec_int, sizeof(int), 2);
 
-    if (message_spec_int == 2)
+    // The buffers follow the time in the order double, uint8, uint16, float, half
+    int remaining_count = buffer_count;
+    zmq_send(client_socket, world_time, sizeof(double), remaining_count == 0 ? 0 : 2);
+    if (send_buffer.buffer_double.size > 0)
     {
-        zmq_send(client_socket, world_time, sizeof(double), 0);
+        send_typed_data(client_socket, send_buffer.buffer_double, is_delta_frame, ECompression::None, --remaining_count == 0 ? 0 : 2);
     }
-    else
+    if (send_buffer.buffer_uint8_t.size > 0)
     {
-        zmq_send(client_socket, world_time, sizeof(double), 2);
-        if (send_buffer.buffer_double.size > 0)
-        {
-            if (send_buffer.buffer_uint8_t.size == 0 && send_buffer.buffer_uint16_t.size == 0)
-            {
-                zmq_send(client_socket, send_buffer.buffer_double.data, send_buffer.buffer_double.size * sizeof(double), 0);
-            }
-            else
-            {
-                zmq_send(client_socket, send_buffer.buffer_double.data, send_buffer.buffer_double.size * sizeof(double), 2);
-            }
-        }
-        if (send_buffer.buffer_uint8_t.size > 0)
-        {
-            if (send_buffer.buffer_uint16_t.size == 0)
-            {
-                zmq_send(client_socket, send_buffer.buffer_uint8_t.data, send_buffer.buffer_uint8_t.size * sizeof(uint8_t), 0);
-            }
-            else
-            {
-                zmq_send(client_socket, send_buffer.buffer_uint8_t.data, send_buffer.buffer_uint8_t.size * sizeof(uint8_t), 2);
-            }
-        }
-        if (send_buffer.buffer_uint16_t.size > 0)
-        {
-            zmq_send(client_socket, send_buffer.buffer_uint16_t.data, send_buffer.buffer_uint16_t.size * sizeof(uint16_t), 0);
-        }
+        send_typed_data(client_socket, send_buffer.buffer_uint8_t, is_delta_frame, compression_uint8_t, --remaining_count == 0 ? 0 : 2);
+    }
+    if (send_buffer.buffer_uint16_t.size > 0)
+    {
+        send_typed_data(client_socket, send_buffer.buffer_uint16_t, is_delta_frame, compression_uint16_t, --remaining_count == 0 ? 0 : 2);
+    }
+    if (send_buffer.buffer_float.size > 0)
+    {
+        send_typed_data(client_socket, send_buffer.buffer_float, is_delta_frame, ECompression::None, --remaining_count == 0 ? 0 : 2);
+    }
+    if (send_buffer.buffer_half.size > 0)
+    {
+        send_typed_data(client_socket, send_buffer.buffer_half, is_delta_frame, ECompression::None, --remaining_count == 0 ? 0 : 2);
     }
 }
 
@@ -371,59 +515,35 @@ void MultiverseClient::receive_data()
     else if (message_spec_int >= 2)
     {
         zmq_recv(client_socket, world_time, sizeof(*world_time), 0);
-        if (message_spec_int == 3)
+        const bool is_delta_frame = message_spec_int > 2 + delta_message_spec_offset;
+        if (message_spec_int > 2)
         {
-            if (receive_buffer.buffer_double.size > 0 && receive_buffer.buffer_uint8_t.size == 0 && receive_buffer.buffer_uint16_t.size == 0)
+            if (message_spec_int - (is_delta_frame ? delta_message_spec_offset : 0) != 2 + get_buffer_count(receive_buffer))
             {
-                zmq_recv(client_socket, receive_buffer.buffer_double.data, receive_buffer.buffer_double.size * sizeof(double), 0);
+                throw std::runtime_error("The message type [" + std::to_string(message_spec_int) + "] does not match the receive buffers.");
             }
-            else if (receive_buffer.buffer_double.size == 0 && receive_buffer.buffer_uint8_t.size > 0 && receive_buffer.buffer_uint16_t.size == 0)
-            {
-                zmq_recv(client_socket, receive_buffer.buffer_uint8_t.data, receive_buffer.buffer_uint8_t.size * sizeof(uint8_t), 0);
-            }
-            else if (receive_buffer.buffer_double.size == 0 && receive_buffer.buffer_uint8_t.size == 0 && receive_buffer.buffer_uint16_t.size > 0)
-            {
-                zmq_recv(client_socket, receive_buffer.buffer_uint16_t.data, receive_buffer.buffer_uint16_t.size * sizeof(uint16_t), 0);
-            }
-            else
+
+            if (receive_buffer.buffer_double.size > 0)
             {
-                throw std::runtime_error("The receive buffer is not initialized correctly.");
+                receive_typed_data(client_socket, receive_buffer.buffer_double, is_delta_frame);
             }
-        }
-        else if (message_spec_int == 4)
-        {
-            zmq_recv(client_socket, world_time, sizeof(double), 0);
-            if (receive_buffer.buffer_uint16_t.size == 0)
+            if (receive_buffer.buffer_uint8_t.size > 0)
             {
-                zmq_recv(client_socket, receive_buffer.buffer_double.data, receive_buffer.buffer_double.size * sizeof(double), 0);
-                zmq_recv(client_socket, receive_buffer.buffer_uint8_t.data, receive_buffer.buffer_uint8_t.size * sizeof(uint8_t), 0);
+                receive_typed_data(client_socket, receive_buffer.buffer_uint8_t, is_delta_frame, compression_uint8_t);
             }
-            else if (receive_buffer.buffer_double.size == 0)
+            if (receive_buffer.buffer_uint16_t.size > 0)
             {
-                zmq_recv(client_socket, receive_buffer.buffer_uint8_t.data, receive_buffer.buffer_uint8_t.size * sizeof(uint8_t), 0);
-                zmq_recv(client_socket, receive_buffer.buffer_uint16_t.data, receive_buffer.buffer_uint16_t.size * sizeof(uint16_t), 0);
+                receive_typed_data(client_socket, receive_buffer.buffer_uint16_t, is_delta_frame, compression_uint16_t);
             }
-            else if (receive_buffer.buffer_uint8_t.size == 0)
+            if (receive_buffer.buffer_float.size > 0)
             {
-                zmq_recv(client_socket, receive_buffer.buffer_double.data, receive_buffer.buffer_double.size * sizeof(double), 0);
-                zmq_recv(client_socket, receive_buffer.buffer_uint16_t.data, receive_buffer.buffer_uint16_t.size * sizeof(uint16_t), 0);
+                receive_typed_data(client_socket, receive_buffer.buffer_float, is_delta_frame);
             }
-            else
+            if (receive_buffer.buffer_half.size > 0)
             {
-                throw std::runtime_error("The receive buffer is not initialized correctly.");
+                receive_typed_data(client_socket, receive_buffer.buffer_half, is_delta_frame);
             }
         }
-        else if (message_spec_int == 5)
-        {
-            zmq_recv(client_socket, world_time, sizeof(double), 0);
-            zmq_recv(client_socket, receive_buffer.buffer_double.data, receive_buffer.buffer_double.size * sizeof(double), 0);
-            zmq_recv(client_socket, receive_buffer.buffer_uint8_t.data, receive_buffer.buffer_uint8_t.size * sizeof(uint8_t), 0);
-            zmq_recv(client_socket, receive_buffer.buffer_uint16_t.data, receive_buffer.buffer_uint16_t.size * sizeof(uint16_t), 0);
-        }
-        else if (message_spec_int != 2)
-        {
-            throw std::runtime_error("The message type [" + std::to_string(message_spec_int) + "] is not recognized.");
-        }
     }
     else
     {
@@ -464,36 +584,48 @@ void MultiverseClient::check_response_meta_data()
 bool MultiverseClient::check_buffer_size()
 {
     std::map<std::string, std::map<std::string, size_t>> request_buffer_sizes =
-        {{"send", {{"double", 0}, {"uint8", 0}, {"uint16", 0}}}, {"receive", {{"double", 0}, {"uint8", 0}, {"uint16", 0}}}};
+        {{"send", {{"double", 0}, {"uint8", 0}, {"uint16", 0}, {"float", 0}, {"half", 0}}}, {"receive", {{"double", 0}, {"uint8", 0}, {"uint16", 0}, {"float", 0}, {"half", 0}}}};
     compute_request_buffer_sizes(request_buffer_sizes["send"], request_buffer_sizes["receive"]);
 
     std::map<std::string, std::map<std::string, size_t>> response_buffer_sizes =
-        {{"send", {{"double", 0}, {"uint8", 0}, {"uint16", 0}}}, {"receive", {{"double", 0}, {"uint8", 0}, {"uint16", 0}}}};
+        {{"send", {{"double", 0}, {"uint8", 0}, {"uint16", 0}, {"float", 0}, {"half", 0}}}, {"receive", {{"double", 0}, {"uint8", 0}, {"uint16", 0}, {"float", 0}, {"half", 0}}}};
     compute_response_buffer_sizes(response_buffer_sizes["send"], response_buffer_sizes["receive"]);
 
     if (request_buffer_sizes["receive"]["double"] != -1 && request_buffer_sizes["receive"]["uint8"] != -1 && request_buffer_sizes["receive"]["uint16"] != -1 &&
         (request_buffer_sizes["send"]["double"] != response_buffer_sizes["send"]["double"] ||
          request_buffer_sizes["send"]["uint8"] != response_buffer_sizes["send"]["uint8"] ||
          request_buffer_sizes["send"]["uint16"] != response_buffer_sizes["send"]["uint16"] ||
+         request_buffer_sizes["send"]["float"] != response_buffer_sizes["send"]["float"] ||
+         request_buffer_sizes["send"]["half"] != response_buffer_sizes["send"]["half"] ||
          request_buffer_sizes["receive"]["double"] != response_buffer_sizes["receive"]["double"] ||
          request_buffer_sizes["receive"]["uint8"] != response_buffer_sizes["receive"]["uint8"] ||
-         request_buffer_sizes["receive"]["uint16"] != response_buffer_sizes["receive"]["uint16"]))
+         request_buffer_sizes["receive"]["uint16"] != response_buffer_sizes["receive"]["uint16"] ||
+         request_buffer_sizes["receive"]["float"] != response_buffer_sizes["receive"]["float"] ||
+         request_buffer_sizes["receive"]["half"] != response_buffer_sizes["receive"]["half"]))
     {
-        printf("[Client %s] Failed to initialize the buffers %s: send_buffer_size(server = [%zu - %zu - %zu], client = [%zu - %zu - %zu]), receive_buffer_size(server = [%zu - %zu - %zu], client = [%zu - %zu - %zu]).\n",
+        printf("[Client %s] Failed to initialize the buffers %s: send_buffer_size(server = [%zu - %zu - %zu - %zu - %zu], client = [%zu - %zu - %zu - %zu - %zu]), receive_buffer_size(server = [%zu - %zu - %zu - %zu - %zu], client = [%zu - %zu - %zu - %zu - %zu]).\n",
                client_port.c_str(),
                socket_addr.c_str(),
                request_buffer_sizes["send"]["double"],
                request_buffer_sizes["send"]["uint8"],
                request_buffer_sizes["send"]["uint16"],
+               request_buffer_sizes["send"]["float"],
+               request_buffer_sizes["send"]["half"],
                response_buffer_sizes["send"]["double"],
                response_buffer_sizes["send"]["uint8"],
                response_buffer_sizes["send"]["uint16"],
+               response_buffer_sizes["send"]["float"],
+               response_buffer_sizes["send"]["half"],
                request_buffer_sizes["receive"]["double"],
                request_buffer_sizes["receive"]["uint8"],
                request_buffer_sizes["receive"]["uint16"],
+               request_buffer_sizes["receive"]["float"],
+               request_buffer_sizes["receive"]["half"],
                response_buffer_sizes["receive"]["double"],
                response_buffer_sizes["receive"]["uint8"],
-               response_buffer_sizes["receive"]["uint16"]);
+               response_buffer_sizes["receive"]["uint16"],
+               response_buffer_sizes["receive"]["float"],
+               response_buffer_sizes["receive"]["half"]);
         return false;
     }
 
@@ -503,6 +635,10 @@ bool MultiverseClient::check_buffer_size()
     receive_buffer.buffer_double.size = response_buffer_sizes["receive"]["double"];
     receive_buffer.buffer_uint8_t.size = response_buffer_sizes["receive"]["uint8"];
     receive_buffer.buffer_uint16_t.size = response_buffer_sizes["receive"]["uint16"];
+    send_buffer.buffer_float.size = response_buffer_sizes["send"]["float"];
+    send_buffer.buffer_half.size = response_buffer_sizes["send"]["half"];
+    receive_buffer.buffer_float.size = response_buffer_sizes["receive"]["float"];
+    receive_buffer.buffer_half.size = response_buffer_sizes["receive"]["half"];
     return true;
 }
 
@@ -514,6 +650,17 @@ void MultiverseClient::init_buffer()
     receive_buffer.buffer_double.data = (double *)calloc(receive_buffer.buffer_double.size, sizeof(double));
     receive_buffer.buffer_uint8_t.data = (uint8_t *)calloc(receive_buffer.buffer_uint8_t.size, sizeof(uint8_t));
     receive_buffer.buffer_uint16_t.data = (uint16_t *)calloc(receive_buffer.buffer_uint16_t.size, sizeof(uint16_t));
+    send_buffer.buffer_float.data = (float *)calloc(send_buffer.buffer_float.size, sizeof(float));
+    send_buffer.buffer_half.data = (uint16_t *)calloc(send_buffer.buffer_half.size, sizeof(uint16_t));
+    receive_buffer.buffer_float.data = (float *)calloc(receive_buffer.buffer_float.size, sizeof(float));
+    receive_buffer.buffer_half.data = (uint16_t *)calloc(receive_buffer.buffer_half.size, sizeof(uint16_t));
+
+    // The first frame after the buffers are reallocated is always a full frame
+    send_buffer.buffer_double.last_data.clear();
+    send_buffer.buffer_uint8_t.last_data.clear();
+    send_buffer.buffer_uint16_t.last_data.clear();
+    send_buffer.buffer_float.last_data.clear();
+    send_buffer.buffer_half.last_data.clear();
 }
 
 bool MultiverseClient::communicate(const bool resend_request_meta_data)
@@ -555,6 +702,55 @@ bool MultiverseClient::communicate(const bool resend_request_meta_data)
     return false;
 }
 
+void MultiverseClient::set_non_blocking(const bool in_is_non_blocking)
+{
+    is_non_blocking = in_is_non_blocking;
+}
+
+bool MultiverseClient::poll()
+{
+    const EMultiverseClientState current_flag = flag.load();
+    if (current_flag != EMultiverseClientState::ReceiveResponseMetaData && current_flag != EMultiverseClientState::ReceiveData)
+    {
+        return true;
+    }
+
+    if (!should_shut_down && !has_message(client_socket))
+    {
+        return false;
+    }
+
+    run();
+
+    const EMultiverseClientState next_flag = flag.load();
+    return should_shut_down || (next_flag != EMultiverseClientState::ReceiveResponseMetaData && next_flag != EMultiverseClientState::ReceiveData);
+}
+
+intptr_t MultiverseClient::get_socket_fd() const
+{
+    if (client_socket == nullptr)
+    {
+        return -1;
+    }
+
+#ifdef _WIN32
+    SOCKET fd;
+#else
+    int fd;
+#endif
+    size_t fd_size = sizeof(fd);
+    if (zmq_getsockopt(client_socket, ZMQ_FD, &fd, &fd_size) != 0)
+    {
+        return -1;
+    }
+    return static_cast<intptr_t>(fd);
+}
+
+void MultiverseClient::interrupt()
+{
+    zmq_ctx_shutdown(context);
+}
+
 void MultiverseClient::disconnect()
 {
     should_shut_down = true;
@@ -47,6 +47,37 @@ std::map<std::string, size_t> attribute_map_double = {
     {"force", 3},
     {"torque", 3}};
 
+static std::string get_double_key(const Json::Value &meta_data, const std::string &attribute_name)
+{
+    const Json::Value &precision = meta_data["precision"];
+    const std::string attribute_precision = precision.isObject() ? (precision.isMember(attribute_name) ? precision[attribute_name].asString() : "double") : precision.asString();
+    return attribute_precision == "float" || attribute_precision == "half" ? attribute_precision : "double";
+}
+
+static bool get_tensor_size(const Json::Value &meta_data, const std::string &attribute_name, std::string &dtype, size_t &size)
+{
+    const Json::Value &tensor = meta_data["tensors"][attribute_name];
+    if (!tensor.isObject() || !tensor["shape"].isArray())
+    {
+        return false;
+    }
+    dtype = tensor["dtype"].asString();
+    if (dtype == "uint8" || dtype == "uint16" || dtype == "double")
+    {
+        if (dtype == "double")
+        {
+            dtype = get_double_key(meta_data, attribute_name);
+        }
+        size = 1;
+        for (const Json::Value &dim : tensor["shape"])
+        {
+            size *= dim.asUInt64();
+        }
+        return true;
+    }
+    return false;
+}
+
 bool MultiverseClientJson::compute_request_and_response_meta_data()
 {
     if (!response_meta_data_str.empty() &&
@@ -55,6 +86,14 @@ bool MultiverseClientJson::compute_request_and_response_meta_data()
         response_meta_data_json["time"].asDouble() >= 0)
     {
         request_meta_data_json["meta_data"] = response_meta_data_json["meta_data"];
+        is_delta_encoding = response_meta_data_json["meta_data"].isMember("delta_encoding") && response_meta_data_json["meta_data"]["delta_encoding"].asBool();
+        compression_uint8_t = ECompression::None;
+        compression_uint16_t = ECompression::None;
+        if (response_meta_data_json["meta_data"]["compression"].isObject())
+        {
+            get_compression(response_meta_data_json["meta_data"]["compression"]["rgb"].asString(), compression_uint8_t);
+            get_compression(response_meta_data_json["meta_data"]["compression"]["depth"].asString(), compression_uint16_t);
+        }
         request_meta_data_json["send"].clear();
         request_meta_data_json["receive"].clear();
 
@@ -88,7 +127,7 @@ bool MultiverseClientJson::compute_request_and_response_meta_data()
 void MultiverseClientJson::compute_request_buffer_sizes(std::map<std::string, size_t> &send_buffer_size, std::map<std::string, size_t> &receive_buffer_size) const
 {
     std::map<std::string, std::map<std::string, size_t>> request_buffer_sizes =
-        {{"send", {{"double", 0}, {"uint8", 0}, {"uint16", 0}}}, {"receive", {{"double", 0}, {"uint8", 0}, {"uint16", 0}}}};
+        {{"send", {{"double", 0}, {"uint8", 0}, {"uint16", 0}, {"float", 0}, {"half", 0}}}, {"receive", {{"double", 0}, {"uint8", 0}, {"uint16", 0}, {"float", 0}, {"half", 0}}}};
     for (std::pair<const std::string, std::map<std::string, size_t>> &request_buffer_size : request_buffer_sizes)
     {
         for (const std::string &object_name : request_meta_data_json[request_buffer_size.first].getMemberNames())
@@ -109,9 +148,15 @@ void MultiverseClientJson::compute_request_buffer_sizes(std::map<std::string, si
                     request_buffer_size.second["uint16"] = -1;
                     break;
                 }
-                if (attribute_map_double.find(attribute.asString()) != attribute_map_double.end())
+                std::string dtype;
+                size_t size;
+                if (get_tensor_size(request_meta_data_json["meta_data"], attribute.asString(), dtype, size))
+                {
+                    request_buffer_size.second[dtype] += size;
+                }
+                else if (attribute_map_double.find(attribute.asString()) != attribute_map_double.end())
                 {
-                    request_buffer_size.second["double"] += attribute_map_double[attribute.asString()];
+                    request_buffer_size.second[get_double_key(request_meta_data_json["meta_data"], attribute.asString())] += attribute_map_double[attribute.asString()];
                 }
             }
         }
@@ -124,16 +169,22 @@ void MultiverseClientJson::compute_request_buffer_sizes(std::map<std::string, si
 void MultiverseClientJson::compute_response_buffer_sizes(std::map<std::string, size_t> &send_buffer_size, std::map<std::string, size_t> &receive_buffer_size) const
 {
     std::map<std::string, std::map<std::string, size_t>> response_buffer_sizes =
-        {{"send", {{"double", 0}, {"uint8", 0}, {"uint16", 0}}}, {"receive", {{"double", 0}, {"uint8", 0}, {"uint16", 0}}}};
+        {{"send", {{"double", 0}, {"uint8", 0}, {"uint16", 0}, {"float", 0}, {"half", 0}}}, {"receive", {{"double", 0}, {"uint8", 0}, {"uint16", 0}, {"float", 0}, {"half", 0}}}};
     for (std::pair<const std::string, std::map<std::string, size_t>> &response_buffer_size : response_buffer_sizes)
     {
         for (const std::string &object_name : response_meta_data_json[response_buffer_size.first].getMemberNames())
         {
             for (const std::string &attribute_name : response_meta_data_json[response_buffer_size.first][object_name].getMemberNames())
             {
-                if (attribute_map_double.find(attribute_name) != attribute_map_double.end())
+                std::string dtype;
+                size_t size;
+                if (get_tensor_size(request_meta_data_json["meta_data"], attribute_name, dtype, size))
+                {
+                    response_buffer_size.second[dtype] += response_meta_data_json[response_buffer_size.first][object_name][attribute_name].size();
+                }
+                else if (attribute_map_double.find(attribute_name) != attribute_map_double.end())
                 {
-                    response_buffer_size.second["double"] += response_meta_data_json[response_buffer_size.first][object_name][attribute_name].size();
+                    response_buffer_size.second[get_double_key(request_meta_data_json["meta_data"], attribute_name)] += response_meta_data_json[response_buffer_size.first][object_name][attribute_name].size();
                 }
             }
         }
@@ -21,7 +21,10 @@
 #include "multiverse_client.h"
 
 #include <algorithm>
+#include <cstring>
+#include <memory>
 #include <pybind11/chrono.h>
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 #include <pybind11/functional.h>
@@ -82,8 +85,9 @@ public:
     inline void set_request_meta_data(const pybind11::dict &in_request_meta_data_dict)
     {
         request_meta_data_dict = in_request_meta_data_dict;
+        world_name = request_meta_data_dict.contains("meta_data") && request_meta_data_dict["meta_data"].cast<pybind11::dict>().contains("world_name") ? request_meta_data_dict["meta_data"]["world_name"].cast<std::string>() : "";
         std::map<std::string, std::map<std::string, size_t>> request_buffer_sizes =
-            {{"send", {{"double", 0}, {"uint8", 0}, {"uint16", 0}}}, {"receive", {{"double", 0}, {"uint8", 0}, {"uint16", 0}}}};
+            {{"send", {{"double", 0}, {"uint8", 0}, {"uint16", 0}, {"float", 0}, {"half", 0}}}, {"receive", {{"double", 0}, {"uint8", 0}, {"uint16", 0}, {"float", 0}, {"half", 0}}}};
         compute_request_buffer_sizes(request_buffer_sizes["send"], request_buffer_sizes["receive"]);
 
         send_buffer.buffer_double.size = request_buffer_sizes["send"]["double"];
@@ -92,6 +96,10 @@ public:
         receive_buffer.buffer_double.size = request_buffer_sizes["receive"]["double"];
         receive_buffer.buffer_uint8_t.size = request_buffer_sizes["receive"]["uint8"];
         receive_buffer.buffer_uint16_t.size = request_buffer_sizes["receive"]["uint16"];
+        send_buffer.buffer_float.size = request_buffer_sizes["send"]["float"];
+        send_buffer.buffer_half.size = request_buffer_sizes["send"]["half"];
+        receive_buffer.buffer_float.size = request_buffer_sizes["receive"]["float"];
+        receive_buffer.buffer_half.size = request_buffer_sizes["receive"]["half"];
     }
 
     inline pybind11::dict get_response_meta_data()
@@ -101,28 +109,42 @@ public:
 
     inline void set_send_data(const pybind11::list &in_send_data)
     {
-        if (in_send_data.size() != 1 + send_buffer.buffer_double.size + send_buffer.buffer_uint8_t.size + send_buffer.buffer_uint16_t.size)
+        const size_t send_buffer_size = 1 + send_buffer.buffer_double.size + send_buffer.buffer_uint8_t.size + send_buffer.buffer_uint16_t.size + send_buffer.buffer_float.size + send_buffer.buffer_half.size;
+        if (in_send_data.size() != send_buffer_size)
         {
-            printf("[Client %s] The size of in_send_data (%zu) does not match with send_buffer_size (%zu).\n", client_port.c_str(), in_send_data.size(), 1 + send_buffer.buffer_double.size + send_buffer.buffer_uint8_t.size + send_buffer.buffer_uint16_t.size);
+            printf("[Client %s] The size of in_send_data (%zu) does not match with send_buffer_size (%zu).\n", client_port.c_str(), in_send_data.size(), send_buffer_size);
         }
         else
         {
             send_data_double.resize(send_buffer.buffer_double.size);
             send_data_uint8_t.resize(send_buffer.buffer_uint8_t.size);
             send_data_uint16_t.resize(send_buffer.buffer_uint16_t.size);
+            send_data_float.resize(send_buffer.buffer_float.size);
+            send_data_half.resize(send_buffer.buffer_half.size);
 
             try
             {
-                world_time = new double(in_send_data[0].cast<double>());
-                std::transform(in_send_data.begin() + 1, in_send_data.begin() + 1 + send_buffer.buffer_double.size, send_data_double.begin(),
+                *world_time = in_send_data[0].cast<double>();
+                pybind11::detail::list_iterator send_data_it = in_send_data.begin() + 1;
+                std::transform(send_data_it, send_data_it + send_buffer.buffer_double.size, send_data_double.begin(),
                                [](const pybind11::handle &item)
                                { return item.cast<double>(); });
-                std::transform(in_send_data.begin() + 1 + send_buffer.buffer_double.size, in_send_data.begin() + 1 + send_buffer.buffer_double.size + send_buffer.buffer_uint8_t.size, send_data_uint8_t.begin(),
+                send_data_it += send_buffer.buffer_double.size;
+                std::transform(send_data_it, send_data_it + send_buffer.buffer_uint8_t.size, send_data_uint8_t.begin(),
                                [](const pybind11::handle &item)
                                { return item.cast<uint8_t>(); });
-                std::transform(in_send_data.begin() + 1 + send_buffer.buffer_double.size + send_buffer.buffer_uint8_t.size, in_send_data.end(), send_data_uint16_t.begin(),
+                send_data_it += send_buffer.buffer_uint8_t.size;
+                std::transform(send_data_it, send_data_it + send_buffer.buffer_uint16_t.size, send_data_uint16_t.begin(),
                                [](const pybind11::handle &item)
                                { return item.cast<uint16_t>(); });
+                send_data_it += send_buffer.buffer_uint16_t.size;
+                std::transform(send_data_it, send_data_it + send_buffer.buffer_float.size, send_data_float.begin(),
+                               [](const pybind11::handle &item)
+                               { return item.cast<float>(); });
+                send_data_it += send_buffer.buffer_float.size;
+                std::transform(send_data_it, in_send_data.end(), send_data_half.begin(),
+                               [](const pybind11::handle &item)
+                               { return item.cast<float>(); });
             }
             catch (const std::exception &e)
             {
@@ -132,9 +154,122 @@ public:
         }
     }
 
+    inline void set_send_data(const pybind11::array_t<double, pybind11::array::c_style | pybind11::array::forcecast> &in_send_data)
+    {
+        const size_t send_buffer_size = 1 + send_buffer.buffer_double.size + send_buffer.buffer_uint8_t.size + send_buffer.buffer_uint16_t.size + send_buffer.buffer_float.size + send_buffer.buffer_half.size;
+        if (static_cast<size_t>(in_send_data.size()) != send_buffer_size)
+        {
+            printf("[Client %s] The size of in_send_data (%zu) does not match with send_buffer_size (%zu).\n", client_port.c_str(), static_cast<size_t>(in_send_data.size()), send_buffer_size);
+            return;
+        }
+
+        send_data_double.resize(send_buffer.buffer_double.size);
+        send_data_uint8_t.resize(send_buffer.buffer_uint8_t.size);
+        send_data_uint16_t.resize(send_buffer.buffer_uint16_t.size);
+        send_data_float.resize(send_buffer.buffer_float.size);
+        send_data_half.resize(send_buffer.buffer_half.size);
+
+        // The array has the same layout as the list, the values are converted without going through python objects
+        const double *send_data_it = in_send_data.data();
+        *world_time = *send_data_it++;
+        memcpy(send_data_double.data(), send_data_it, send_data_double.size() * sizeof(double));
+        send_data_it += send_data_double.size();
+        std::copy(send_data_it, send_data_it + send_data_uint8_t.size(), send_data_uint8_t.begin());
+        send_data_it += send_data_uint8_t.size();
+        std::copy(send_data_it, send_data_it + send_data_uint16_t.size(), send_data_uint16_t.begin());
+        send_data_it += send_data_uint16_t.size();
+        std::copy(send_data_it, send_data_it + send_data_float.size(), send_data_float.begin());
+        send_data_it += send_data_float.size();
+        std::copy(send_data_it, send_data_it + send_data_half.size(), send_data_half.begin());
+    }
+
+    inline void set_send_data(const double in_world_time,
+                              const pybind11::array_t<double, pybind11::array::c_style | pybind11::array::forcecast> &in_send_data_double,
+                              const pybind11::array_t<uint8_t, pybind11::array::c_style | pybind11::array::forcecast> &in_send_data_uint8_t,
+                              const pybind11::array_t<uint16_t, pybind11::array::c_style | pybind11::array::forcecast> &in_send_data_uint16_t,
+                              const pybind11::array_t<float, pybind11::array::c_style | pybind11::array::forcecast> &in_send_data_float,
+                              const pybind11::array_t<float, pybind11::array::c_style | pybind11::array::forcecast> &in_send_data_half)
+    {
+        if (static_cast<size_t>(in_send_data_double.size()) != send_buffer.buffer_double.size ||
+            static_cast<size_t>(in_send_data_uint8_t.size()) != send_buffer.buffer_uint8_t.size ||
+            static_cast<size_t>(in_send_data_uint16_t.size()) != send_buffer.buffer_uint16_t.size ||
+            static_cast<size_t>(in_send_data_float.size()) != send_buffer.buffer_float.size ||
+            static_cast<size_t>(in_send_data_half.size()) != send_buffer.buffer_half.size)
+        {
+            printf("[Client %s] The size of in_send_data [%zu - %zu - %zu - %zu - %zu] does not match with send_buffer_size [%zu - %zu - %zu - %zu - %zu].\n",
+                   client_port.c_str(),
+                   static_cast<size_t>(in_send_data_double.size()),
+                   static_cast<size_t>(in_send_data_uint8_t.size()),
+                   static_cast<size_t>(in_send_data_uint16_t.size()),
+                   static_cast<size_t>(in_send_data_float.size()),
+                   static_cast<size_t>(in_send_data_half.size()),
+                   send_buffer.buffer_double.size,
+                   send_buffer.buffer_uint8_t.size,
+                   send_buffer.buffer_uint16_t.size,
+                   send_buffer.buffer_float.size,
+                   send_buffer.buffer_half.size);
+            return;
+        }
+
+        send_data_double.resize(send_buffer.buffer_double.size);
+        send_data_uint8_t.resize(send_buffer.buffer_uint8_t.size);
+        send_data_uint16_t.resize(send_buffer.buffer_uint16_t.size);
+        send_data_float.resize(send_buffer.buffer_float.size);
+        send_data_half.resize(send_buffer.buffer_half.size);
+
+        // One array or memoryview per buffer type, each is copied with a single memcpy
+        *world_time = in_world_time;
+        memcpy(send_data_double.data(), in_send_data_double.data(), send_data_double.size() * sizeof(double));
+        memcpy(send_data_uint8_t.data(), in_send_data_uint8_t.data(), send_data_uint8_t.size() * sizeof(uint8_t));
+        memcpy(send_data_uint16_t.data(), in_send_data_uint16_t.data(), send_data_uint16_t.size() * sizeof(uint16_t));
+        memcpy(send_data_float.data(), in_send_data_float.data(), send_data_float.size() * sizeof(float));
+        memcpy(send_data_half.data(), in_send_data_half.data(), send_data_half.size() * sizeof(float));
+    }
+
     inline pybind11::list get_receive_data() const
     {
-        return pybind11::cast(std::vector<double>({*world_time})) + pybind11::cast(receive_data_double) + pybind11::cast(receive_data_uint8_t) + pybind11::cast(receive_data_uint16_t);
+        return pybind11::cast(std::vector<double>({*world_time})) + pybind11::cast(*receive_data_double) + pybind11::cast(*receive_data_uint8_t) + pybind11::cast(*receive_data_uint16_t) + pybind11::cast(*receive_data_float) + pybind11::cast(*receive_data_half);
+    }
+
+    template <class T>
+    inline pybind11::array_t<T> get_receive_data_array(const std::shared_ptr<std::vector<T>> &receive_data)
+    {
+        // The array views the receive data without copying and shares its ownership, so it stays valid when
+        // a new handshake reallocates the receive data. It is refilled by the next communicate, or the one
+        // after if the receive data is double buffered
+        pybind11::capsule owner(new std::shared_ptr<std::vector<T>>(receive_data), [](void *receive_data_ptr)
+                                { delete static_cast<std::shared_ptr<std::vector<T>> *>(receive_data_ptr); });
+        return pybind11::array_t<T>(receive_data->size(), receive_data->data(), owner);
+    }
+
+    inline pybind11::array_t<double> get_receive_data_double()
+    {
+        return get_receive_data_array(receive_data_double);
+    }
+
+    inline pybind11::array_t<uint8_t> get_receive_data_uint8()
+    {
+        return get_receive_data_array(receive_data_uint8_t);
+    }
+
+    inline pybind11::array_t<uint16_t> get_receive_data_uint16()
+    {
+        return get_receive_data_array(receive_data_uint16_t);
+    }
+
+    inline pybind11::array_t<float> get_receive_data_float()
+    {
+        return get_receive_data_array(receive_data_float);
+    }
+
+    inline pybind11::array_t<float> get_receive_data_half()
+    {
+        return get_receive_data_array(receive_data_half);
+    }
+
+    inline void set_receive_data_double_buffered(const bool in_is_receive_data_double_buffered)
+    {
+        is_receive_data_double_buffered = in_is_receive_data_double_buffered;
     }
 
     inline void set_api_callbacks(const std::map<std::string, std::function<void (pybind11::list)>> &in_api_callbacks)
@@ -177,17 +312,39 @@ private:
 
     pybind11::dict response_meta_data_dict;
 
+    std::string world_name;
+
     std::vector<double> send_data_double;
 
     std::vector<uint8_t> send_data_uint8_t;
 
     std::vector<uint16_t> send_data_uint16_t;
 
-    std::vector<double> receive_data_double;
+    std::vector<float> send_data_float;
+
+    std::vector<float> send_data_half;
 
-    std::vector<uint8_t> receive_data_uint8_t;
+    std::shared_ptr<std::vector<double>> receive_data_double = std::make_shared<std::vector<double>>();
 
-    std::vector<uint16_t> receive_data_uint16_t;
+    std::shared_ptr<std::vector<uint8_t>> receive_data_uint8_t = std::make_shared<std::vector<uint8_t>>();
+
+    std::shared_ptr<std::vector<uint16_t>> receive_data_uint16_t = std::make_shared<std::vector<uint16_t>>();
+
+    std::shared_ptr<std::vector<float>> receive_data_float = std::make_shared<std::vector<float>>();
+
+    std::shared_ptr<std::vector<float>> receive_data_half = std::make_shared<std::vector<float>>();
+
+    bool is_receive_data_double_buffered = false;
+
+    std::shared_ptr<std::vector<double>> back_receive_data_double = std::make_shared<std::vector<double>>();
+
+    std::shared_ptr<std::vector<uint8_t>> back_receive_data_uint8_t = std::make_shared<std::vector<uint8_t>>();
+
+    std::shared_ptr<std::vector<uint16_t>> back_receive_data_uint16_t = std::make_shared<std::vector<uint16_t>>();
+
+    std::shared_ptr<std::vector<float>> back_receive_data_float = std::make_shared<std::vector<float>>();
+
+    std::shared_ptr<std::vector<float>> back_receive_data_half = std::make_shared<std::vector<float>>();
 
     std::function<void ()> bind_request_meta_data_callback = []() {};
 
@@ -206,6 +363,8 @@ private:
 private:
     bool compute_request_and_response_meta_data() override
     {
+        // The client calls back from communicate with the GIL released, take it only to touch python objects
+        pybind11::gil_scoped_acquire acquire;
         if (response_meta_data_str.empty())
         {
             response_meta_data_dict = pybind11::dict();
@@ -223,6 +382,22 @@ private:
         if (response_meta_data_dict.contains("time"))
         {
             request_meta_data_dict["meta_data"] = response_meta_data_dict["meta_data"];
+            const pybind11::dict meta_data = response_meta_data_dict["meta_data"].cast<pybind11::dict>();
+            is_delta_encoding = meta_data.contains("delta_encoding") && meta_data["delta_encoding"].cast<bool>();
+            compression_uint8_t = ECompression::None;
+            compression_uint16_t = ECompression::None;
+            if (meta_data.contains("compression"))
+            {
+                const pybind11::dict compression = meta_data["compression"].cast<pybind11::dict>();
+                if (compression.contains("rgb"))
+                {
+                    get_compression(compression["rgb"].cast<std::string>(), compression_uint8_t);
+                }
+                if (compression.contains("depth"))
+                {
+                    get_compression(compression["depth"].cast<std::string>(), compression_uint16_t);
+                }
+            }
             request_meta_data_dict["send"] = pybind11::dict();
             request_meta_data_dict["receive"] = pybind11::dict();
 
@@ -258,10 +433,62 @@ private:
         return false;
     }
 
+    std::string get_double_key(const std::string &attribute_name) const
+    {
+        if (!request_meta_data_dict.contains("meta_data") || !request_meta_data_dict["meta_data"].cast<pybind11::dict>().contains("precision"))
+        {
+            return "double";
+        }
+        const pybind11::object precision = request_meta_data_dict["meta_data"]["precision"];
+        std::string attribute_precision = "double";
+        if (pybind11::isinstance<pybind11::dict>(precision))
+        {
+            if (precision.cast<pybind11::dict>().contains(attribute_name))
+            {
+                attribute_precision = precision[attribute_name.c_str()].cast<std::string>();
+            }
+        }
+        else
+        {
+            attribute_precision = precision.cast<std::string>();
+        }
+        return attribute_precision == "float" || attribute_precision == "half" ? attribute_precision : "double";
+    }
+
+    bool get_tensor_size(const std::string &attribute_name, std::string &dtype, size_t &size) const
+    {
+        if (!request_meta_data_dict.contains("meta_data"))
+        {
+            return false;
+        }
+        const pybind11::dict meta_data = request_meta_data_dict["meta_data"].cast<pybind11::dict>();
+        if (!meta_data.contains("tensors") || !meta_data["tensors"].cast<pybind11::dict>().contains(attribute_name))
+        {
+            return false;
+        }
+        const pybind11::dict tensor = meta_data["tensors"][attribute_name.c_str()].cast<pybind11::dict>();
+        dtype = tensor["dtype"].cast<std::string>();
+        if (dtype != "uint8" && dtype != "uint16" && dtype != "double")
+        {
+            return false;
+        }
+        if (dtype == "double")
+        {
+            dtype = get_double_key(attribute_name);
+        }
+        size = 1;
+        for (const auto &dim : tensor["shape"].cast<pybind11::list>())
+        {
+            size *= dim.cast<size_t>();
+        }
+        return true;
+    }
+
     void compute_request_buffer_sizes(std::map<std::string, size_t> &req_send_buffer_size, std::map<std::string, size_t> &req_receive_buffer_size) const override
     {
+        pybind11::gil_scoped_acquire acquire;
         std::map<std::string, std::map<std::string, size_t>> request_buffer_sizes =
-            {{"send", {{"double", 0}, {"uint8", 0}, {"uint16", 0}}}, {"receive", {{"double", 0}, {"uint8", 0}, {"uint16", 0}}}};
+            {{"send", {{"double", 0}, {"uint8", 0}, {"uint16", 0}, {"float", 0}, {"half", 0}}}, {"receive", {{"double", 0}, {"uint8", 0}, {"uint16", 0}, {"float", 0}, {"half", 0}}}};
 
         for (std::pair<const std::string, std::map<std::string, size_t>> &request_buffer_size : request_buffer_sizes)
         {
@@ -291,9 +518,16 @@ private:
                         request_buffer_size.second["uint16"] = -1;
                         break;
                     }
+                    std::string dtype;
+                    size_t size;
+                    if (get_tensor_size(attributes[i].cast<std::string>(), dtype, size))
+                    {
+                        request_buffer_size.second[dtype] += size;
+                        continue;
+                    }
                     if (attribute_map_double.find(attributes[i].cast<std::string>()) != attribute_map_double.end())
                     {
-                        request_buffer_size.second["double"] += attribute_map_double[attributes[i].cast<std::string>()];
+                        request_buffer_size.second[get_double_key(attributes[i].cast<std::string>())] += attribute_map_double[attributes[i].cast<std::string>()];
                     }
                     if (attribute_map_uint8_t.find(attributes[i].cast<std::string>()) != attribute_map_uint8_t.end())
                     {
@@ -313,8 +547,9 @@ private:
 
     void compute_response_buffer_sizes(std::map<std::string, size_t> &res_send_buffer_size, std::map<std::string, size_t> &res_receive_buffer_size) const override
     {
+        pybind11::gil_scoped_acquire acquire;
         std::map<std::string, std::map<std::string, size_t>> response_buffer_sizes =
-            {{"send", {{"double", 0}, {"uint8", 0}, {"uint16", 0}}}, {"receive", {{"double", 0}, {"uint8", 0}, {"uint16", 0}}}};
+            {{"send", {{"double", 0}, {"uint8", 0}, {"uint16", 0}, {"float", 0}, {"half", 0}}}, {"receive", {{"double", 0}, {"uint8", 0}, {"uint16", 0}, {"float", 0}, {"half", 0}}}};
 
         for (std::pair<const std::string, std::map<std::string, size_t>> &response_buffer_size : response_buffer_sizes)
         {
@@ -328,9 +563,16 @@ private:
                 const pybind11::dict attributes = receive_objects.second.cast<pybind11::dict>();
                 for (const auto &attribute : attributes)
                 {
+                    std::string dtype;
+                    size_t size;
+                    if (get_tensor_size(attribute.first.cast<std::string>(), dtype, size))
+                    {
+                        response_buffer_size.second[dtype] += attribute.second.cast<pybind11::list>().size();
+                        continue;
+                    }
                     if (attribute_map_double.find(attribute.first.cast<std::string>()) != attribute_map_double.end())
                     {
-                        response_buffer_size.second["double"] += attribute.second.cast<pybind11::list>().size();
+                        response_buffer_size.second[get_double_key(attribute.first.cast<std::string>())] += attribute.second.cast<pybind11::list>().size();
                     }
                     if (attribute_map_uint8_t.find(attribute.first.cast<std::string>()) != attribute_map_uint8_t.end())
                     {
@@ -368,6 +610,7 @@ private:
 
     bool init_objects(bool from_request_meta_data = false) override
     {
+        pybind11::gil_scoped_acquire acquire;
         if (from_request_meta_data)
         {
             bind_request_meta_data();
@@ -378,18 +621,27 @@ private:
 
     void bind_request_meta_data() override
     {
+        pybind11::gil_scoped_acquire acquire;
         bind_request_meta_data_callback();
         request_meta_data_str = pybind11::str(request_meta_data_dict).cast<std::string>();
         std::replace(request_meta_data_str.begin(), request_meta_data_str.end(), '\'', '"');
     }
 
+    std::string get_world_name() const override
+    {
+        // Cached in set_request_meta_data, the connect thread must not touch the python objects
+        return world_name;
+    }
+
     void bind_response_meta_data() override
     {
+        pybind11::gil_scoped_acquire acquire;
         bind_response_meta_data_callback();
     }
 
     void bind_api_callbacks() override
     {
+        pybind11::gil_scoped_acquire acquire;
         if (!response_meta_data_dict.contains("api_callbacks"))
         {
             return;
@@ -413,6 +665,7 @@ private:
 
     void bind_api_callbacks_response() override
     {
+        pybind11::gil_scoped_acquire acquire;
         if (!response_meta_data_dict.contains("api_callbacks"))
         {
             return;
@@ -469,61 +722,122 @@ private:
         {
             send_data_uint16_t = std::vector<uint16_t>(send_buffer.buffer_uint16_t.size, 0);
         }
-        if (receive_buffer.buffer_double.size != receive_data_double.size())
+        if (receive_buffer.buffer_double.size != receive_data_double->size())
+        {
+            receive_data_double = std::make_shared<std::vector<double>>(receive_buffer.buffer_double.size, 0.0);
+        }
+        if (receive_buffer.buffer_uint8_t.size != receive_data_uint8_t->size())
         {
-            receive_data_double = std::vector<double>(receive_buffer.buffer_double.size, 0.0);
+            receive_data_uint8_t = std::make_shared<std::vector<uint8_t>>(receive_buffer.buffer_uint8_t.size, 0);
         }
-        if (receive_buffer.buffer_uint8_t.size != receive_data_uint8_t.size())
+        if (receive_buffer.buffer_uint16_t.size != receive_data_uint16_t->size())
         {
-            receive_data_uint8_t = std::vector<uint8_t>(receive_buffer.buffer_uint8_t.size, 0);
+            receive_data_uint16_t = std::make_shared<std::vector<uint16_t>>(receive_buffer.buffer_uint16_t.size, 0);
         }
-        if (receive_buffer.buffer_uint16_t.size != receive_data_uint16_t.size())
+        if (send_buffer.buffer_float.size != send_data_float.size())
         {
-            receive_data_uint16_t = std::vector<uint16_t>(receive_buffer.buffer_uint16_t.size, 0);
+            send_data_float = std::vector<float>(send_buffer.buffer_float.size, 0.0f);
+        }
+        if (send_buffer.buffer_half.size != send_data_half.size())
+        {
+            send_data_half = std::vector<float>(send_buffer.buffer_half.size, 0.0f);
+        }
+        if (receive_buffer.buffer_float.size != receive_data_float->size())
+        {
+            receive_data_float = std::make_shared<std::vector<float>>(receive_buffer.buffer_float.size, 0.0f);
+        }
+        if (receive_buffer.buffer_half.size != receive_data_half->size())
+        {
+            receive_data_half = std::make_shared<std::vector<float>>(receive_buffer.buffer_half.size, 0.0f);
         }
     }
 
     void bind_send_data() override
     {
-        bind_send_data_callback();
-        if (send_data_double.size() != send_buffer.buffer_double.size || send_data_uint8_t.size() != send_buffer.buffer_uint8_t.size)
         {
-            printf("[Client %s] The size of in_send_data [%zu - %zu - %zu] does not match with send_buffer_size [%zu - %zu - %zu].\n",
+            pybind11::gil_scoped_acquire acquire;
+            bind_send_data_callback();
+        }
+        if (send_data_double.size() != send_buffer.buffer_double.size || send_data_uint8_t.size() != send_buffer.buffer_uint8_t.size ||
+            send_data_uint16_t.size() != send_buffer.buffer_uint16_t.size ||
+            send_data_float.size() != send_buffer.buffer_float.size || send_data_half.size() != send_buffer.buffer_half.size)
+        {
+            printf("[Client %s] The size of in_send_data [%zu - %zu - %zu - %zu - %zu] does not match with send_buffer_size [%zu - %zu - %zu - %zu - %zu].\n",
                    client_port.c_str(),
                    send_data_double.size(),
                    send_data_uint8_t.size(),
                    send_data_uint16_t.size(),
+                   send_data_float.size(),
+                   send_data_half.size(),
                    send_buffer.buffer_double.size,
                    send_buffer.buffer_uint8_t.size,
-                   send_buffer.buffer_uint16_t.size);
+                   send_buffer.buffer_uint16_t.size,
+                   send_buffer.buffer_float.size,
+                   send_buffer.buffer_half.size);
             return;
         }
 
         std::copy(send_data_double.begin(), send_data_double.end(), send_buffer.buffer_double.data);
         std::copy(send_data_uint8_t.begin(), send_data_uint8_t.end(), send_buffer.buffer_uint8_t.data);
         std::copy(send_data_uint16_t.begin(), send_data_uint16_t.end(), send_buffer.buffer_uint16_t.data);
+        std::copy(send_data_float.begin(), send_data_float.end(), send_buffer.buffer_float.data);
+        std::transform(send_data_half.begin(), send_data_half.end(), send_buffer.buffer_half.data, float_to_half);
+    }
+
+    template <class T>
+    static void replace_back_receive_data(std::shared_ptr<std::vector<T>> &back_receive_data, const size_t size)
+    {
+        if (back_receive_data->size() != size)
+        {
+            back_receive_data = std::make_shared<std::vector<T>>(size);
+        }
     }
 
     void bind_receive_data() override
     {
-        if (receive_data_double.size() != receive_buffer.buffer_double.size ||
-            receive_data_uint8_t.size() != receive_buffer.buffer_uint8_t.size ||
-            receive_data_uint16_t.size() != receive_buffer.buffer_uint16_t.size)
+        if (receive_data_double->size() != receive_buffer.buffer_double.size ||
+            receive_data_uint8_t->size() != receive_buffer.buffer_uint8_t.size ||
+            receive_data_uint16_t->size() != receive_buffer.buffer_uint16_t.size ||
+            receive_data_float->size() != receive_buffer.buffer_float.size ||
+            receive_data_half->size() != receive_buffer.buffer_half.size)
         {
-            printf("[Client %s] The size of receive_data [%zu - %zu - %zu] does not match with receive_buffer_size [%zu - %zu - %zu].\n",
+            printf("[Client %s] The size of receive_data [%zu - %zu - %zu - %zu - %zu] does not match with receive_buffer_size [%zu - %zu - %zu - %zu - %zu].\n",
                    client_port.c_str(),
-                   receive_data_double.size(),
-                   receive_data_uint8_t.size(),
-                   receive_data_uint16_t.size(),
+                   receive_data_double->size(),
+                   receive_data_uint8_t->size(),
+                   receive_data_uint16_t->size(),
+                   receive_data_float->size(),
+                   receive_data_half->size(),
                    receive_buffer.buffer_double.size,
                    receive_buffer.buffer_uint8_t.size,
-                   receive_buffer.buffer_uint16_t.size);
+                   receive_buffer.buffer_uint16_t.size,
+                   receive_buffer.buffer_float.size,
+                   receive_buffer.buffer_half.size);
             return;
         }
 
-        std::copy(receive_buffer.buffer_double.data, receive_buffer.buffer_double.data + receive_buffer.buffer_double.size, receive_data_double.begin());
-        std::copy(receive_buffer.buffer_uint8_t.data, receive_buffer.buffer_uint8_t.data + receive_buffer.buffer_uint8_t.size, receive_data_uint8_t.begin());
-        std::copy(receive_buffer.buffer_uint16_t.data, receive_buffer.buffer_uint16_t.data + receive_buffer.buffer_uint16_t.size, receive_data_uint16_t.begin());
+        if (is_receive_data_double_buffered)
+        {
+            // Fill the back data and swap, so the arrays of the last step are not overwritten while they are read.
+            // The back data is replaced instead of resized, the arrays of older steps may still own it
+            replace_back_receive_data(back_receive_data_double, receive_data_double->size());
+            replace_back_receive_data(back_receive_data_uint8_t, receive_data_uint8_t->size());
+            replace_back_receive_data(back_receive_data_uint16_t, receive_data_uint16_t->size());
+            replace_back_receive_data(back_receive_data_float, receive_data_float->size());
+            replace_back_receive_data(back_receive_data_half, receive_data_half->size());
+            receive_data_double.swap(back_receive_data_double);
+            receive_data_uint8_t.swap(back_receive_data_uint8_t);
+            receive_data_uint16_t.swap(back_receive_data_uint16_t);
+            receive_data_float.swap(back_receive_data_float);
+            receive_data_half.swap(back_receive_data_half);
+        }
+
+        std::copy(receive_buffer.buffer_double.data, receive_buffer.buffer_double.data + receive_buffer.buffer_double.size, receive_data_double->begin());
+        std::copy(receive_buffer.buffer_uint8_t.data, receive_buffer.buffer_uint8_t.data + receive_buffer.buffer_uint8_t.size, receive_data_uint8_t->begin());
+        std::copy(receive_buffer.buffer_uint16_t.data, receive_buffer.buffer_uint16_t.data + receive_buffer.buffer_uint16_t.size, receive_data_uint16_t->begin());
+        std::copy(receive_buffer.buffer_float.data, receive_buffer.buffer_float.data + receive_buffer.buffer_float.size, receive_data_float->begin());
+        std::transform(receive_buffer.buffer_half.data, receive_buffer.buffer_half.data + receive_buffer.buffer_half.size, receive_data_half->begin(), half_to_float);
+        pybind11::gil_scoped_acquire acquire;
         bind_receive_data_callback();
     }
 };
@@ -533,10 +847,14 @@ PYBIND11_MODULE(multiverse_client_pybind, handle)
     handle.doc() = "";
 
     pybind11::class_<MultiverseClient>(handle, "MultiverseClient")
-        .def("connect", static_cast<void (MultiverseClient::*)(const std::string &, const std::string &, const std::string &)>(&MultiverseClient::connect))
-        .def("start", &MultiverseClient::start)
-        .def("communicate", &MultiverseClient::communicate)
-        .def("disconnect", &MultiverseClient::disconnect)
+        .def("connect", static_cast<void (MultiverseClient::*)(const std::string &, const std::string &, const std::string &)>(&MultiverseClient::connect), pybind11::call_guard<pybind11::gil_scoped_release>())
+        .def("start", &MultiverseClient::start, pybind11::call_guard<pybind11::gil_scoped_release>())
+        .def("communicate", &MultiverseClient::communicate, pybind11::call_guard<pybind11::gil_scoped_release>())
+        .def("disconnect", &MultiverseClient::disconnect, pybind11::call_guard<pybind11::gil_scoped_release>())
+        .def("request_history", &MultiverseClient::request_history, pybind11::call_guard<pybind11::gil_scoped_release>())
+        .def("set_non_blocking", &MultiverseClient::set_non_blocking)
+        .def("poll", &MultiverseClient::poll, pybind11::call_guard<pybind11::gil_scoped_release>())
+        .def("get_socket_fd", &MultiverseClient::get_socket_fd)
         .def("get_time_now", &MultiverseClient::get_time_now);
 
     pybind11::class_<MultiverseClientPybind, MultiverseClient>(handle, "MultiverseClientPybind")
@@ -544,8 +862,27 @@ PYBIND11_MODULE(multiverse_client_pybind, handle)
         .def("get_world_time", &MultiverseClientPybind::get_world_time)
         .def("set_request_meta_data", &MultiverseClientPybind::set_request_meta_data)
         .def("get_response_meta_data", &MultiverseClientPybind::get_response_meta_data)
-        .def("set_send_data", &MultiverseClientPybind::set_send_data)
+        .def("set_send_data", static_cast<void (MultiverseClientPybind::*)(const pybind11::list &)>(&MultiverseClientPybind::set_send_data))
+        .def("set_send_data", static_cast<void (MultiverseClientPybind::*)(const pybind11::array_t<double, pybind11::array::c_style | pybind11::array::forcecast> &)>(&MultiverseClientPybind::set_send_data))
+        .def("set_send_data", static_cast<void (MultiverseClientPybind::*)(const double,
+                                                                           const pybind11::array_t<double, pybind11::array::c_style | pybind11::array::forcecast> &,
+                                                                           const pybind11::array_t<uint8_t, pybind11::array::c_style | pybind11::array::forcecast> &,
+                                                                           const pybind11::array_t<uint16_t, pybind11::array::c_style | pybind11::array::forcecast> &,
+                                                                           const pybind11::array_t<float, pybind11::array::c_style | pybind11::array::forcecast> &,
+                                                                           const pybind11::array_t<float, pybind11::array::c_style | pybind11::array::forcecast> &)>(&MultiverseClientPybind::set_send_data),
+             pybind11::arg("world_time"),
+             pybind11::arg("send_data_double") = pybind11::array_t<double>(0),
+             pybind11::arg("send_data_uint8") = pybind11::array_t<uint8_t>(0),
+             pybind11::arg("send_data_uint16") = pybind11::array_t<uint16_t>(0),
+             pybind11::arg("send_data_float") = pybind11::array_t<float>(0),
+             pybind11::arg("send_data_half") = pybind11::array_t<float>(0))
         .def("get_receive_data", &MultiverseClientPybind::get_receive_data)
+        .def("get_receive_data_double", &MultiverseClientPybind::get_receive_data_double)
+        .def("get_receive_data_uint8", &MultiverseClientPybind::get_receive_data_uint8)
+        .def("get_receive_data_uint16", &MultiverseClientPybind::get_receive_data_uint16)
+        .def("get_receive_data_float", &MultiverseClientPybind::get_receive_data_float)
+        .def("get_receive_data_half", &MultiverseClientPybind::get_receive_data_half)
+        .def("set_receive_data_double_buffered", &MultiverseClientPybind::set_receive_data_double_buffered)
         .def("set_api_callbacks", &MultiverseClientPybind::set_api_callbacks)
         .def("set_api_callbacks_response", &MultiverseClientPybind::set_api_callbacks_response)
         .def("set_bind_request_meta_data_callback", &MultiverseClientPybind::set_bind_request_meta_data_callback)
@@ -21,9 +21,13 @@
 
 #pragma once
 
+#include "multiverse_compression.h"
 #include <zmq.hpp>
 #include <cmath>
+#include <condition_variable>
 #include <map>
+#include <mutex>
+#include <thread>
 #include <vector>
 #ifdef __linux__
 #include <jsoncpp/json/json.h>
@@ -64,14 +68,7 @@ enum class EAttribute : unsigned char
     JointQuaternion,
     Force,
     Torque,
-    RGB_3840_2160,
-    RGB_1280_1024,
-    RGB_640_480,
-    RGB_128_128,
-    Depth_3840_2160,
-    Depth_1280_1024,
-    Depth_640_480,
-    Depth_128_128,
+    Tensor,
 };
 
 /**
@@ -89,21 +86,80 @@ enum class EMultiverseServerState : unsigned char
     SendReceiveData,
 };
 
+/**
+ * @brief DecimatedRange is a range [start, end) of a buffer that is only bound
+ * once per period, the last bound values are reused in between. If the range
+ * is filtered, it is only bound while its object is in the region of interest.
+ *
+ */
+struct DecimatedRange
+{
+    size_t start;
+    size_t end;
+    double period;
+    double last_time = 0.0;
+    bool is_due = true;
+    bool is_filtered = false;
+    size_t object_index = 0;
+};
+
+/**
+ * @brief ContiguousRange is a range [start, end) of a buffer whose bound data
+ * lies contiguously in memory, so that it is converted in one loop over arrays.
+ *
+ */
+struct ContiguousRange
+{
+    size_t start;
+    size_t end;
+};
+
+/**
+ * @brief InterestRegion is the region of interest of the receive data from
+ * "interest" in the meta data, either a box {"min": [x, y, z], "max": [x, y, z]}
+ * or a sphere {"center": [x, y, z], "radius": r} or {"object": name, "radius": r}
+ * around the position of an object.
+ * Delta frames are enabled with the region, unless "delta_encoding" is false.
+ *
+ */
+struct InterestRegion
+{
+    bool is_enabled = false;
+    bool is_box = false;
+    double min[3];
+    double max[3];
+    double center[3];
+    double radius = 0.0;
+    std::string object_name;
+    double cell_size = 1.0;
+};
+
 /**
  * @brief TypedBuffer is a buffer that contains data of a specific type.
  *
  * @tparam T The type of the data.
+ * @tparam U The type of the bound data, which is converted to T on the wire.
  */
-template <class T>
+template <class T, class U = T>
 struct TypedBuffer
 {
     T *data;
     size_t size = 0;
-    std::vector<std::pair<T *, T>> data_vec;
+    std::vector<std::pair<U *, U>> data_vec;
+    std::vector<DecimatedRange> decimated_ranges;
+    std::vector<U> conversions;
+    std::vector<ContiguousRange> contiguous_ranges;
+    std::vector<T> last_data;
+    std::vector<uint32_t> delta_ranges;
+    std::vector<char> delta_data;
+    std::vector<char> compressed_data;
+    LZ4HashTable hash_table;
 };
 
 /**
- * @brief Buffer contains buffers for double and uint8_t data.
+ * @brief Buffer contains buffers for double and uint8_t data. The double
+ * data is kept in double internally and transported as float or half (stored
+ * as uint16_t) in buffer_float and buffer_half if requested.
  *
  */
 struct Buffer
@@ -111,6 +167,8 @@ struct Buffer
     TypedBuffer<double> buffer_double;
     TypedBuffer<uint8_t> buffer_uint8_t;
     TypedBuffer<uint16_t> buffer_uint16_t;
+    TypedBuffer<float, double> buffer_float;
+    TypedBuffer<uint16_t, double> buffer_half;
 };
 
 /**
@@ -124,6 +182,34 @@ struct ConversionMap
     std::map<EAttribute, std::vector<uint16_t>> conversion_map_uint16_t;
 };
 
+/**
+ * @brief CumulativeData is the sum of the data of all senders of a cumulative
+ * attribute (force, torque) for one receiving session, so that sessions never
+ * write the shared attribute data of the world.
+ *
+ */
+template <class T>
+struct CumulativeData
+{
+    std::vector<T> default_data;
+    std::vector<T> data;
+    std::vector<const std::vector<T> *> sender_data;
+};
+
+/**
+ * @brief CumulativeAttribute contains the cumulative data for double, uint8_t
+ * and uint16_t data.
+ *
+ */
+struct CumulativeAttribute
+{
+    CumulativeData<double> cumulative_double;
+    CumulativeData<uint8_t> cumulative_uint8_t;
+    CumulativeData<uint16_t> cumulative_uint16_t;
+};
+
+struct Attribute;
+
 /**
  * @brief MultiverseServer is the server that communicates with the clients.
  *
@@ -168,6 +254,24 @@ private:
      *
      */
     void bind_meta_data();
+
+    /**
+     * @brief Register the tensor attributes from "tensors" in the meta data,
+     * each with a dtype (double, uint8 or uint16) and a shape, e.g.
+     * {"rgb_320_240": {"dtype": "uint8", "shape": [240, 320, 3]}}.
+     *
+     */
+    void bind_tensor_attributes();
+
+    /**
+     * @brief Get the data_vec of buffer_double, buffer_float or buffer_half
+     * of the buffer, depending on the precision of the attribute.
+     *
+     * @param buffer The send_buffer or the receive_buffer.
+     * @param attribute_name The name of the attribute.
+     * @return std::vector<std::pair<double *, double>>& The data_vec.
+     */
+    std::vector<std::pair<double *, double>> &get_data_vec_double(Buffer &buffer, const std::string &attribute_name);
     
     /**
      * @brief Validate the meta data, check if there are empty fields in the
@@ -188,6 +292,15 @@ private:
      */
     void bind_receive_objects();
 
+    /**
+     * @brief Bind the dependencies of the simulation, which are the other
+     * simulations in the world that send the objects in receive_objects_json.
+     * Only the dependencies are locked while binding the receive data, so
+     * independent simulations can step in parallel.
+     *
+     */
+    void bind_dependencies();
+
     /**
      * @brief Wait for the API callbacks response from other clients, which
      * receive the API callbacks from this client.
@@ -209,7 +322,9 @@ private:
     void init_send_and_receive_data();
 
     /**
-     * @brief Wait for the other clients to send the data.
+     * @brief Wait until the requested simulation took over the new request
+     * meta data. After that, the session only keeps waiting for the requested
+     * simulation to send its data if it is one of the dependencies.
      *
      */
     void wait_for_other_send_data();
@@ -221,14 +336,44 @@ private:
     void bind_send_data();
 
     /**
-     * @brief Wait for the data to be received from the client (constantly check
-     * if the data is nan).
+     * @brief Reply to a history request with the values of the requested
+     * attributes at, or interpolated to, the requested time.
+     *
+     * @param history_request_str The history request in JSON.
+     */
+    void send_history(const std::string &history_request_str);
+
+    /**
+     * @brief Mark the send data of this session as sent and, before the first
+     * receive data, wait until the dependencies sent the receive attributes.
      *
      */
     void wait_for_receive_data();
 
     /**
-     * @brief Compute the cumulative data, such as force and torque.
+     * @brief Check which receive data is due according to receive_period and
+     * the decimated ranges of the receive_buffer.
+     *
+     */
+    void update_receive_rates();
+
+    /**
+     * @brief Enable the spatial grid of the world, which indexes the position
+     * of the objects for the region of interest.
+     *
+     */
+    void enable_spatial_grid();
+
+    /**
+     * @brief Query the spatial grid and update which objects are in the region
+     * of interest.
+     *
+     */
+    void update_interest();
+
+    /**
+     * @brief Compute the cumulative data, such as force and torque, from the
+     * data of the senders into the cumulative attributes of this session.
      *
      */
     void compute_cumulative_data();
@@ -239,6 +384,23 @@ private:
      */
     void bind_receive_data();
 
+    /**
+     * @brief Commit the send data of this session to the back buffer of the
+     * epoch data of the world, under the epoch lock of the world. Once every
+     * sender of the world committed since the last epoch, the back buffer is
+     * published as the next epoch, which is read by the double buffered
+     * receivers.
+     *
+     */
+    void commit_epoch();
+
+    /**
+     * @brief Bind the receive data from the last published epoch of the
+     * world, retry if the epoch is flipped while binding.
+     *
+     */
+    void bind_receive_epoch_data();
+
     /**
      * @brief If request_simulation_name != simulation_name, then the server will receive the new request meta data,
      * this process will wait until the other client sends the new request meta data and the data after that.
@@ -252,6 +414,19 @@ private:
      */
     void send_receive_data();
 
+    /**
+     * @brief Compress the uint16 buffer of the receive data whenever the
+     * session requests it, until the session is destroyed.
+     *
+     */
+    void run_compression_worker();
+
+    /**
+     * @brief Wait until the compression worker compressed the uint16 buffer.
+     *
+     */
+    void wait_for_compression();
+
 private:
     /**
      * @brief Flag to indicate the state of the server.
@@ -307,6 +482,27 @@ private:
      */
     Buffer receive_buffer;
 
+    /**
+     * @brief The mutexes of the dependencies, sorted by simulation name.
+     * 
+     */
+    std::vector<std::mutex *> dependency_mtxs;
+
+    /**
+     * @brief The cumulative receive attributes of this session, mapped by
+     * object and attribute name.
+     *
+     */
+    std::map<std::string, std::map<std::string, CumulativeAttribute>> cumulative_attributes;
+
+    /**
+     * @brief The version of the send bindings of the world when the
+     * dependencies were bound, the dependencies are bound again when it
+     * changes.
+     *
+     */
+    size_t dependency_version = 0;
+
     /**
      * @brief The conversion map for the data.
      * 
@@ -360,6 +556,152 @@ private:
      *
      */
     bool continue_state = false;
+
+    /**
+     * @brief If the meta data requests double_buffered, then the receive data
+     * is bound from the last published epoch of the world instead of the
+     * current data, so receivers never wait for senders. An epoch holds the
+     * last commit of each sender of the world and is published once all of
+     * them committed, a sender that stops stepping holds the epoch back.
+     *
+     */
+    bool is_double_buffered = false;
+
+    /**
+     * @brief The period of the receive data in seconds from rate_hz in the
+     * meta data, 0 means every step.
+     *
+     */
+    double receive_period = 0.0;
+
+    /**
+     * @brief The periods of the receive attributes in seconds from rate_hz in
+     * the meta data.
+     *
+     */
+    std::map<std::string, double> receive_attribute_periods;
+
+    /**
+     * @brief The last time the receive data was bound.
+     *
+     */
+    double last_receive_time = 0.0;
+
+    /**
+     * @brief If true, the receive data is sent as delta frames whenever they
+     * are smaller than the full frames, by default only with a region of interest.
+     *
+     */
+    bool is_delta_encoding = false;
+
+    /**
+     * @brief The compression of the uint8 buffers (rgb) from "compression" in
+     * the meta data.
+     *
+     */
+    ECompression compression_uint8_t = ECompression::None;
+
+    /**
+     * @brief The compression of the uint16 buffers (depth) from "compression"
+     * in the meta data.
+     *
+     */
+    ECompression compression_uint16_t = ECompression::None;
+
+    /**
+     * @brief The worker that compresses the uint16 buffer (depth) while the
+     * session compresses the uint8 buffer (rgb) and sends the other frames,
+     * started with the first compressed uint16 frame.
+     *
+     */
+    std::thread compression_worker;
+
+    std::mutex compression_mtx;
+
+    std::condition_variable compression_cv;
+
+    /**
+     * @brief Set by the session to start the compression, reset by the
+     * compression worker when it is done.
+     *
+     */
+    bool is_compression_pending = false;
+
+    bool should_stop_compression = false;
+
+    /**
+     * @brief The transport precision of the double attributes ("double",
+     * "float" or "half") from "precision" in the meta data.
+     *
+     */
+    std::string precision = "double";
+
+    /**
+     * @brief The transport precisions of the double attributes from
+     * "precision" in the meta data, overriding precision.
+     *
+     */
+    std::map<std::string, std::string> attribute_precisions;
+
+    /**
+     * @brief The region of interest of the receive data.
+     *
+     */
+    InterestRegion interest_region;
+
+    /**
+     * @brief The receive objects that are filtered by the region of interest.
+     *
+     */
+    std::vector<std::string> interest_objects;
+
+    /**
+     * @brief The indices of the receive objects in interest_objects.
+     *
+     */
+    std::map<std::string, size_t> interest_object_indices;
+
+    /**
+     * @brief If the receive objects in interest_objects are in the region of
+     * interest.
+     *
+     */
+    std::vector<bool> interest_object_visibilities;
+
+    /**
+     * @brief The positions of the send objects, which update the spatial grid
+     * of the world.
+     *
+     */
+    std::vector<std::pair<std::string, const double *>> send_positions;
+
+    /**
+     * @brief The number of past values that are kept per attribute of the
+     * world, from "history_size" in the meta data.
+     *
+     */
+    size_t history_size = 0;
+
+    /**
+     * @brief The send attributes, their values are recorded in the history of
+     * the world.
+     *
+     */
+    std::vector<Attribute *> send_attributes;
+
+    /**
+     * @brief The cumulative send attributes, their simulation data of this
+     * session is committed to the epoch data of the world.
+     *
+     */
+    std::vector<Attribute *> send_cumulative_attributes;
+
+    /**
+     * @brief If the receive data is not due, the server only sends the time
+     * and the client reuses the last receive data.
+     *
+     */
+    bool is_receive_due = true;
 };
 
 /**
@@ -369,6 +711,33 @@ private:
  */
 void start_multiverse_server(const std::string &server_socket_addr);
 
+/**
+ * @brief Start the router that hashes the world name of each connection request
+ * to one of the shards, which are multiverse servers running in other processes.
+ * Each world is hosted by exactly one shard, so independent worlds do not share state.
+ * A shard that does not reply within the timeout is reconnected and the client gets an error reply,
+ * so one dead shard does not block the worlds of the other shards.
+ *
+ * @param server_socket_addr The router socket address that the clients connect to.
+ * @param shard_socket_addrs The server socket addresses of the shards.
+ */
+void start_multiverse_router(const std::string &server_socket_addr, const std::vector<std::string> &shard_socket_addrs);
+
+/**
+ * @brief Start the read-only query server with the query socket address.
+ * A query is a JSON request {"world_name": ..., "objects": {object: [attributes]}, "format": "json" or "binary"},
+ * "" selects all objects or all attributes. The reply is a snapshot of the SI values that the senders
+ * of the world wrote in their last step, with each selected attribute listed once in sorted order.
+ * The senders never wait for a query, a query that overlaps the step of a sender copies the snapshot again.
+ * The binary reply starts with a JSON frame {"world_name", "time", "layout"} whose layout lists
+ * {"object", "attribute", "dtype", "offset", "size"} of each entry, followed by the double, uint8
+ * and uint16 frames that the offsets refer to.
+ * If the query socket can not be bound, queries are disabled and the server keeps running.
+ *
+ * @param query_socket_addr The query socket address.
+ */
+void start_multiverse_query_server(const std::string &query_socket_addr);
+
 /**
  * @brief The flag to indicate if the server should shut down.
  * 
@@ -27,11 +27,46 @@
 #include "multiverse_server.h"
 
 /**
- * @brief multiverse_server takes one argument as the server socket address, default is "tcp://*:7000", 
- * meaning the server will listen on all interfaces on port 7000.
- * 
+ * @brief Get the default query socket address, which is the server socket address with the next port.
+ *
+ * @param server_socket_addr The server socket address
+ * @return std::string The query socket address, empty if the server socket address has no numeric port
+ */
+static std::string get_default_query_socket_addr(const std::string &server_socket_addr)
+{
+    const size_t port_pos = server_socket_addr.find_last_of(':');
+    if (port_pos == std::string::npos)
+    {
+        return "";
+    }
+    try
+    {
+        size_t port_size = 0;
+        const int port = std::stoi(server_socket_addr.substr(port_pos + 1), &port_size);
+        if (port_pos + 1 + port_size != server_socket_addr.size())
+        {
+            return "";
+        }
+        return server_socket_addr.substr(0, port_pos + 1) + std::to_string(port + 1);
+    }
+    catch (const std::exception &)
+    {
+        return "";
+    }
+}
+
+/**
+ * @brief multiverse_server takes the server socket address as the first argument, default is port 7000 on all
+ * interfaces (the tcp wildcard address), and the query socket address as the second argument, default is the
+ * server socket address with the next port (7001 by default). "none" as the query socket address disables the
+ * query server.
+ * With "--router" as the first argument, it only routes the clients to the shards instead, e.g.
+ * multiverse_server --router tcp://0.0.0.0:7000 tcp://127.0.0.1:7100 tcp://127.0.0.1:7200
+ * where each shard is a multiverse_server started with its own server socket address.
+ *
  * @param argc Number of arguments
- * @param argv The arguments, the second argument is the server socket address
+ * @param argv The arguments, [server socket address] [query socket address], or --router [router socket address]
+ * [shard socket addresses...]
  * @return int Return 0 if successful
  */
 int main(int argc, char **argv)
@@ -46,6 +81,37 @@ int main(int argc, char **argv)
         zmq_sleep(1);
         server_context.shutdown(); });
 
+    if (argc > 1 && std::string(argv[1]) == "--router")
+    {
+        const std::string router_socket_addr = argc > 2 ? std::string(argv[2]) : "tcp://*:7000";
+        std::vector<std::string> shard_socket_addrs;
+        for (int i = 3; i < argc; i++)
+        {
+            shard_socket_addrs.push_back(std::string(argv[i]));
+        }
+        if (shard_socket_addrs.empty())
+        {
+            printf("[Server] The router needs at least one shard socket address.\n");
+            return 1;
+        }
+
+        std::thread multiverse_router_thread(start_multiverse_router, router_socket_addr, shard_socket_addrs);
+
+        while (!should_shut_down)
+        {
+        }
+
+        zmq_sleep(1);
+
+        server_context.close();
+
+        if (multiverse_router_thread.joinable())
+        {
+            multiverse_router_thread.join();
+        }
+        return 0;
+    }
+
     std::string server_socket_addr;
     if (argc > 1)
     {
@@ -56,7 +122,22 @@ int main(int argc, char **argv)
         server_socket_addr = "tcp://*:7000";
     }
 
+    std::string query_socket_addr;
+    if (argc > 2)
+    {
+        query_socket_addr = std::string(argv[2]);
+    }
+    else
+    {
+        query_socket_addr = get_default_query_socket_addr(server_socket_addr);
+    }
+
     std::thread multiverse_server_thread(start_multiverse_server, server_socket_addr);
+    std::thread multiverse_query_server_thread;
+    if (!query_socket_addr.empty() && query_socket_addr != "none")
+    {
+        multiverse_query_server_thread = std::thread(start_multiverse_query_server, query_socket_addr);
+    }
 
     while (!should_shut_down)
     {
@@ -84,4 +165,9 @@ int main(int argc, char **argv)
     {
         multiverse_server_thread.join();
     }
+
+    if (multiverse_query_server_thread.joinable())
+    {
+        multiverse_query_server_thread.join();
+    }
 }
\ No newline at end of file
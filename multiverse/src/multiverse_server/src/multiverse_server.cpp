@@ -20,11 +20,13 @@
 
 #define _USE_MATH_DEFINES
 #include <set>
+#include <atomic>
 #include <chrono>
 #include <csignal>
 #include <iostream>
 #include <mutex>
 #include <thread>
+#include <tuple>
 #include <zmq_addon.hpp>
 
 #include "multiverse_server.h"
@@ -67,17 +69,17 @@ std::map<std::string, std::pair<EAttribute, std::vector<double>>> attribute_map_
 
 std::map<std::string, std::pair<EAttribute, std::vector<uint8_t>>> attribute_map_uint8_t =
     {
-        {"rgb_3840_2160", {EAttribute::RGB_3840_2160, std::vector<uint8_t>(3840 * 2160 * 3, std::numeric_limits<uint8_t>::quiet_NaN())}},
-        {"rgb_1280_1024", {EAttribute::RGB_1280_1024, std::vector<uint8_t>(1280 * 1024 * 3, std::numeric_limits<uint8_t>::quiet_NaN())}},
-        {"rgb_640_480", {EAttribute::RGB_640_480, std::vector<uint8_t>(640 * 480 * 3, std::numeric_limits<uint8_t>::quiet_NaN())}},
-        {"rgb_128_128", {EAttribute::RGB_128_128, std::vector<uint8_t>(128 * 128 * 3, std::numeric_limits<uint8_t>::quiet_NaN())}}};
+        {"rgb_3840_2160", {EAttribute::Tensor, std::vector<uint8_t>(3840 * 2160 * 3, std::numeric_limits<uint8_t>::quiet_NaN())}},
+        {"rgb_1280_1024", {EAttribute::Tensor, std::vector<uint8_t>(1280 * 1024 * 3, std::numeric_limits<uint8_t>::quiet_NaN())}},
+        {"rgb_640_480", {EAttribute::Tensor, std::vector<uint8_t>(640 * 480 * 3, std::numeric_limits<uint8_t>::quiet_NaN())}},
+        {"rgb_128_128", {EAttribute::Tensor, std::vector<uint8_t>(128 * 128 * 3, std::numeric_limits<uint8_t>::quiet_NaN())}}};
 
 std::map<std::string, std::pair<EAttribute, std::vector<uint16_t>>> attribute_map_uint16_t =
     {
-        {"depth_3840_2160", {EAttribute::Depth_3840_2160, std::vector<uint16_t>(3840 * 2160, std::numeric_limits<uint16_t>::quiet_NaN())}},
-        {"depth_1280_1024", {EAttribute::Depth_1280_1024, std::vector<uint16_t>(1280 * 1024, std::numeric_limits<uint16_t>::quiet_NaN())}},
-        {"depth_640_480", {EAttribute::Depth_640_480, std::vector<uint16_t>(640 * 480, std::numeric_limits<uint16_t>::quiet_NaN())}},
-        {"depth_128_128", {EAttribute::Depth_128_128, std::vector<uint16_t>(128 * 128, std::numeric_limits<uint16_t>::quiet_NaN())}}};
+        {"depth_3840_2160", {EAttribute::Tensor, std::vector<uint16_t>(3840 * 2160, std::numeric_limits<uint16_t>::quiet_NaN())}},
+        {"depth_1280_1024", {EAttribute::Tensor, std::vector<uint16_t>(1280 * 1024, std::numeric_limits<uint16_t>::quiet_NaN())}},
+        {"depth_640_480", {EAttribute::Tensor, std::vector<uint16_t>(640 * 480, std::numeric_limits<uint16_t>::quiet_NaN())}},
+        {"depth_128_128", {EAttribute::Tensor, std::vector<uint16_t>(128 * 128, std::numeric_limits<uint16_t>::quiet_NaN())}}};
 
 std::map<std::string, double> unit_scale =
     {
@@ -180,15 +182,28 @@ template <class T>
 struct TypedAttribute
 {
     std::vector<T> data;
+    std::vector<T> commit_data;
+    std::vector<T> epoch_data;
+    std::vector<T> snapshot_data;
     std::map<std::string, std::vector<T>> simulation_data;
+    std::map<std::string, std::vector<T>> epoch_simulation_data;
     bool is_sent = false;
 };
 
+struct AttributeHistory
+{
+    std::vector<double> times;
+    std::vector<double> values;
+    size_t head = 0;
+    size_t count = 0;
+};
+
 struct Attribute
 {
     TypedAttribute<double> attribute_double;
     TypedAttribute<uint8_t> attribute_uint8_t;
     TypedAttribute<uint16_t> attribute_uint16_t;
+    AttributeHistory history;
 };
 
 struct Object
@@ -203,22 +218,590 @@ struct Simulation
     EMetaDataState meta_data_state;
     std::vector<std::map<std::string, std::vector<std::string>>> api_callbacks;
     std::vector<std::map<std::string, std::vector<std::string>>> api_callbacks_response;
+    std::set<std::string> dependencies;
+    std::mutex mtx;
+};
+
+struct SpatialGrid
+{
+    std::atomic<bool> is_enabled{false};
+    double cell_size = 1.0;
+    std::map<std::string, const double *> positions;
+    std::map<std::string, std::tuple<long, long, long>> object_cells;
+    std::map<std::tuple<long, long, long>, std::set<std::string>> cells;
+    std::mutex mtx;
 };
 
 struct World
 {
     std::map<std::string, Object> objects;
+    std::map<std::string, std::set<std::string>> attribute_objects;
     std::map<std::string, Simulation> simulations;
+    std::map<std::string, std::map<std::string, std::set<std::string>>> senders;
+    std::atomic<size_t> senders_version{0};
+    std::atomic<size_t> epoch{0};
+    std::mutex epoch_mtx;
+    std::atomic<bool> is_double_buffered{false};
+    std::set<std::string> double_buffered_simulations;
+    std::map<std::string, std::vector<Attribute *>> epoch_send_attributes;
+    std::map<std::string, std::vector<Attribute *>> epoch_send_cumulative_attributes;
+    std::set<std::string> epoch_committed_simulations;
+    SpatialGrid spatial_grid;
+    size_t history_size = 0;
+    std::mutex history_mtx;
+    std::atomic<bool> is_snapshot_enabled{false};
+    std::atomic<size_t> snapshot_sequence{0};
+    std::mutex snapshot_mtx;
+    std::mutex snapshot_layout_mtx;
+    std::map<std::pair<std::string, std::string>, const Attribute *> snapshot_attributes;
+    double snapshot_time = 0.0;
     double time = 0.0;
 };
 
 std::map<std::string, World> worlds;
 
+// The worlds that have snapshot attributes, the query server looks them up here instead of under mtx
+std::mutex snapshot_worlds_mtx;
+std::map<std::string, World *> snapshot_worlds;
+
+template <class T>
+static void commit_typed_attribute(TypedAttribute<T> &typed_attribute)
+{
+    // The commit data is the back buffer of the epoch data
+    std::vector<T> &commit_data = typed_attribute.commit_data;
+    if (commit_data.size() != typed_attribute.data.size())
+    {
+        commit_data.resize(typed_attribute.data.size());
+    }
+    std::copy(typed_attribute.data.begin(), typed_attribute.data.end(), commit_data.begin());
+}
+
+template <class T>
+static void commit_typed_cumulative_attribute(TypedAttribute<T> &typed_attribute, const std::string &simulation_name)
+{
+    typename std::map<std::string, std::vector<T>>::const_iterator simulation_data_it = typed_attribute.simulation_data.find(simulation_name);
+    if (simulation_data_it != typed_attribute.simulation_data.end())
+    {
+        typed_attribute.epoch_simulation_data[simulation_name] = simulation_data_it->second;
+    }
+}
+
+template <class T>
+static void flip_typed_attribute(TypedAttribute<T> &typed_attribute)
+{
+    std::vector<T> &epoch_data = typed_attribute.epoch_data;
+    if (epoch_data.size() == typed_attribute.commit_data.size())
+    {
+        std::copy(typed_attribute.commit_data.begin(), typed_attribute.commit_data.end(), epoch_data.begin());
+    }
+}
+
+template <class T>
+static void flip_typed_cumulative_attribute(TypedAttribute<T> &typed_attribute)
+{
+    // The default is the attribute data, the senders of cumulative attributes only write their simulation data
+    std::vector<T> &epoch_data = typed_attribute.epoch_data;
+    const std::vector<T> &default_data = typed_attribute.data;
+    if (epoch_data.size() != default_data.size())
+    {
+        return;
+    }
+
+    std::copy(default_data.begin(), default_data.end(), epoch_data.begin());
+    for (const std::pair<const std::string, std::vector<T>> &epoch_simulation_data : typed_attribute.epoch_simulation_data)
+    {
+        if (epoch_simulation_data.second.size() != epoch_data.size())
+        {
+            continue;
+        }
+
+        for (size_t i = 0; i < epoch_data.size(); i++)
+        {
+            epoch_data[i] += epoch_simulation_data.second[i];
+        }
+    }
+}
+
+// Publishes the commit data of all senders of the world as the new epoch, called under the epoch lock
+static void flip_epoch(World &world)
+{
+    // The epoch is odd while the epoch data is being written, readers retry until it is even again
+    world.epoch++;
+    for (const std::pair<const std::string, std::vector<Attribute *>> &epoch_send_attributes : world.epoch_send_attributes)
+    {
+        for (Attribute *attribute : epoch_send_attributes.second)
+        {
+            flip_typed_attribute(attribute->attribute_double);
+            flip_typed_attribute(attribute->attribute_uint8_t);
+            flip_typed_attribute(attribute->attribute_uint16_t);
+        }
+    }
+    for (const std::pair<const std::string, std::vector<Attribute *>> &epoch_send_cumulative_attributes : world.epoch_send_cumulative_attributes)
+    {
+        for (Attribute *attribute : epoch_send_cumulative_attributes.second)
+        {
+            flip_typed_cumulative_attribute(attribute->attribute_double);
+            flip_typed_cumulative_attribute(attribute->attribute_uint8_t);
+            flip_typed_cumulative_attribute(attribute->attribute_uint16_t);
+        }
+    }
+    world.epoch++;
+    world.epoch_committed_simulations.clear();
+}
+
+// Removes a simulation from the senders that an epoch waits for, called under the epoch lock
+static void remove_epoch_sender(World &world, const std::string &simulation_name)
+{
+    std::map<std::string, std::vector<Attribute *>>::iterator epoch_send_cumulative_attributes_it = world.epoch_send_cumulative_attributes.find(simulation_name);
+    if (epoch_send_cumulative_attributes_it != world.epoch_send_cumulative_attributes.end())
+    {
+        for (Attribute *attribute : epoch_send_cumulative_attributes_it->second)
+        {
+            attribute->attribute_double.epoch_simulation_data.erase(simulation_name);
+            attribute->attribute_uint8_t.epoch_simulation_data.erase(simulation_name);
+            attribute->attribute_uint16_t.epoch_simulation_data.erase(simulation_name);
+        }
+        world.epoch_send_cumulative_attributes.erase(epoch_send_cumulative_attributes_it);
+    }
+    world.epoch_send_attributes.erase(simulation_name);
+    world.epoch_committed_simulations.erase(simulation_name);
+}
+
+template <class T>
+static void bind_cumulative_senders(CumulativeData<T> &cumulative_data, const std::map<std::string, std::vector<T>> &simulation_data, const std::set<std::string> &sender_names)
+{
+    cumulative_data.sender_data.clear();
+    for (const std::string &sender_name : sender_names)
+    {
+        typename std::map<std::string, std::vector<T>>::const_iterator simulation_data_it = simulation_data.find(sender_name);
+        if (simulation_data_it != simulation_data.end())
+        {
+            cumulative_data.sender_data.push_back(&simulation_data_it->second);
+        }
+    }
+}
+
+template <class T>
+static void compute_typed_cumulative_data(CumulativeData<T> &cumulative_data)
+{
+    std::vector<T> &data = cumulative_data.data;
+    std::copy(cumulative_data.default_data.begin(), cumulative_data.default_data.end(), data.begin());
+    for (const std::vector<T> *sender_data : cumulative_data.sender_data)
+    {
+        if (sender_data->size() != data.size())
+        {
+            continue;
+        }
+
+        for (size_t i = 0; i < data.size(); i++)
+        {
+            data[i] += (*sender_data)[i];
+        }
+    }
+}
+
+template <class T, class U>
+static void add_decimated_range(TypedBuffer<T, U> &typed_buffer, const size_t start, const double period, const bool is_filtered = false, const size_t object_index = 0)
+{
+    if (typed_buffer.data_vec.size() > start)
+    {
+        DecimatedRange decimated_range;
+        decimated_range.start = start;
+        decimated_range.end = typed_buffer.data_vec.size();
+        decimated_range.period = period;
+        decimated_range.is_filtered = is_filtered;
+        decimated_range.object_index = object_index;
+        typed_buffer.decimated_ranges.push_back(decimated_range);
+    }
+}
+
+template <class T, class U>
+static void init_contiguous_ranges(TypedBuffer<T, U> &typed_buffer)
+{
+    typed_buffer.conversions.resize(typed_buffer.data_vec.size());
+    typed_buffer.contiguous_ranges.clear();
+    for (size_t i = 0; i < typed_buffer.data_vec.size(); i++)
+    {
+        typed_buffer.conversions[i] = typed_buffer.data_vec[i].second;
+        if (i > 0 && typed_buffer.data_vec[i].first == typed_buffer.data_vec[i - 1].first + 1)
+        {
+            typed_buffer.contiguous_ranges.back().end = i + 1;
+        }
+        else
+        {
+            typed_buffer.contiguous_ranges.push_back({i, i + 1});
+        }
+    }
+}
+
+static std::tuple<long, long, long> get_spatial_cell(const double *position, const double cell_size)
+{
+    return std::make_tuple((long)std::floor(position[0] / cell_size), (long)std::floor(position[1] / cell_size), (long)std::floor(position[2] / cell_size));
+}
+
+static void update_spatial_grid(SpatialGrid &spatial_grid, const std::string &object_name, const double *position)
+{
+    if (std::isnan(position[0]) || std::isnan(position[1]) || std::isnan(position[2]))
+    {
+        return;
+    }
+
+    const std::tuple<long, long, long> cell = get_spatial_cell(position, spatial_grid.cell_size);
+    std::map<std::string, std::tuple<long, long, long>>::iterator object_cell_it = spatial_grid.object_cells.find(object_name);
+    if (object_cell_it == spatial_grid.object_cells.end())
+    {
+        spatial_grid.positions[object_name] = position;
+        spatial_grid.object_cells[object_name] = cell;
+        spatial_grid.cells[cell].insert(object_name);
+    }
+    else if (object_cell_it->second != cell)
+    {
+        std::map<std::tuple<long, long, long>, std::set<std::string>>::iterator old_cell_it = spatial_grid.cells.find(object_cell_it->second);
+        old_cell_it->second.erase(object_name);
+        if (old_cell_it->second.empty())
+        {
+            spatial_grid.cells.erase(old_cell_it);
+        }
+        object_cell_it->second = cell;
+        spatial_grid.cells[cell].insert(object_name);
+    }
+}
+
+static void query_spatial_grid(const SpatialGrid &spatial_grid, const double *min, const double *max, std::vector<std::pair<std::string, const double *>> &objects_inside)
+{
+    const std::tuple<long, long, long> min_cell = get_spatial_cell(min, spatial_grid.cell_size);
+    const std::tuple<long, long, long> max_cell = get_spatial_cell(max, spatial_grid.cell_size);
+    const double cell_count = (double)(std::get<0>(max_cell) - std::get<0>(min_cell) + 1) * (std::get<1>(max_cell) - std::get<1>(min_cell) + 1) * (std::get<2>(max_cell) - std::get<2>(min_cell) + 1);
+
+    std::vector<const std::set<std::string> *> cells;
+    if (cell_count > spatial_grid.cells.size())
+    {
+        // The region covers more cells than are occupied, visit the occupied ones
+        for (const std::pair<const std::tuple<long, long, long>, std::set<std::string>> &cell : spatial_grid.cells)
+        {
+            if (std::get<0>(cell.first) >= std::get<0>(min_cell) && std::get<0>(cell.first) <= std::get<0>(max_cell) &&
+                std::get<1>(cell.first) >= std::get<1>(min_cell) && std::get<1>(cell.first) <= std::get<1>(max_cell) &&
+                std::get<2>(cell.first) >= std::get<2>(min_cell) && std::get<2>(cell.first) <= std::get<2>(max_cell))
+            {
+                cells.push_back(&cell.second);
+            }
+        }
+    }
+    else
+    {
+        for (long x = std::get<0>(min_cell); x <= std::get<0>(max_cell); x++)
+        {
+            for (long y = std::get<1>(min_cell); y <= std::get<1>(max_cell); y++)
+            {
+                for (long z = std::get<2>(min_cell); z <= std::get<2>(max_cell); z++)
+                {
+                    std::map<std::tuple<long, long, long>, std::set<std::string>>::const_iterator cell_it = spatial_grid.cells.find(std::make_tuple(x, y, z));
+                    if (cell_it != spatial_grid.cells.end())
+                    {
+                        cells.push_back(&cell_it->second);
+                    }
+                }
+            }
+        }
+    }
+
+    for (const std::set<std::string> *cell : cells)
+    {
+        for (const std::string &object_name : *cell)
+        {
+            const double *position = spatial_grid.positions.at(object_name);
+            if (position[0] >= min[0] && position[0] <= max[0] &&
+                position[1] >= min[1] && position[1] <= max[1] &&
+                position[2] >= min[2] && position[2] <= max[2])
+            {
+                objects_inside.emplace_back(object_name, position);
+            }
+        }
+    }
+}
+
+template <class T, class U, class BindFunction>
+static void bind_decimated_buffer(const TypedBuffer<T, U> &typed_buffer, const BindFunction &bind_function)
+{
+    size_t i = 0;
+    for (const DecimatedRange &decimated_range : typed_buffer.decimated_ranges)
+    {
+        for (; i < decimated_range.start; i++)
+        {
+            bind_function(i);
+        }
+        if (decimated_range.is_due)
+        {
+            for (; i < decimated_range.end; i++)
+            {
+                bind_function(i);
+            }
+        }
+        i = decimated_range.end;
+    }
+    for (; i < typed_buffer.size; i++)
+    {
+        bind_function(i);
+    }
+}
+
+template <class T, class U, class BindRange>
+static void bind_contiguous_buffer(const TypedBuffer<T, U> &typed_buffer, const BindRange &bind_range)
+{
+    // Like bind_decimated_buffer, but each contiguous range is bound at once, split where the decimated ranges start or end
+    std::vector<DecimatedRange>::const_iterator decimated_range_it = typed_buffer.decimated_ranges.begin();
+    for (const ContiguousRange &contiguous_range : typed_buffer.contiguous_ranges)
+    {
+        size_t start = contiguous_range.start;
+        while (start < contiguous_range.end)
+        {
+            while (decimated_range_it != typed_buffer.decimated_ranges.end() && decimated_range_it->end <= start)
+            {
+                ++decimated_range_it;
+            }
+            if (decimated_range_it == typed_buffer.decimated_ranges.end() || start < decimated_range_it->start)
+            {
+                const size_t end = decimated_range_it == typed_buffer.decimated_ranges.end() ? contiguous_range.end : std::min(contiguous_range.end, decimated_range_it->start);
+                bind_range(start, end);
+                start = end;
+            }
+            else
+            {
+                const size_t end = std::min(contiguous_range.end, decimated_range_it->end);
+                if (decimated_range_it->is_due)
+                {
+                    bind_range(start, end);
+                }
+                start = end;
+            }
+        }
+    }
+}
+
+/**
+ * @brief A history request contains this message spec and a JSON request
+ * {"time": t, "interpolate": true, "receive": {"object": ["attribute"]}},
+ * the reply contains the same message spec and the values of the attributes
+ * at the time {"time": t, "receive": {"object": {"attribute": [values]}}}.
+ * Attributes without a sample at the time are left out.
+ *
+ */
+static const int history_message_spec = -1;
+
+static size_t get_buffer_count(const Buffer &buffer)
+{
+    return (buffer.buffer_double.size > 0) + (buffer.buffer_uint8_t.size > 0) + (buffer.buffer_uint16_t.size > 0) + (buffer.buffer_float.size > 0) + (buffer.buffer_half.size > 0);
+}
+
+template <class T, class U>
+static void unpack_message(TypedBuffer<T, U> &typed_buffer, const zmq::message_t &message, const bool is_delta_frame, const std::string &socket_addr)
+{
+    if (is_delta_frame)
+    {
+        if (!decode_delta(static_cast<const char *>(message.data()), message.size(), typed_buffer.data, typed_buffer.size))
+        {
+            throw std::invalid_argument("[Server] Received invalid delta message [size = " + std::to_string(message.size()) + "] at socket " + socket_addr + ".");
+        }
+    }
+    else
+    {
+        memcpy(typed_buffer.data, message.data(), typed_buffer.size * sizeof(T));
+    }
+}
+
+static void unpack_message(TypedBuffer<uint8_t> &typed_buffer, const zmq::message_t &message, const bool is_delta_frame, const ECompression compression, const std::string &socket_addr)
+{
+    if (is_delta_frame || compression == ECompression::None)
+    {
+        unpack_message(typed_buffer, message, is_delta_frame, socket_addr);
+    }
+    else if (!decompress_data(static_cast<const char *>(message.data()), message.size(), typed_buffer.data, typed_buffer.size))
+    {
+        throw std::invalid_argument("[Server] Received invalid compressed message [size = " + std::to_string(message.size()) + "] at socket " + socket_addr + ".");
+    }
+}
+
+static void unpack_message(TypedBuffer<uint16_t> &typed_buffer, const zmq::message_t &message, const bool is_delta_frame, const ECompression compression, const std::string &socket_addr)
+{
+    if (is_delta_frame || compression == ECompression::None)
+    {
+        unpack_message(typed_buffer, message, is_delta_frame, socket_addr);
+    }
+    else if (!decompress_data(static_cast<const char *>(message.data()), message.size(), compression, typed_buffer.data, typed_buffer.size))
+    {
+        throw std::invalid_argument("[Server] Received invalid compressed message [size = " + std::to_string(message.size()) + "] at socket " + socket_addr + ".");
+    }
+}
+
+template <class T, class U>
+static zmq::message_t pack_message(const TypedBuffer<T, U> &typed_buffer, const bool is_delta_frame, const ECompression compression)
+{
+    if (is_delta_frame)
+    {
+        return zmq::message_t(typed_buffer.delta_data.data(), typed_buffer.delta_data.size());
+    }
+    if (compression != ECompression::None)
+    {
+        return zmq::message_t(typed_buffer.compressed_data.data(), typed_buffer.compressed_data.size());
+    }
+    return zmq::message_t(typed_buffer.data, typed_buffer.size * sizeof(T));
+}
+
+template <class T>
+static bool has_attribute(const std::map<std::string, std::pair<EAttribute, std::vector<T>>> &attribute_map, const std::string &attribute_name)
+{
+    // Lookups of other types insert empty placeholders, they don't count
+    typename std::map<std::string, std::pair<EAttribute, std::vector<T>>>::const_iterator attribute_it = attribute_map.find(attribute_name);
+    return attribute_it != attribute_map.end() && !attribute_it->second.second.empty();
+}
+
+template <class T>
+static bool register_tensor_attribute(std::map<std::string, std::pair<EAttribute, std::vector<T>>> &attribute_map, const std::string &attribute_name, const size_t size)
+{
+    if (!has_attribute(attribute_map, attribute_name))
+    {
+        attribute_map[attribute_name] = {EAttribute::Tensor, std::vector<T>(size, std::numeric_limits<T>::quiet_NaN())};
+        return true;
+    }
+    return attribute_map[attribute_name].first == EAttribute::Tensor && attribute_map[attribute_name].second.size() == size;
+}
+
+template <class T>
+static void fit_tensor_conversion(std::map<EAttribute, std::vector<T>> &conversion_map, const std::map<std::string, std::pair<EAttribute, std::vector<T>>> &attribute_map, const T identity)
+{
+    // Tensors are not converted, one conversion vector covers the largest tensor
+    size_t size = 0;
+    for (const std::pair<const std::string, std::pair<EAttribute, std::vector<T>>> &attribute : attribute_map)
+    {
+        if (attribute.second.first == EAttribute::Tensor && attribute.second.second.size() > size)
+        {
+            size = attribute.second.second.size();
+        }
+    }
+    if (conversion_map[EAttribute::Tensor].size() < size)
+    {
+        conversion_map[EAttribute::Tensor].assign(size, identity);
+    }
+}
+
+static void record_history(AttributeHistory &history, const size_t history_size, const double time, const std::vector<double> &data)
+{
+    const size_t size = data.size();
+    if (history.times.size() != history_size || history.values.size() != history_size * size)
+    {
+        history.times.assign(history_size, 0.0);
+        history.values.assign(history_size * size, 0.0);
+        history.head = 0;
+        history.count = 0;
+    }
+
+    if (history.count > 0)
+    {
+        const size_t last = (history.head + history_size - 1) % history_size;
+        if (time == history.times[last])
+        {
+            std::copy(data.begin(), data.end(), history.values.begin() + last * size);
+            return;
+        }
+        if (time < history.times[last])
+        {
+            // The world was reset, the old samples are not comparable anymore
+            history.count = 0;
+        }
+    }
+
+    history.times[history.head] = time;
+    std::copy(data.begin(), data.end(), history.values.begin() + history.head * size);
+    history.head = (history.head + 1) % history_size;
+    history.count = std::min(history.count + 1, history_size);
+}
+
+static bool sample_history(const AttributeHistory &history, const double time, const bool is_interpolated, const bool is_quaternion, std::vector<double> &data)
+{
+    if (history.count == 0)
+    {
+        return false;
+    }
+
+    const size_t history_size = history.times.size();
+    const size_t size = history.values.size() / history_size;
+    const size_t oldest = (history.head + history_size - history.count) % history_size;
+    const auto get_slot = [oldest, history_size](const size_t i)
+    { return (oldest + i) % history_size; };
+    if (time < history.times[get_slot(0)] || time > history.times[get_slot(history.count - 1)])
+    {
+        return false;
+    }
+
+    // The samples are ordered by time, find the last one at or before the time
+    size_t low = 0;
+    size_t high = history.count - 1;
+    while (low < high)
+    {
+        const size_t middle = (low + high + 1) / 2;
+        if (history.times[get_slot(middle)] <= time)
+        {
+            low = middle;
+        }
+        else
+        {
+            high = middle - 1;
+        }
+    }
+
+    const double *sample = history.values.data() + get_slot(low) * size;
+    data.assign(sample, sample + size);
+    if (!is_interpolated || low + 1 == history.count || history.times[get_slot(low)] == time)
+    {
+        return true;
+    }
+
+    const double *next_sample = history.values.data() + get_slot(low + 1) * size;
+    const double alpha = (time - history.times[get_slot(low)]) / (history.times[get_slot(low + 1)] - history.times[get_slot(low)]);
+    double sign = 1.0;
+    if (is_quaternion)
+    {
+        double dot = 0.0;
+        for (size_t i = 0; i < size; i++)
+        {
+            dot += sample[i] * next_sample[i];
+        }
+        sign = dot < 0.0 ? -1.0 : 1.0;
+    }
+    for (size_t i = 0; i < size; i++)
+    {
+        data[i] = (1.0 - alpha) * sample[i] + alpha * sign * next_sample[i];
+    }
+    if (is_quaternion)
+    {
+        double norm = 0.0;
+        for (const double value : data)
+        {
+            norm += value * value;
+        }
+        norm = std::sqrt(norm);
+        if (norm > 0.0)
+        {
+            for (double &value : data)
+            {
+                value /= norm;
+            }
+        }
+    }
+    return true;
+}
+
 static double get_time_now()
 {
     return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count() / 1000000.0;
 }
 
+static double get_steady_time_now()
+{
+    // Periods are measured with the monotonic clock, wall clock jumps would stall or flood the receivers
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count() / 1000000.0;
+}
+
 static Json::Value sort_json_array(const Json::Value &original)
 {
     std::vector<std::string> vec;
@@ -274,6 +857,15 @@ MultiverseServer::~MultiverseServer()
 {
     printf("[Server] Close socket %s.\n", socket_addr.c_str());
 
+    if (compression_worker.joinable())
+    {
+        compression_mtx.lock();
+        should_stop_compression = true;
+        compression_mtx.unlock();
+        compression_cv.notify_all();
+        compression_worker.join();
+    }
+
     if (send_buffer.buffer_double.size > 0)
     {
         free(send_buffer.buffer_double.data);
@@ -286,6 +878,14 @@ MultiverseServer::~MultiverseServer()
     {
         free(send_buffer.buffer_uint16_t.data);
     }
+    if (send_buffer.buffer_float.size > 0)
+    {
+        free(send_buffer.buffer_float.data);
+    }
+    if (send_buffer.buffer_half.size > 0)
+    {
+        free(send_buffer.buffer_half.data);
+    }
     if (receive_buffer.buffer_double.size > 0)
     {
         free(receive_buffer.buffer_double.data);
@@ -298,6 +898,14 @@ MultiverseServer::~MultiverseServer()
     {
         free(receive_buffer.buffer_uint16_t.data);
     }
+    if (receive_buffer.buffer_float.size > 0)
+    {
+        free(receive_buffer.buffer_float.data);
+    }
+    if (receive_buffer.buffer_half.size > 0)
+    {
+        free(receive_buffer.buffer_half.data);
+    }
 
     printf("[Server] Clean up socket %s.\n", socket_addr.c_str());
 
@@ -318,9 +926,15 @@ void MultiverseServer::start()
             receive_buffer.buffer_double.size = 0;
             receive_buffer.buffer_uint8_t.size = 0;
             receive_buffer.buffer_uint16_t.size = 0;
+            send_buffer.buffer_float.size = 0;
+            send_buffer.buffer_half.size = 0;
+            receive_buffer.buffer_float.size = 0;
+            receive_buffer.buffer_half.size = 0;
 
             is_receive_data_sent = false;
 
+            is_receive_due = true;
+
             flag = receive_data();
             break;
         }
@@ -330,10 +944,13 @@ void MultiverseServer::start()
             // printf("[Server] Received meta data at socket %s:\n%s", socket_addr.c_str(), request_meta_data_json.toStyledString().c_str());
             bind_meta_data();
 
-            mtx.lock();
-            bind_send_objects();
-            validate_meta_data();
-            mtx.unlock();
+            {
+                // The binding may throw, the scoped lock releases the world on the way out
+                std::lock_guard<std::mutex> lock(mtx);
+                bind_tensor_attributes();
+                bind_send_objects();
+                validate_meta_data();
+            }
 
             wait_for_objects();
 
@@ -344,6 +961,7 @@ void MultiverseServer::start()
 
             mtx.lock();
             bind_receive_objects();
+            bind_dependencies();
             mtx.unlock();
 
             if (request_meta_data_json.isMember("api_callbacks") && !request_meta_data_json["api_callbacks"].empty())
@@ -382,14 +1000,22 @@ void MultiverseServer::start()
                 }
             }
 
-            if ((strcmp(request_world_name.c_str(), world_name.c_str()) != 0 || strcmp(request_simulation_name.c_str(), simulation_name.c_str()) != 0) && worlds[request_world_name].simulations.count(request_simulation_name) > 0)
+            if (strcmp(request_world_name.c_str(), world_name.c_str()) != 0 || strcmp(request_simulation_name.c_str(), simulation_name.c_str()) != 0)
             {
                 wait_for_other_send_data();
             }
 
-            mtx.lock();
-            bind_send_data();
-            mtx.unlock();
+            {
+                Simulation &simulation = worlds[world_name].simulations[simulation_name];
+                simulation.mtx.lock();
+                bind_send_data();
+                simulation.mtx.unlock();
+            }
+
+            if (worlds[world_name].is_double_buffered)
+            {
+                commit_epoch();
+            }
 
             flag = EMultiverseServerState::BindReceiveData;
             break;
@@ -399,12 +1025,42 @@ void MultiverseServer::start()
         {
             wait_for_receive_data();
 
-            mtx.lock();
+            update_receive_rates();
+            if (!is_receive_due)
+            {
+                flag = EMultiverseServerState::SendReceiveData;
+                break;
+            }
+
+            if (is_double_buffered)
+            {
+                bind_receive_epoch_data();
+
+                flag = EMultiverseServerState::SendReceiveData;
+                break;
+            }
+
+            if (dependency_version != worlds[world_name].senders_version)
+            {
+                mtx.lock();
+                bind_dependencies();
+                mtx.unlock();
+            }
+
+            for (std::mutex *dependency_mtx : dependency_mtxs)
+            {
+                dependency_mtx->lock();
+            }
+
             compute_cumulative_data();
-            mtx.unlock();
 
             bind_receive_data();
 
+            for (std::vector<std::mutex *>::reverse_iterator dependency_mtx_it = dependency_mtxs.rbegin(); dependency_mtx_it != dependency_mtxs.rend(); ++dependency_mtx_it)
+            {
+                (*dependency_mtx_it)->unlock();
+            }
+
             flag = EMultiverseServerState::SendReceiveData;
             break;
         }
@@ -420,7 +1076,7 @@ void MultiverseServer::start()
             }
             else
             {
-                if ((strcmp(request_world_name.c_str(), world_name.c_str()) != 0 || strcmp(request_simulation_name.c_str(), simulation_name.c_str()) != 0) && worlds[request_world_name].simulations.count(request_simulation_name) > 0)
+                if (strcmp(request_world_name.c_str(), world_name.c_str()) != 0 || strcmp(request_simulation_name.c_str(), simulation_name.c_str()) != 0)
                 {
                     wait_for_other_send_data();
                 }
@@ -494,6 +1150,24 @@ EMultiverseServerState MultiverseServer::receive_data()
                 printf("[Server] Received close signal at socket %s.\n", socket_addr.c_str());
                 send_response_meta_data();
                 worlds[world_name].simulations[simulation_name].meta_data_state = EMetaDataState::Normal;
+
+                mtx.lock();
+                for (std::pair<const std::string, std::map<std::string, std::set<std::string>>> &object_senders : worlds[world_name].senders)
+                {
+                    for (std::pair<const std::string, std::set<std::string>> &attribute_senders : object_senders.second)
+                    {
+                        attribute_senders.second.erase(simulation_name);
+                    }
+                }
+                worlds[world_name].senders_version++;
+
+                World &world = worlds[world_name];
+                world.epoch_mtx.lock();
+                remove_epoch_sender(world, simulation_name);
+                world.double_buffered_simulations.erase(simulation_name);
+                world.is_double_buffered = !world.double_buffered_simulations.empty();
+                world.epoch_mtx.unlock();
+                mtx.unlock();
                 return EMultiverseServerState::ReceiveRequestMetaData;
             }
             else if (message_spec_int == 1 && request_array_size == 2)
@@ -507,6 +1181,10 @@ EMultiverseServerState MultiverseServer::receive_data()
                     receive_buffer.buffer_double.data_vec.clear();
                     receive_buffer.buffer_uint8_t.data_vec.clear();
                     receive_buffer.buffer_uint16_t.data_vec.clear();
+                    send_buffer.buffer_float.data_vec.clear();
+                    send_buffer.buffer_half.data_vec.clear();
+                    receive_buffer.buffer_float.data_vec.clear();
+                    receive_buffer.buffer_half.data_vec.clear();
                     return EMultiverseServerState::BindObjects;
                 }
                 else
@@ -514,10 +1192,13 @@ EMultiverseServerState MultiverseServer::receive_data()
                     throw std::invalid_argument("[Server] Received invalid message [" + request_array[1].to_string() + "] at socket " + socket_addr + ".");
                 }
             }
-            else if (message_spec_int == 2 && request_array_size == 2 ||
-                     message_spec_int == 3 && request_array_size == 3 ||
-                     message_spec_int == 4 && request_array_size == 4 ||
-                     message_spec_int == 5 && request_array_size == 5)
+            else if (message_spec_int == history_message_spec && request_array_size == 2)
+            {
+                send_history(request_array[1].to_string());
+                return flag;
+            }
+            else if ((message_spec_int >= 2 && (int)request_array_size == message_spec_int) ||
+                     (message_spec_int > 2 + delta_message_spec_offset && (int)request_array_size == message_spec_int - delta_message_spec_offset))
             {
                 memcpy(&worlds[world_name].time, request_array[1].data(), sizeof(double));
 
@@ -526,59 +1207,32 @@ EMultiverseServerState MultiverseServer::receive_data()
                     throw std::invalid_argument("[Server] Received invalid message [time = " + std::to_string(worlds[world_name].time) + "] at socket " + socket_addr + ".");
                 }
 
-                if (message_spec_int == 3 && request_array_size == 3)
+                if (request_array_size != 2 + get_buffer_count(send_buffer))
                 {
-                    if (send_buffer.buffer_double.size > 0 && send_buffer.buffer_uint8_t.size == 0 && send_buffer.buffer_uint16_t.size == 0)
-                    {
-                        memcpy(send_buffer.buffer_double.data, request_array[2].data(), send_buffer.buffer_double.size * sizeof(double));
-                    }
-                    else if (send_buffer.buffer_double.size == 0 && send_buffer.buffer_uint8_t.size > 0 && send_buffer.buffer_uint16_t.size == 0)
-                    {
-                        memcpy(send_buffer.buffer_uint8_t.data, request_array[2].data(), send_buffer.buffer_uint8_t.size * sizeof(uint8_t));
-                    }
-                    else if (send_buffer.buffer_double.size == 0 && send_buffer.buffer_uint8_t.size == 0 && send_buffer.buffer_uint16_t.size > 0)
-                    {
-                        memcpy(send_buffer.buffer_uint16_t.data, request_array[2].data(), send_buffer.buffer_uint16_t.size * sizeof(uint16_t));
-                    }
-                    else
-                    {
-                        throw std::invalid_argument("[Server] Received invalid message [message_spec_int = " + std::to_string(message_spec_int) + ", request_array_size = " + std::to_string(request_array_size) + "] at socket " + socket_addr + ".");
-                    }
+                    throw std::invalid_argument("[Server] Received invalid message [message_spec_int = " + std::to_string(message_spec_int) + ", request_array_size = " + std::to_string(request_array_size) + "] at socket " + socket_addr + ".");
                 }
-                else if (message_spec_int == 4 && request_array_size == 4)
+
+                const bool is_delta_frame = message_spec_int > 2 + delta_message_spec_offset;
+                size_t message_index = 2;
+                if (send_buffer.buffer_double.size > 0)
                 {
-                    if (send_buffer.buffer_double.size > 0 && send_buffer.buffer_uint8_t.size > 0 && send_buffer.buffer_uint16_t.size == 0)
-                    {
-                        memcpy(send_buffer.buffer_double.data, request_array[2].data(), send_buffer.buffer_double.size * sizeof(double));
-                        memcpy(send_buffer.buffer_uint8_t.data, request_array[3].data(), send_buffer.buffer_uint8_t.size * sizeof(uint8_t));
-                    }
-                    else if (send_buffer.buffer_double.size > 0 && send_buffer.buffer_uint8_t.size == 0 && send_buffer.buffer_uint16_t.size > 0)
-                    {
-                        memcpy(send_buffer.buffer_double.data, request_array[2].data(), send_buffer.buffer_double.size * sizeof(double));
-                        memcpy(send_buffer.buffer_uint16_t.data, request_array[3].data(), send_buffer.buffer_uint16_t.size * sizeof(uint16_t));
-                    }
-                    else if (send_buffer.buffer_double.size == 0 && send_buffer.buffer_uint8_t.size > 0 && send_buffer.buffer_uint16_t.size > 0)
-                    {
-                        memcpy(send_buffer.buffer_uint8_t.data, request_array[2].data(), send_buffer.buffer_uint8_t.size * sizeof(uint8_t));
-                        memcpy(send_buffer.buffer_uint16_t.data, request_array[3].data(), send_buffer.buffer_uint16_t.size * sizeof(uint16_t));
-                    }
-                    else
-                    {
-                        throw std::invalid_argument("[Server] Received invalid message [message_spec_int = " + std::to_string(message_spec_int) + ", request_array_size = " + std::to_string(request_array_size) + "] at socket " + socket_addr + ".");
-                    }
+                    unpack_message(send_buffer.buffer_double, request_array[message_index++], is_delta_frame, socket_addr);
                 }
-                else if (message_spec_int == 5 && request_array_size == 5)
+                if (send_buffer.buffer_uint8_t.size > 0)
                 {
-                    if (send_buffer.buffer_double.size > 0 && send_buffer.buffer_uint8_t.size > 0 && send_buffer.buffer_uint16_t.size > 0)
-                    {
-                        memcpy(send_buffer.buffer_double.data, request_array[2].data(), send_buffer.buffer_double.size * sizeof(double));
-                        memcpy(send_buffer.buffer_uint8_t.data, request_array[3].data(), send_buffer.buffer_uint8_t.size * sizeof(uint8_t));
-                        memcpy(send_buffer.buffer_uint16_t.data, request_array[4].data(), send_buffer.buffer_uint16_t.size * sizeof(uint16_t));
-                    }
-                    else
-                    {
-                        throw std::invalid_argument("[Server] Received invalid message [message_spec_int = " + std::to_string(message_spec_int) + ", request_array_size = " + std::to_string(request_array_size) + "] at socket " + socket_addr + ".");
-                    }
+                    unpack_message(send_buffer.buffer_uint8_t, request_array[message_index++], is_delta_frame, compression_uint8_t, socket_addr);
+                }
+                if (send_buffer.buffer_uint16_t.size > 0)
+                {
+                    unpack_message(send_buffer.buffer_uint16_t, request_array[message_index++], is_delta_frame, compression_uint16_t, socket_addr);
+                }
+                if (send_buffer.buffer_float.size > 0)
+                {
+                    unpack_message(send_buffer.buffer_float, request_array[message_index++], is_delta_frame, socket_addr);
+                }
+                if (send_buffer.buffer_half.size > 0)
+                {
+                    unpack_message(send_buffer.buffer_half, request_array[message_index++], is_delta_frame, socket_addr);
                 }
                 return EMultiverseServerState::BindSendData;
             }
@@ -692,27 +1346,146 @@ void MultiverseServer::bind_meta_data()
         }
     }
 
-    worlds[world_name].simulations[simulation_name].request_meta_data_json = request_meta_data_json;
-    EMetaDataState &meta_data_state = worlds[world_name].simulations[simulation_name].meta_data_state;
-    if (request_simulation_name == simulation_name && meta_data_state == EMetaDataState::WaitAfterOtherSendRequestMetaData)
-    {
-        meta_data_state = EMetaDataState::WaitAfterOtherNormal;
+    worlds[world_name].simulations[simulation_name].request_meta_data_json = request_meta_data_json;
+    EMetaDataState &meta_data_state = worlds[world_name].simulations[simulation_name].meta_data_state;
+    if (request_simulation_name == simulation_name && meta_data_state == EMetaDataState::WaitAfterOtherSendRequestMetaData)
+    {
+        meta_data_state = EMetaDataState::WaitAfterOtherNormal;
+    }
+    else if (request_simulation_name != simulation_name || meta_data_state != EMetaDataState::WaitAfterOtherNormal)
+    {
+        meta_data_state = EMetaDataState::Normal;
+    }
+
+    const std::string length_unit = meta_data.isMember("length_unit") ? meta_data["length_unit"].asString() : "m";
+    const std::string angle_unit = meta_data.isMember("angle_unit") ? meta_data["angle_unit"].asString() : "rad";
+    const std::string handedness = meta_data.isMember("handedness") ? meta_data["handedness"].asString() : "rhs";
+    const std::string mass_unit = meta_data.isMember("mass_unit") ? meta_data["mass_unit"].asString() : "kg";
+    const std::string time_unit = meta_data.isMember("time_unit") ? meta_data["time_unit"].asString() : "s";
+
+    receive_period = 0.0;
+    receive_attribute_periods.clear();
+    if (meta_data.isMember("rate_hz"))
+    {
+        const Json::Value &rate_hz = meta_data["rate_hz"];
+        if (rate_hz.isObject())
+        {
+            for (const std::string &attribute_name : rate_hz.getMemberNames())
+            {
+                if (rate_hz[attribute_name].isNumeric() && rate_hz[attribute_name].asDouble() > 0.0)
+                {
+                    receive_attribute_periods[attribute_name] = 1.0 / rate_hz[attribute_name].asDouble();
+                }
+            }
+        }
+        else if (rate_hz.isNumeric() && rate_hz.asDouble() > 0.0)
+        {
+            receive_period = 1.0 / rate_hz.asDouble();
+        }
+    }
+
+    is_double_buffered = meta_data.isMember("double_buffered") && meta_data["double_buffered"].asBool();
+
+    is_delta_encoding = meta_data.isMember("delta_encoding") && meta_data["delta_encoding"].asBool();
+
+    compression_uint8_t = ECompression::None;
+    compression_uint16_t = ECompression::None;
+    if (meta_data.isMember("compression"))
+    {
+        const Json::Value &compression = meta_data["compression"];
+        if (!compression.isObject() ||
+            !get_compression(compression["rgb"].asString(), compression_uint8_t) ||
+            compression_uint8_t == ECompression::DeltaBitpack ||
+            !get_compression(compression["depth"].asString(), compression_uint16_t))
+        {
+            throw std::invalid_argument("[Server] Request meta data at socket " + socket_addr + " has invalid compression " + compression.toStyledString() + ".");
+        }
+    }
+
+    history_size = meta_data.isMember("history_size") ? meta_data["history_size"].asUInt64() : 0;
+
+    interest_region = InterestRegion();
+    if (meta_data.isMember("interest"))
+    {
+        const Json::Value &interest = meta_data["interest"];
+        const bool is_box = interest["min"].isArray() && interest["min"].size() == 3 && interest["max"].isArray() && interest["max"].size() == 3;
+        const bool is_sphere = interest["radius"].isNumeric() && ((interest["center"].isArray() && interest["center"].size() == 3) || interest["object"].isString());
+        if (!is_box && !is_sphere)
+        {
+            throw std::invalid_argument("[Server] Request meta data at socket " + socket_addr + " has invalid interest " + interest.toStyledString() + ".");
+        }
+        interest_region.is_enabled = true;
+        interest_region.is_box = is_box;
+        // The objects outside of the region keep their values, so delta frames only carry the objects inside
+        is_delta_encoding = !meta_data.isMember("delta_encoding") || meta_data["delta_encoding"].asBool();
+        for (Json::ArrayIndex i = 0; i < 3; i++)
+        {
+            interest_region.min[i] = is_box ? interest["min"][i].asDouble() : 0.0;
+            interest_region.max[i] = is_box ? interest["max"][i].asDouble() : 0.0;
+            interest_region.center[i] = interest["center"].isArray() ? interest["center"][i].asDouble() : 0.0;
+        }
+        interest_region.radius = is_box ? 0.0 : interest["radius"].asDouble();
+        interest_region.object_name = is_box ? "" : interest["object"].asString();
+        if (interest["cell_size"].isNumeric() && interest["cell_size"].asDouble() > 0.0)
+        {
+            interest_region.cell_size = interest["cell_size"].asDouble();
+        }
+    }
+
+    precision = "double";
+    attribute_precisions.clear();
+    if (meta_data.isMember("precision"))
+    {
+        const Json::Value &precision_json = meta_data["precision"];
+        if (precision_json.isObject())
+        {
+            for (const std::string &attribute_name : precision_json.getMemberNames())
+            {
+                attribute_precisions[attribute_name] = precision_json[attribute_name].asString();
+            }
+        }
+        else
+        {
+            precision = precision_json.asString();
+        }
+
+        attribute_precisions[""] = precision;
+        for (const std::pair<const std::string, std::string> &attribute_precision : attribute_precisions)
+        {
+            if (attribute_precision.second != "double" && attribute_precision.second != "float" && attribute_precision.second != "half")
+            {
+                throw std::invalid_argument("[Server] Request meta data at socket " + socket_addr + " has invalid precision " + precision_json.toStyledString() + ".");
+            }
+        }
+        attribute_precisions.erase("");
     }
-    else if (request_simulation_name != simulation_name || meta_data_state != EMetaDataState::WaitAfterOtherNormal)
     {
-        meta_data_state = EMetaDataState::Normal;
+        // The senders of the world commit epochs while any of its sessions is double buffered
+        std::lock_guard<std::mutex> lock(mtx);
+        World &world = worlds[world_name];
+        std::lock_guard<std::mutex> epoch_lock(world.epoch_mtx);
+        if (is_double_buffered)
+        {
+            world.double_buffered_simulations.insert(simulation_name);
+        }
+        else
+        {
+            world.double_buffered_simulations.erase(simulation_name);
+        }
+        world.is_double_buffered = !world.double_buffered_simulations.empty();
     }
 
-    const std::string length_unit = meta_data.isMember("length_unit") ? meta_data["length_unit"].asString() : "m";
-    const std::string angle_unit = meta_data.isMember("angle_unit") ? meta_data["angle_unit"].asString() : "rad";
-    const std::string handedness = meta_data.isMember("handedness") ? meta_data["handedness"].asString() : "rhs";
-    const std::string mass_unit = meta_data.isMember("mass_unit") ? meta_data["mass_unit"].asString() : "kg";
-    const std::string time_unit = meta_data.isMember("time_unit") ? meta_data["time_unit"].asString() : "s";
-
     std::map<EAttribute, std::vector<double>> &conversion_map_double = conversion_map.conversion_map_double;
-    for (const std::pair<const std::string, std::pair<EAttribute, std::vector<double>>> &attribute : attribute_map_double)
     {
-        conversion_map_double.emplace(attribute.second);
+        // Tensors are registered into the attribute map at runtime by other sessions
+        std::lock_guard<std::mutex> lock(mtx);
+        for (const std::pair<const std::string, std::pair<EAttribute, std::vector<double>>> &attribute : attribute_map_double)
+        {
+            if (attribute.second.first != EAttribute::Tensor)
+            {
+                conversion_map_double.emplace(attribute.second);
+            }
+        }
     }
 
     std::for_each(conversion_map_double[EAttribute::Time].begin(), conversion_map_double[EAttribute::Time].end(),
@@ -798,6 +1571,7 @@ void MultiverseServer::bind_meta_data()
 
     conversion_map_double[EAttribute::OdometricVelocity] = conversion_map_double[EAttribute::RelativeVelocity];
 
+    conversion_map_double.erase(EAttribute::Tensor);
     for (std::pair<const EAttribute, std::vector<double>> &conversion_scale : conversion_map_double)
     {
         std::vector<double>::iterator conversion_scale_it = conversion_scale.second.begin();
@@ -808,29 +1582,94 @@ void MultiverseServer::bind_meta_data()
         }
     }
 
-    std::map<EAttribute, std::vector<uint8_t>> &conversion_map_uint8_t = conversion_map.conversion_map_uint8_t;
-    for (const std::pair<const std::string, std::pair<EAttribute, std::vector<uint8_t>>> &attribute : attribute_map_uint8_t)
+    response_meta_data_json.clear();
+    response_meta_data_json["meta_data"] = meta_data;
+    response_meta_data_json["time"] = worlds[world_name].time * unit_scale[time_unit];
+}
+
+std::vector<std::pair<double *, double>> &MultiverseServer::get_data_vec_double(Buffer &buffer, const std::string &attribute_name)
+{
+    const std::string &attribute_precision = attribute_precisions.count(attribute_name) > 0 ? attribute_precisions[attribute_name] : precision;
+    if (attribute_precision == "float")
     {
-        conversion_map_uint8_t.emplace(attribute.second);
+        return buffer.buffer_float.data_vec;
     }
+    if (attribute_precision == "half")
+    {
+        return buffer.buffer_half.data_vec;
+    }
+    return buffer.buffer_double.data_vec;
+}
 
-    std::map<EAttribute, std::vector<uint16_t>> &conversion_map_uint16_t = conversion_map.conversion_map_uint16_t;
-    for (const std::pair<const std::string, std::pair<EAttribute, std::vector<uint16_t>>> &attribute : attribute_map_uint16_t)
+void MultiverseServer::bind_tensor_attributes()
+{
+    const Json::Value &tensors = request_meta_data_json["meta_data"]["tensors"];
+    if (tensors.isObject())
     {
-        conversion_map_uint16_t.emplace(attribute.second);
+        for (const std::string &attribute_name : tensors.getMemberNames())
+        {
+            const Json::Value &tensor = tensors[attribute_name];
+            const std::string dtype = tensor["dtype"].asString();
+            size_t size = tensor["shape"].isArray() && !tensor["shape"].empty() ? 1 : 0;
+            for (const Json::Value &dim : tensor["shape"])
+            {
+                size *= dim.isIntegral() && dim.asInt64() > 0 ? dim.asUInt64() : 0;
+            }
+
+            bool is_valid = size > 0;
+            if (is_valid && dtype == "double")
+            {
+                is_valid = !has_attribute(attribute_map_uint8_t, attribute_name) && !has_attribute(attribute_map_uint16_t, attribute_name) && register_tensor_attribute(attribute_map_double, attribute_name, size);
+            }
+            else if (is_valid && dtype == "uint8")
+            {
+                is_valid = !has_attribute(attribute_map_double, attribute_name) && !has_attribute(attribute_map_uint16_t, attribute_name) && register_tensor_attribute(attribute_map_uint8_t, attribute_name, size);
+            }
+            else if (is_valid && dtype == "uint16")
+            {
+                is_valid = !has_attribute(attribute_map_double, attribute_name) && !has_attribute(attribute_map_uint8_t, attribute_name) && register_tensor_attribute(attribute_map_uint16_t, attribute_name, size);
+            }
+            else
+            {
+                is_valid = false;
+            }
+
+            if (!is_valid)
+            {
+                throw std::invalid_argument("[Server] Tensor [" + attribute_name + "] at socket " + socket_addr + " has an invalid dtype or shape, or conflicts with another attribute.");
+            }
+        }
     }
 
-    response_meta_data_json.clear();
-    response_meta_data_json["meta_data"] = meta_data;
-    response_meta_data_json["time"] = worlds[world_name].time * unit_scale[time_unit];
+    fit_tensor_conversion(conversion_map.conversion_map_double, attribute_map_double, 1.0);
+    fit_tensor_conversion(conversion_map.conversion_map_uint8_t, attribute_map_uint8_t, (uint8_t)0);
+    fit_tensor_conversion(conversion_map.conversion_map_uint16_t, attribute_map_uint16_t, (uint16_t)0);
 }
 
 void MultiverseServer::bind_send_objects()
 {
     send_objects_json = request_meta_data_json["send"];
-    std::map<std::string, Object> &objects = worlds[world_name].objects;
-    Simulation &simulation = worlds[world_name].simulations[simulation_name];
+    World &world = worlds[world_name];
+    std::map<std::string, Object> &objects = world.objects;
+    Simulation &simulation = world.simulations[simulation_name];
+
+    for (std::pair<const std::string, std::map<std::string, std::set<std::string>>> &object_senders : world.senders)
+    {
+        for (std::pair<const std::string, std::set<std::string>> &attribute_senders : object_senders.second)
+        {
+            attribute_senders.second.erase(simulation_name);
+        }
+    }
 
+    send_positions.clear();
+    send_attributes.clear();
+    send_cumulative_attributes.clear();
+    if (history_size > world.history_size)
+    {
+        world.history_mtx.lock();
+        world.history_size = history_size;
+        world.history_mtx.unlock();
+    }
     for (const std::string &object_name : send_objects_json.getMemberNames())
     {
         response_meta_data_json["send"][object_name] = Json::objectValue;
@@ -839,7 +1678,10 @@ void MultiverseServer::bind_send_objects()
         for (const Json::Value &attribute_json : send_objects_json[object_name])
         {
             const std::string &attribute_name = attribute_json.asString();
+            world.senders[object_name][attribute_name].insert(simulation_name);
+            world.attribute_objects[attribute_name].insert(object_name);
             Attribute &attribute = object.attributes[attribute_name];
+            std::vector<std::pair<double *, double>> &data_vec_double = get_data_vec_double(send_buffer, attribute_name);
             if (cumulative_attribute_names.count(attribute_name) == 0)
             {
                 if (attribute.attribute_double.data.size() == 0)
@@ -849,7 +1691,7 @@ void MultiverseServer::bind_send_objects()
                     {
                         double *data = &attribute.attribute_double.data[i];
                         const double conversion = conversion_map.conversion_map_double[attribute_map_double[attribute_name].first][i];
-                        send_buffer.buffer_double.data_vec.emplace_back(data, conversion);
+                        data_vec_double.emplace_back(data, conversion);
                         response_meta_data_json["send"][object_name][attribute_name].append(*data * conversion);
                     }
                 }
@@ -863,7 +1705,7 @@ void MultiverseServer::bind_send_objects()
                     {
                         double *data = &attribute.attribute_double.data[i];
                         const double conversion = conversion_map.conversion_map_double[attribute_map_double[attribute_name].first][i];
-                        send_buffer.buffer_double.data_vec.emplace_back(data, conversion);
+                        data_vec_double.emplace_back(data, conversion);
                         response_meta_data_json["send"][object_name][attribute_name].append(*data * conversion);
                     }
                 }
@@ -917,10 +1759,42 @@ void MultiverseServer::bind_send_objects()
                         response_meta_data_json["send"][object_name][attribute_name].append(*data >> conversion);
                     }
                 }
+                if (attribute_name == "position" && attribute.attribute_double.data.size() == 3)
+                {
+                    send_positions.emplace_back(object_name, attribute.attribute_double.data.data());
+                }
+                send_attributes.push_back(&attribute);
+                if (attribute.attribute_double.snapshot_data.size() != attribute.attribute_double.data.size() ||
+                    attribute.attribute_uint8_t.snapshot_data.size() != attribute.attribute_uint8_t.data.size() ||
+                    attribute.attribute_uint16_t.snapshot_data.size() != attribute.attribute_uint16_t.data.size())
+                {
+                    // The query server holds snapshot_layout_mtx while it copies, so the snapshot is only reallocated
+                    // here during the handshake and never while the senders step
+                    world.snapshot_layout_mtx.lock();
+                    world.snapshot_mtx.lock();
+                    attribute.attribute_double.snapshot_data = attribute.attribute_double.data;
+                    attribute.attribute_uint8_t.snapshot_data = attribute.attribute_uint8_t.data;
+                    attribute.attribute_uint16_t.snapshot_data = attribute.attribute_uint16_t.data;
+                    world.snapshot_attributes[{object_name, attribute_name}] = &attribute;
+                    world.snapshot_mtx.unlock();
+                    world.snapshot_layout_mtx.unlock();
+
+                    snapshot_worlds_mtx.lock();
+                    snapshot_worlds[world_name] = &world;
+                    snapshot_worlds_mtx.unlock();
+                }
             }
             else
             {
+                send_cumulative_attributes.push_back(&attribute);
+
+                // commit_epoch looks up the simulation data under the epoch lock only
+                world.epoch_mtx.lock();
                 std::vector<double> &simulation_data_double = attribute.attribute_double.simulation_data[simulation_name];
+                std::vector<uint8_t> &simulation_data_uint8_t = attribute.attribute_uint8_t.simulation_data[simulation_name];
+                std::vector<uint16_t> &simulation_data_uint16_t = attribute.attribute_uint16_t.simulation_data[simulation_name];
+                world.epoch_mtx.unlock();
+
                 if (simulation_data_double.size() == 0)
                 {
                     simulation_data_double = attribute_map_double[attribute_name].second;
@@ -929,11 +1803,10 @@ void MultiverseServer::bind_send_objects()
                 {
                     double *data = &simulation_data_double[i];
                     const double conversion = conversion_map.conversion_map_double[attribute_map_double[attribute_name].first][i];
-                    send_buffer.buffer_double.data_vec.emplace_back(data, conversion);
+                    data_vec_double.emplace_back(data, conversion);
                     response_meta_data_json["send"][object_name][attribute_name].append(*data * conversion);
                 }
 
-                std::vector<uint8_t> &simulation_data_uint8_t = attribute.attribute_uint8_t.simulation_data[simulation_name];
                 if (simulation_data_uint8_t.size() == 0)
                 {
                     simulation_data_uint8_t = attribute_map_uint8_t[attribute_name].second;
@@ -946,7 +1819,6 @@ void MultiverseServer::bind_send_objects()
                     response_meta_data_json["send"][object_name][attribute_name].append(*data >> conversion);
                 }
 
-                std::vector<uint16_t> &simulation_data_uint16_t = attribute.attribute_uint16_t.simulation_data[simulation_name];
                 if (simulation_data_uint16_t.size() == 0)
                 {
                     simulation_data_uint16_t = attribute_map_uint16_t[attribute_name].second;
@@ -961,21 +1833,35 @@ void MultiverseServer::bind_send_objects()
             }
         }
     }
+
+    // The epochs of the world wait for every simulation that sends
+    world.epoch_mtx.lock();
+    remove_epoch_sender(world, simulation_name);
+    if (!send_attributes.empty() || !send_cumulative_attributes.empty())
+    {
+        world.epoch_send_attributes[simulation_name] = send_attributes;
+        world.epoch_send_cumulative_attributes[simulation_name] = send_cumulative_attributes;
+    }
+    world.epoch_mtx.unlock();
+
+    world.senders_version++;
 }
 
 void MultiverseServer::validate_meta_data()
 {
     receive_objects_json = request_meta_data_json["receive"];
 
+    World &world = worlds[world_name];
     if (receive_objects_json.isMember("") &&
         std::find(receive_objects_json[""].begin(), receive_objects_json[""].end(), "") != receive_objects_json[""].end())
     {
+        // Wildcards are expanded from the sent attributes, which is the index wait_for_objects waits on
         receive_objects_json = Json::objectValue;
-        for (const std::pair<std::string, Object> &object : worlds[world_name].objects)
+        for (const std::pair<const std::string, std::set<std::string>> &attribute_objects : world.attribute_objects)
         {
-            for (const std::pair<std::string, Attribute> &attribute_pair : object.second.attributes)
+            for (const std::string &object_name : attribute_objects.second)
             {
-                receive_objects_json[object.first].append(attribute_pair.first);
+                receive_objects_json[object_name].append(attribute_objects.first);
             }
         }
         return;
@@ -994,9 +1880,12 @@ void MultiverseServer::validate_meta_data()
                 }
 
                 receive_objects_json[object_name] = Json::arrayValue;
-                for (const std::pair<std::string, Attribute> &attribute_pair : worlds[world_name].objects[object_name].attributes)
+                for (const std::pair<const std::string, std::set<std::string>> &attribute_objects : world.attribute_objects)
                 {
-                    receive_objects_json[object_name].append(attribute_pair.first);
+                    if (attribute_objects.second.count(object_name) > 0)
+                    {
+                        receive_objects_json[object_name].append(attribute_objects.first);
+                    }
                 }
                 break;
             }
@@ -1006,12 +1895,14 @@ void MultiverseServer::validate_meta_data()
             for (const Json::Value &attribute_json : request_meta_data_json["receive"][object_name])
             {
                 const std::string &attribute_name = attribute_json.asString();
-                for (const std::pair<std::string, Object> &object_pair : worlds[world_name].objects)
+                std::map<std::string, std::set<std::string>>::const_iterator attribute_objects_it = world.attribute_objects.find(attribute_name);
+                if (attribute_objects_it == world.attribute_objects.end())
                 {
-                    if (object_pair.second.attributes.count(attribute_name) > 0)
-                    {
-                        receive_objects_json[object_pair.first].append(attribute_name);
-                    }
+                    continue;
+                }
+                for (const std::string &object_name_match : attribute_objects_it->second)
+                {
+                    receive_objects_json[object_name_match].append(attribute_name);
                 }
             }
             receive_objects_json.removeMember(object_name);
@@ -1022,33 +1913,50 @@ void MultiverseServer::validate_meta_data()
 
 void MultiverseServer::wait_for_objects()
 {
+    std::vector<std::pair<std::string, std::string>> missing_objects;
+    for (const std::string &object_name : receive_objects_json.getMemberNames())
+    {
+        for (const Json::Value &attribute_json : receive_objects_json[object_name])
+        {
+            missing_objects.emplace_back(object_name, attribute_json.asString());
+        }
+    }
+
     double start = get_time_now();
     double now = get_time_now();
-    bool found_all_objects = true;
-    do
+    World &world = worlds[world_name];
+    while (!should_shut_down && !missing_objects.empty())
     {
-        found_all_objects = true;
         now = get_time_now();
-        for (const std::string &object_name : receive_objects_json.getMemberNames())
+        const bool should_print = now - start > 1;
+
         {
-            for (const Json::Value &attribute_json : receive_objects_json[object_name])
+            // Only the objects that are still missing are looked up again, the senders bind them under mtx
+            std::lock_guard<std::mutex> lock(mtx);
+            std::vector<std::pair<std::string, std::string>>::iterator missing_object_it = missing_objects.begin();
+            while (missing_object_it != missing_objects.end())
             {
-                const std::string &attribute_name = attribute_json.asString();
-                if ((worlds[world_name].objects.count(object_name) == 0 || worlds[world_name].objects[object_name].attributes.count(attribute_name) == 0))
+                const std::string &object_name = missing_object_it->first;
+                const std::string &attribute_name = missing_object_it->second;
+                std::map<std::string, std::set<std::string>>::const_iterator attribute_objects_it = world.attribute_objects.find(attribute_name);
+                if (attribute_objects_it != world.attribute_objects.end() && attribute_objects_it->second.count(object_name) > 0)
                 {
-                    found_all_objects = false;
-                    if (now - start > 1)
-                    {
-                        printf("[Server] Socket %s is waiting for [%s][%s][%s] to be declared.\n", socket_addr.c_str(), world_name.c_str(), object_name.c_str(), attribute_name.c_str());
-                    }
+                    missing_object_it = missing_objects.erase(missing_object_it);
+                    continue;
+                }
+                if (should_print)
+                {
+                    printf("[Server] Socket %s is waiting for [%s][%s][%s] to be declared.\n", socket_addr.c_str(), world_name.c_str(), object_name.c_str(), attribute_name.c_str());
                 }
+                ++missing_object_it;
             }
         }
-        if (now - start > 1)
+        if (should_print)
         {
             start = now;
         }
-    } while (!should_shut_down && !found_all_objects);
+        std::this_thread::yield();
+    }
 }
 
 void MultiverseServer::bind_receive_objects()
@@ -1056,15 +1964,47 @@ void MultiverseServer::bind_receive_objects()
     std::map<std::string, Object> &objects = worlds[world_name].objects;
     Simulation &simulation = worlds[world_name].simulations[simulation_name];
 
+    receive_buffer.buffer_double.decimated_ranges.clear();
+    receive_buffer.buffer_uint8_t.decimated_ranges.clear();
+    receive_buffer.buffer_uint16_t.decimated_ranges.clear();
+    receive_buffer.buffer_float.decimated_ranges.clear();
+    receive_buffer.buffer_half.decimated_ranges.clear();
+
+    interest_objects.clear();
+    interest_object_indices.clear();
+    if (interest_region.is_enabled)
+    {
+        enable_spatial_grid();
+    }
+
+    cumulative_attributes.clear();
+
+    // Tensors of other simulations may have been registered while waiting for the objects
+    fit_tensor_conversion(conversion_map.conversion_map_double, attribute_map_double, 1.0);
+    fit_tensor_conversion(conversion_map.conversion_map_uint8_t, attribute_map_uint8_t, (uint8_t)0);
+    fit_tensor_conversion(conversion_map.conversion_map_uint16_t, attribute_map_uint16_t, (uint16_t)0);
+
     for (const std::string &object_name : receive_objects_json.getMemberNames())
     {
         Object &object = objects[object_name];
         simulation.objects[object_name] = &object;
         response_meta_data_json["receive"][object_name] = Json::objectValue;
+        // Only objects with a position are filtered by the region of interest
+        const bool is_filtered = interest_region.is_enabled && object.attributes.count("position") > 0;
+        size_t object_index = 0;
+        if (is_filtered)
+        {
+            object_index = interest_objects.size();
+            interest_object_indices[object_name] = object_index;
+            interest_objects.push_back(object_name);
+        }
         for (const Json::Value &attribute_json : receive_objects_json[object_name])
         {
             const std::string attribute_name = attribute_json.asString();
             Attribute &attribute = worlds[world_name].objects[object_name].attributes[attribute_name];
+            CumulativeAttribute *cumulative_attribute = nullptr;
+            // commit_epoch reads the defaults of the cumulative attributes and the epoch data under the epoch lock only
+            worlds[world_name].epoch_mtx.lock();
             if (cumulative_attribute_names.count(attribute_name) > 0)
             {
                 if (attribute.attribute_double.data.size() == 0)
@@ -1082,31 +2022,225 @@ void MultiverseServer::bind_receive_objects()
                     attribute.attribute_uint16_t.data = attribute_map_uint16_t[attribute_name].second;
                     attribute.attribute_uint16_t.is_sent = true;
                 }
+
+                if (!is_double_buffered)
+                {
+                    // The sum of the senders is computed per session, the attribute data of the world stays the default
+                    cumulative_attribute = &cumulative_attributes[object_name][attribute_name];
+                    cumulative_attribute->cumulative_double.default_data = attribute_map_double[attribute_name].second;
+                    cumulative_attribute->cumulative_double.data = cumulative_attribute->cumulative_double.default_data;
+                    cumulative_attribute->cumulative_uint8_t.default_data = attribute_map_uint8_t[attribute_name].second;
+                    cumulative_attribute->cumulative_uint8_t.data = cumulative_attribute->cumulative_uint8_t.default_data;
+                    cumulative_attribute->cumulative_uint16_t.default_data = attribute_map_uint16_t[attribute_name].second;
+                    cumulative_attribute->cumulative_uint16_t.data = cumulative_attribute->cumulative_uint16_t.default_data;
+                }
             }
 
-            for (size_t i = 0; i < attribute.attribute_double.data.size(); i++)
+            if (is_double_buffered)
+            {
+                if (attribute.attribute_double.epoch_data.size() != attribute.attribute_double.data.size())
+                {
+                    attribute.attribute_double.epoch_data = attribute.attribute_double.data;
+                }
+                if (attribute.attribute_uint8_t.epoch_data.size() != attribute.attribute_uint8_t.data.size())
+                {
+                    attribute.attribute_uint8_t.epoch_data = attribute.attribute_uint8_t.data;
+                }
+                if (attribute.attribute_uint16_t.epoch_data.size() != attribute.attribute_uint16_t.data.size())
+                {
+                    attribute.attribute_uint16_t.epoch_data = attribute.attribute_uint16_t.data;
+                }
+            }
+            worlds[world_name].epoch_mtx.unlock();
+
+            const size_t start_double = receive_buffer.buffer_double.data_vec.size();
+            const size_t start_uint8_t = receive_buffer.buffer_uint8_t.data_vec.size();
+            const size_t start_uint16_t = receive_buffer.buffer_uint16_t.data_vec.size();
+            const size_t start_float = receive_buffer.buffer_float.data_vec.size();
+            const size_t start_half = receive_buffer.buffer_half.data_vec.size();
+            std::vector<std::pair<double *, double>> &data_vec_double = get_data_vec_double(receive_buffer, attribute_name);
+
+            std::vector<double> &data_double = cumulative_attribute != nullptr ? cumulative_attribute->cumulative_double.data : is_double_buffered ? attribute.attribute_double.epoch_data : attribute.attribute_double.data;
+            std::vector<uint8_t> &data_uint8_t = cumulative_attribute != nullptr ? cumulative_attribute->cumulative_uint8_t.data : is_double_buffered ? attribute.attribute_uint8_t.epoch_data : attribute.attribute_uint8_t.data;
+            std::vector<uint16_t> &data_uint16_t = cumulative_attribute != nullptr ? cumulative_attribute->cumulative_uint16_t.data : is_double_buffered ? attribute.attribute_uint16_t.epoch_data : attribute.attribute_uint16_t.data;
+            for (size_t i = 0; i < data_double.size(); i++)
             {
-                double *data = &attribute.attribute_double.data[i];
+                double *data = &data_double[i];
                 const double conversion = 1.0 / conversion_map.conversion_map_double[attribute_map_double[attribute_name].first][i];
-                receive_buffer.buffer_double.data_vec.emplace_back(data, conversion);
+                data_vec_double.emplace_back(data, conversion);
                 response_meta_data_json["receive"][object_name][attribute_name].append(*data * conversion);
             }
-            for (size_t i = 0; i < attribute.attribute_uint8_t.data.size(); i++)
+            for (size_t i = 0; i < data_uint8_t.size(); i++)
             {
-                uint8_t *data = &attribute.attribute_uint8_t.data[i];
+                uint8_t *data = &data_uint8_t[i];
                 const uint8_t conversion = conversion_map.conversion_map_uint8_t[attribute_map_uint8_t[attribute_name].first][i];
                 receive_buffer.buffer_uint8_t.data_vec.emplace_back(data, conversion);
                 response_meta_data_json["receive"][object_name][attribute_name].append(*data >> conversion);
             }
-            for (size_t i = 0; i < attribute.attribute_uint16_t.data.size(); i++)
+            for (size_t i = 0; i < data_uint16_t.size(); i++)
             {
-                uint16_t *data = &attribute.attribute_uint16_t.data[i];
+                uint16_t *data = &data_uint16_t[i];
                 const uint16_t conversion = conversion_map.conversion_map_uint16_t[attribute_map_uint16_t[attribute_name].first][i];
                 receive_buffer.buffer_uint16_t.data_vec.emplace_back(data, conversion);
                 response_meta_data_json["receive"][object_name][attribute_name].append(*data >> conversion);
             }
+
+            if (is_filtered || receive_attribute_periods.count(attribute_name) > 0)
+            {
+                const double period = receive_attribute_periods.count(attribute_name) > 0 ? receive_attribute_periods[attribute_name] : 0.0;
+                add_decimated_range(receive_buffer.buffer_double, start_double, period, is_filtered, object_index);
+                add_decimated_range(receive_buffer.buffer_uint8_t, start_uint8_t, period, is_filtered, object_index);
+                add_decimated_range(receive_buffer.buffer_uint16_t, start_uint16_t, period, is_filtered, object_index);
+                add_decimated_range(receive_buffer.buffer_float, start_float, period, is_filtered, object_index);
+                add_decimated_range(receive_buffer.buffer_half, start_half, period, is_filtered, object_index);
+            }
+        }
+    }
+    interest_object_visibilities.assign(interest_objects.size(), false);
+}
+
+void MultiverseServer::enable_spatial_grid()
+{
+    World &world = worlds[world_name];
+    SpatialGrid &spatial_grid = world.spatial_grid;
+    if (spatial_grid.is_enabled)
+    {
+        return;
+    }
+
+    // The positions that were sent before the grid is enabled are indexed once
+    spatial_grid.mtx.lock();
+    spatial_grid.cell_size = interest_region.cell_size;
+    for (std::pair<const std::string, Object> &object : world.objects)
+    {
+        std::map<std::string, Attribute>::iterator position_it = object.second.attributes.find("position");
+        if (position_it != object.second.attributes.end() && position_it->second.attribute_double.data.size() == 3)
+        {
+            update_spatial_grid(spatial_grid, object.first, position_it->second.attribute_double.data.data());
+        }
+    }
+    spatial_grid.is_enabled = true;
+    spatial_grid.mtx.unlock();
+}
+
+void MultiverseServer::update_interest()
+{
+    SpatialGrid &spatial_grid = worlds[world_name].spatial_grid;
+    double min[3];
+    double max[3];
+    double center[3];
+    std::vector<std::pair<std::string, const double *>> objects_inside;
+
+    spatial_grid.mtx.lock();
+    bool has_region = true;
+    if (interest_region.is_box)
+    {
+        std::copy(interest_region.min, interest_region.min + 3, min);
+        std::copy(interest_region.max, interest_region.max + 3, max);
+    }
+    else
+    {
+        if (interest_region.object_name.empty())
+        {
+            std::copy(interest_region.center, interest_region.center + 3, center);
+        }
+        else if (spatial_grid.positions.count(interest_region.object_name) > 0)
+        {
+            const double *position = spatial_grid.positions[interest_region.object_name];
+            std::copy(position, position + 3, center);
+        }
+        else
+        {
+            has_region = false;
+        }
+        for (size_t i = 0; i < 3; i++)
+        {
+            min[i] = center[i] - interest_region.radius;
+            max[i] = center[i] + interest_region.radius;
+        }
+    }
+    if (has_region)
+    {
+        query_spatial_grid(spatial_grid, min, max, objects_inside);
+    }
+
+    // Membership only changes for the objects that enter or leave the region
+    std::fill(interest_object_visibilities.begin(), interest_object_visibilities.end(), false);
+    const double radius_squared = interest_region.radius * interest_region.radius;
+    for (const std::pair<std::string, const double *> &object_inside : objects_inside)
+    {
+        std::map<std::string, size_t>::const_iterator object_index_it = interest_object_indices.find(object_inside.first);
+        if (object_index_it == interest_object_indices.end())
+        {
+            continue;
+        }
+        if (!interest_region.is_box)
+        {
+            const double *position = object_inside.second;
+            const double distance_squared = (position[0] - center[0]) * (position[0] - center[0]) + (position[1] - center[1]) * (position[1] - center[1]) + (position[2] - center[2]) * (position[2] - center[2]);
+            if (distance_squared > radius_squared)
+            {
+                continue;
+            }
+        }
+        interest_object_visibilities[object_index_it->second] = true;
+    }
+    spatial_grid.mtx.unlock();
+}
+
+void MultiverseServer::bind_dependencies()
+{
+    World &world = worlds[world_name];
+    std::set<std::string> &dependencies = world.simulations[simulation_name].dependencies;
+    dependencies.clear();
+    for (const std::string &object_name : receive_objects_json.getMemberNames())
+    {
+        if (world.senders.count(object_name) == 0)
+        {
+            continue;
+        }
+
+        for (const Json::Value &attribute_json : receive_objects_json[object_name])
+        {
+            const std::string attribute_name = attribute_json.asString();
+            if (world.senders[object_name].count(attribute_name) == 0)
+            {
+                continue;
+            }
+
+            for (const std::string &sender_name : world.senders[object_name][attribute_name])
+            {
+                if (sender_name != simulation_name)
+                {
+                    dependencies.insert(sender_name);
+                }
+            }
+        }
+    }
+
+    const std::set<std::string> no_sender_names;
+    for (std::pair<const std::string, std::map<std::string, CumulativeAttribute>> &object_cumulative_attributes : cumulative_attributes)
+    {
+        const std::string &object_name = object_cumulative_attributes.first;
+        for (std::pair<const std::string, CumulativeAttribute> &cumulative_attribute : object_cumulative_attributes.second)
+        {
+            const std::string &attribute_name = cumulative_attribute.first;
+            const Attribute &attribute = world.objects[object_name].attributes[attribute_name];
+            const std::set<std::string> &sender_names = world.senders.count(object_name) > 0 && world.senders[object_name].count(attribute_name) > 0 ? world.senders[object_name][attribute_name] : no_sender_names;
+            bind_cumulative_senders(cumulative_attribute.second.cumulative_double, attribute.attribute_double.simulation_data, sender_names);
+            bind_cumulative_senders(cumulative_attribute.second.cumulative_uint8_t, attribute.attribute_uint8_t.simulation_data, sender_names);
+            bind_cumulative_senders(cumulative_attribute.second.cumulative_uint16_t, attribute.attribute_uint16_t.simulation_data, sender_names);
         }
     }
+
+    // std::set is ordered, so every session locks its dependencies in the same order
+    dependency_mtxs.clear();
+    for (const std::string &dependency : dependencies)
+    {
+        dependency_mtxs.push_back(&world.simulations[dependency].mtx);
+    }
+
+    dependency_version = world.senders_version;
 }
 
 void MultiverseServer::wait_for_api_callbacks_response()
@@ -1231,25 +2365,74 @@ void MultiverseServer::init_send_and_receive_data()
     receive_buffer.buffer_uint8_t.data = (uint8_t *)calloc(receive_buffer.buffer_uint8_t.size, sizeof(uint8_t));
     receive_buffer.buffer_uint16_t.size = receive_buffer.buffer_uint16_t.data_vec.size();
     receive_buffer.buffer_uint16_t.data = (uint16_t *)calloc(receive_buffer.buffer_uint16_t.size, sizeof(uint16_t));
+    send_buffer.buffer_float.size = send_buffer.buffer_float.data_vec.size();
+    send_buffer.buffer_float.data = (float *)calloc(send_buffer.buffer_float.size, sizeof(float));
+    send_buffer.buffer_half.size = send_buffer.buffer_half.data_vec.size();
+    send_buffer.buffer_half.data = (uint16_t *)calloc(send_buffer.buffer_half.size, sizeof(uint16_t));
+    receive_buffer.buffer_float.size = receive_buffer.buffer_float.data_vec.size();
+    receive_buffer.buffer_float.data = (float *)calloc(receive_buffer.buffer_float.size, sizeof(float));
+    receive_buffer.buffer_half.size = receive_buffer.buffer_half.data_vec.size();
+    receive_buffer.buffer_half.data = (uint16_t *)calloc(receive_buffer.buffer_half.size, sizeof(uint16_t));
+    init_contiguous_ranges(send_buffer.buffer_float);
+    init_contiguous_ranges(send_buffer.buffer_half);
+    init_contiguous_ranges(receive_buffer.buffer_float);
+    init_contiguous_ranges(receive_buffer.buffer_half);
+
+    // The first frame after the buffers are reallocated is always a full frame
+    receive_buffer.buffer_double.last_data.clear();
+    receive_buffer.buffer_uint8_t.last_data.clear();
+    receive_buffer.buffer_uint16_t.last_data.clear();
+    receive_buffer.buffer_float.last_data.clear();
+    receive_buffer.buffer_half.last_data.clear();
 }
 
 void MultiverseServer::wait_for_other_send_data()
 {
+    Simulation *request_simulation;
+    bool is_dependency;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        std::map<std::string, World>::iterator request_world_it = worlds.find(request_world_name);
+        if (request_world_it == worlds.end())
+        {
+            return;
+        }
+        std::map<std::string, Simulation>::iterator request_simulation_it = request_world_it->second.simulations.find(request_simulation_name);
+        if (request_simulation_it == request_world_it->second.simulations.end())
+        {
+            return;
+        }
+        request_simulation = &request_simulation_it->second;
+
+        const std::map<std::string, World>::const_iterator world_it = worlds.find(world_name);
+        is_dependency = world_it != worlds.end() &&
+                        request_world_name == world_name &&
+                        world_it->second.simulations.count(simulation_name) > 0 &&
+                        world_it->second.simulations.at(simulation_name).dependencies.count(request_simulation_name) > 0;
+    }
+
     double start = get_time_now();
     double now = get_time_now();
-    EMetaDataState &request_meta_data_state = worlds[request_world_name].simulations[request_simulation_name].meta_data_state;
+    EMetaDataState &request_meta_data_state = request_simulation->meta_data_state;
     while (!should_shut_down)
     {
-        if (request_meta_data_state == EMetaDataState::WaitAfterOtherBindSendData || request_meta_data_state == EMetaDataState::Normal)
+        const EMetaDataState meta_data_state = request_meta_data_state;
+        if (meta_data_state == EMetaDataState::WaitAfterOtherBindSendData || meta_data_state == EMetaDataState::Normal)
         {
             break;
         }
+        // Once the requested simulation has bound the new request meta data, only a dependency is waited for
+        if (!is_dependency && (meta_data_state == EMetaDataState::WaitAfterOtherSendRequestMetaData || meta_data_state == EMetaDataState::WaitAfterOtherNormal))
+        {
+            return;
+        }
         now = get_time_now();
         if (now - start > 1)
         {
             printf("[Server] Socket %s is waiting for %s to send data.\n", socket_addr.c_str(), request_simulation_name.c_str());
             start = now;
         }
+        std::this_thread::yield();
     }
 
     request_meta_data_state = EMetaDataState::WaitAfterOtherSendRequestMetaData;
@@ -1269,144 +2452,337 @@ void MultiverseServer::bind_send_data()
     {
         *send_buffer.buffer_uint16_t.data_vec[i].first = send_buffer.buffer_uint16_t.data[i] >> send_buffer.buffer_uint16_t.data_vec[i].second;
     }
-}
+    // The float and half data is converted per contiguous range, so that each loop runs over plain arrays
+    for (const ContiguousRange &contiguous_range : send_buffer.buffer_float.contiguous_ranges)
+    {
+        double *data = send_buffer.buffer_float.data_vec[contiguous_range.start].first;
+        const float *data_float = send_buffer.buffer_float.data + contiguous_range.start;
+        const double *conversions = send_buffer.buffer_float.conversions.data() + contiguous_range.start;
+        for (size_t i = 0; i < contiguous_range.end - contiguous_range.start; i++)
+        {
+            data[i] = (double)data_float[i] * conversions[i];
+        }
+    }
+    for (const ContiguousRange &contiguous_range : send_buffer.buffer_half.contiguous_ranges)
+    {
+        double *data = send_buffer.buffer_half.data_vec[contiguous_range.start].first;
+        const uint16_t *data_half = send_buffer.buffer_half.data + contiguous_range.start;
+        const double *conversions = send_buffer.buffer_half.conversions.data() + contiguous_range.start;
+        for (size_t i = 0; i < contiguous_range.end - contiguous_range.start; i++)
+        {
+            data[i] = (double)half_to_float(data_half[i]) * conversions[i];
+        }
+    }
 
-void MultiverseServer::wait_for_receive_data()
-{
-    for (const std::string &object_name : send_objects_json.getMemberNames())
+    SpatialGrid &spatial_grid = worlds[world_name].spatial_grid;
+    if (spatial_grid.is_enabled && !send_positions.empty())
     {
-        for (const Json::Value &attribute_json : send_objects_json[object_name])
+        spatial_grid.mtx.lock();
+        for (const std::pair<std::string, const double *> &send_position : send_positions)
         {
-            const std::string attribute_name = attribute_json.asString();
-            worlds[world_name].objects[object_name].attributes[attribute_name].attribute_double.is_sent = true;
-            worlds[world_name].objects[object_name].attributes[attribute_name].attribute_uint8_t.is_sent = true;
-            worlds[world_name].objects[object_name].attributes[attribute_name].attribute_uint16_t.is_sent = true;
+            update_spatial_grid(spatial_grid, send_position.first, send_position.second);
         }
+        spatial_grid.mtx.unlock();
     }
 
-    if (!is_receive_data_sent)
+    World &world = worlds[world_name];
+    if (world.history_size > 0 && !send_attributes.empty())
     {
-        for (const std::string &object_name : receive_objects_json.getMemberNames())
+        world.history_mtx.lock();
+        for (Attribute *attribute : send_attributes)
         {
-            for (const Json::Value &attribute_json : receive_objects_json[object_name])
+            if (attribute->attribute_double.data.size() > 0)
             {
-                const std::string attribute_name = attribute_json.asString();
-                double start = get_time_now();
-                while ((worlds[world_name].objects.count(object_name) == 0 ||
-                        worlds[world_name].objects[object_name].attributes.count(attribute_name) == 0 ||
-                        !worlds[world_name].objects[object_name].attributes[attribute_name].attribute_double.is_sent ||
-                        !worlds[world_name].objects[object_name].attributes[attribute_name].attribute_uint8_t.is_sent ||
-                        !worlds[world_name].objects[object_name].attributes[attribute_name].attribute_uint16_t.is_sent) &&
-                       !should_shut_down)
-                {
-                    const double now = get_time_now();
-                    if (now - start > 1)
-                    {
-                        printf("[Server] Socket %s is waiting for data of [%s][%s][%s] to be sent.\n", socket_addr.c_str(), world_name.c_str(), object_name.c_str(), attribute_name.c_str());
-                        start = now;
-                    }
-                }
+                record_history(attribute->history, world.history_size, world.time, attribute->attribute_double.data);
             }
         }
+        world.history_mtx.unlock();
+    }
 
-        is_receive_data_sent = true;
+    if (world.is_snapshot_enabled && !send_attributes.empty())
+    {
+        // The sequence is odd while the snapshot is being written, the query server retries its copy until it is even
+        // again, so the senders never wait for it. snapshot_mtx only orders the senders among each other.
+        world.snapshot_mtx.lock();
+        world.snapshot_sequence++;
+        world.snapshot_time = world.time;
+        for (Attribute *attribute : send_attributes)
+        {
+            std::copy(attribute->attribute_double.data.begin(), attribute->attribute_double.data.end(), attribute->attribute_double.snapshot_data.begin());
+            std::copy(attribute->attribute_uint8_t.data.begin(), attribute->attribute_uint8_t.data.end(), attribute->attribute_uint8_t.snapshot_data.begin());
+            std::copy(attribute->attribute_uint16_t.data.begin(), attribute->attribute_uint16_t.data.end(), attribute->attribute_uint16_t.snapshot_data.begin());
+        }
+        world.snapshot_sequence++;
+        world.snapshot_mtx.unlock();
+    }
+}
+
+void MultiverseServer::send_history(const std::string &history_request_str)
+{
+    Json::Value history_request_json;
+    if (world_name.empty() || !reader.parse(history_request_str, history_request_json) || !history_request_json["time"].isNumeric())
+    {
+        throw std::invalid_argument("[Server] Received invalid history request [" + history_request_str + "] at socket " + socket_addr + ".");
+    }
+
+    const double time = history_request_json["time"].asDouble();
+    const bool is_interpolated = !history_request_json.isMember("interpolate") || history_request_json["interpolate"].asBool();
+    Json::Value history_response_json;
+    history_response_json["time"] = time;
+    history_response_json["receive"] = Json::objectValue;
+
+    World &world = worlds[world_name];
+    std::vector<double> data;
+    mtx.lock();
+    world.history_mtx.lock();
+    for (const std::string &object_name : history_request_json["receive"].getMemberNames())
+    {
+        std::map<std::string, Object>::const_iterator object_it = world.objects.find(object_name);
+        if (object_it == world.objects.end())
+        {
+            continue;
+        }
+        for (const Json::Value &attribute_json : history_request_json["receive"][object_name])
+        {
+            const std::string attribute_name = attribute_json.asString();
+            std::map<std::string, Attribute>::const_iterator attribute_it = object_it->second.attributes.find(attribute_name);
+            std::map<std::string, std::pair<EAttribute, std::vector<double>>>::const_iterator attribute_map_it = attribute_map_double.find(attribute_name);
+            if (attribute_it == object_it->second.attributes.end() || attribute_map_it == attribute_map_double.end() ||
+                !sample_history(attribute_it->second.history, time, is_interpolated, attribute_name == "quaternion", data))
+            {
+                continue;
+            }
+
+            const std::vector<double> &conversion = conversion_map.conversion_map_double[attribute_map_it->second.first];
+            Json::Value &values_json = history_response_json["receive"][object_name][attribute_name];
+            values_json = Json::arrayValue;
+            for (size_t i = 0; i < data.size(); i++)
+            {
+                values_json.append(i < conversion.size() ? data[i] / conversion[i] : data[i]);
+            }
+        }
+    }
+    world.history_mtx.unlock();
+    mtx.unlock();
+
+    zmq::message_t message_spec(sizeof(int));
+    memcpy(message_spec.data(), &history_message_spec, sizeof(int));
+    socket.send(message_spec, zmq::send_flags::sndmore);
+
+    const std::string message_str = history_response_json.toStyledString();
+    zmq::message_t message(message_str.size());
+    memcpy(message.data(), message_str.c_str(), message_str.size());
+    socket.send(message, zmq::send_flags::none);
+}
+
+void MultiverseServer::wait_for_receive_data()
+{
+    for (Attribute *attribute : send_attributes)
+    {
+        attribute->attribute_double.is_sent = true;
+        attribute->attribute_uint8_t.is_sent = true;
+        attribute->attribute_uint16_t.is_sent = true;
+    }
+    for (Attribute *attribute : send_cumulative_attributes)
+    {
+        attribute->attribute_double.is_sent = true;
+        attribute->attribute_uint8_t.is_sent = true;
+        attribute->attribute_uint16_t.is_sent = true;
     }
-}
 
-void MultiverseServer::compute_cumulative_data()
-{
-    for (const std::string &object_name : receive_objects_json.getMemberNames())
+    if (!is_receive_data_sent)
     {
-        for (const std::string &attribute_name : cumulative_attribute_names)
+        // Only the attributes that the dependencies send are waited for, a session without dependencies never waits
+        std::vector<std::pair<std::string, const Attribute *>> dependency_attributes;
         {
-            if (std::find(receive_objects_json[object_name].begin(), receive_objects_json[object_name].end(), attribute_name) == receive_objects_json[object_name].end())
+            std::lock_guard<std::mutex> lock(mtx);
+            World &world = worlds[world_name];
+            const std::set<std::string> &dependencies = world.simulations[simulation_name].dependencies;
+            for (const std::string &object_name : receive_objects_json.getMemberNames())
             {
-                continue;
-            }
+                const std::map<std::string, std::map<std::string, std::set<std::string>>>::const_iterator object_senders_it = world.senders.find(object_name);
+                const std::map<std::string, Object>::const_iterator object_it = world.objects.find(object_name);
+                if (object_senders_it == world.senders.end() || object_it == world.objects.end())
+                {
+                    continue;
+                }
 
-            std::vector<double> &double_data = worlds[world_name].objects[object_name].attributes[attribute_name].attribute_double.data;
-            double_data = attribute_map_double[attribute_name].second;
-            for (size_t i = 0; i < double_data.size(); i++)
-            {
-                for (std::pair<const std::string, Simulation> &simulation_pair : worlds[world_name].simulations)
+                for (const Json::Value &attribute_json : receive_objects_json[object_name])
                 {
-                    if (simulation_pair.second.objects.count(object_name) == 0)
+                    const std::string attribute_name = attribute_json.asString();
+                    const std::map<std::string, std::set<std::string>>::const_iterator attribute_senders_it = object_senders_it->second.find(attribute_name);
+                    const std::map<std::string, Attribute>::const_iterator attribute_it = object_it->second.attributes.find(attribute_name);
+                    if (attribute_senders_it == object_senders_it->second.end() || attribute_it == object_it->second.attributes.end())
                     {
                         continue;
                     }
 
-                    const std::string &simulation_name = simulation_pair.first;
-                    const std::vector<double> &simulation_data = (*simulation_pair.second.objects[object_name]).attributes[attribute_name].attribute_double.simulation_data[simulation_name];
-                    if (simulation_data.size() != double_data.size())
+                    for (const std::string &sender_name : attribute_senders_it->second)
                     {
-                        continue;
+                        if (dependencies.count(sender_name) > 0)
+                        {
+                            dependency_attributes.emplace_back(object_name + "][" + attribute_name, &attribute_it->second);
+                            break;
+                        }
                     }
-
-                    double_data[i] += simulation_data[i];
                 }
             }
+        }
 
-            std::vector<uint8_t> &uint8_t_data = worlds[world_name].objects[object_name].attributes[attribute_name].attribute_uint8_t.data;
-            uint8_t_data = attribute_map_uint8_t[attribute_name].second;
-            for (size_t i = 0; i < uint8_t_data.size(); i++)
+        // Objects and attributes are never erased, so the pointers stay valid without mtx
+        for (const std::pair<std::string, const Attribute *> &dependency_attribute : dependency_attributes)
+        {
+            const Attribute *attribute = dependency_attribute.second;
+            double start = get_time_now();
+            while ((!attribute->attribute_double.is_sent ||
+                    !attribute->attribute_uint8_t.is_sent ||
+                    !attribute->attribute_uint16_t.is_sent) &&
+                   !should_shut_down)
             {
-                for (std::pair<const std::string, Simulation> &simulation_pair : worlds[world_name].simulations)
+                const double now = get_time_now();
+                if (now - start > 1)
                 {
-                    if (simulation_pair.second.objects.count(object_name) == 0)
-                    {
-                        continue;
-                    }
-
-                    const std::string &simulation_name = simulation_pair.first;
-                    const std::vector<uint8_t> &simulation_data = (*simulation_pair.second.objects[object_name]).attributes[attribute_name].attribute_uint8_t.simulation_data[simulation_name];
-                    if (simulation_data.size() != uint8_t_data.size())
-                    {
-                        continue;
-                    }
-
-                    uint8_t_data[i] += simulation_data[i];
+                    printf("[Server] Socket %s is waiting for data of [%s][%s] to be sent.\n", socket_addr.c_str(), world_name.c_str(), dependency_attribute.first.c_str());
+                    start = now;
                 }
+                std::this_thread::yield();
             }
+        }
 
-            std::vector<uint16_t> &uint16_t_data = worlds[world_name].objects[object_name].attributes[attribute_name].attribute_uint16_t.data;
-            uint16_t_data = attribute_map_uint16_t[attribute_name].second;
-            for (size_t i = 0; i < uint16_t_data.size(); i++)
-            {
-                for (std::pair<const std::string, Simulation> &simulation_pair : worlds[world_name].simulations)
-                {
-                    if (simulation_pair.second.objects.count(object_name) == 0)
-                    {
-                        continue;
-                    }
+        is_receive_data_sent = true;
+    }
+}
 
-                    const std::string &simulation_name = simulation_pair.first;
-                    const std::vector<uint16_t> &simulation_data = (*simulation_pair.second.objects[object_name]).attributes[attribute_name].attribute_uint16_t.simulation_data[simulation_name];
-                    if (simulation_data.size() != uint16_t_data.size())
-                    {
-                        continue;
-                    }
+void MultiverseServer::update_receive_rates()
+{
+    const double now = get_steady_time_now();
+    is_receive_due = now - last_receive_time >= receive_period;
+    if (!is_receive_due)
+    {
+        return;
+    }
+    last_receive_time = now;
 
-                    uint16_t_data[i] += simulation_data[i];
-                }
+    if (interest_region.is_enabled)
+    {
+        update_interest();
+    }
+
+    for (std::vector<DecimatedRange> *decimated_ranges : {&receive_buffer.buffer_double.decimated_ranges, &receive_buffer.buffer_uint8_t.decimated_ranges, &receive_buffer.buffer_uint16_t.decimated_ranges, &receive_buffer.buffer_float.decimated_ranges, &receive_buffer.buffer_half.decimated_ranges})
+    {
+        for (DecimatedRange &decimated_range : *decimated_ranges)
+        {
+            decimated_range.is_due = (!decimated_range.is_filtered || interest_object_visibilities[decimated_range.object_index]) && now - decimated_range.last_time >= decimated_range.period;
+            if (decimated_range.is_due)
+            {
+                decimated_range.last_time = now;
             }
         }
     }
 }
 
+void MultiverseServer::compute_cumulative_data()
+{
+    for (std::pair<const std::string, std::map<std::string, CumulativeAttribute>> &object_cumulative_attributes : cumulative_attributes)
+    {
+        for (std::pair<const std::string, CumulativeAttribute> &cumulative_attribute : object_cumulative_attributes.second)
+        {
+            compute_typed_cumulative_data(cumulative_attribute.second.cumulative_double);
+            compute_typed_cumulative_data(cumulative_attribute.second.cumulative_uint8_t);
+            compute_typed_cumulative_data(cumulative_attribute.second.cumulative_uint16_t);
+        }
+    }
+}
+
 void MultiverseServer::bind_receive_data()
 {
-    for (size_t i = 0; i < receive_buffer.buffer_double.size; i++)
+    TypedBuffer<double> &buffer_double = receive_buffer.buffer_double;
+    bind_decimated_buffer(buffer_double, [&buffer_double](const size_t i)
+                          { buffer_double.data[i] = *buffer_double.data_vec[i].first * buffer_double.data_vec[i].second; });
+
+    TypedBuffer<uint8_t> &buffer_uint8_t = receive_buffer.buffer_uint8_t;
+    bind_decimated_buffer(buffer_uint8_t, [&buffer_uint8_t](const size_t i)
+                          { buffer_uint8_t.data[i] = *buffer_uint8_t.data_vec[i].first >> buffer_uint8_t.data_vec[i].second; });
+
+    TypedBuffer<uint16_t> &buffer_uint16_t = receive_buffer.buffer_uint16_t;
+    bind_decimated_buffer(buffer_uint16_t, [&buffer_uint16_t](const size_t i)
+                          { buffer_uint16_t.data[i] = *buffer_uint16_t.data_vec[i].first >> buffer_uint16_t.data_vec[i].second; });
+
+    TypedBuffer<float, double> &buffer_float = receive_buffer.buffer_float;
+    bind_contiguous_buffer(buffer_float, [&buffer_float](const size_t start, const size_t end)
+                           {
+                               const double *data = buffer_float.data_vec[start].first;
+                               const double *conversions = buffer_float.conversions.data() + start;
+                               float *data_float = buffer_float.data + start;
+                               for (size_t i = 0; i < end - start; i++)
+                               {
+                                   data_float[i] = (float)(data[i] * conversions[i]);
+                               } });
+
+    TypedBuffer<uint16_t, double> &buffer_half = receive_buffer.buffer_half;
+    bind_contiguous_buffer(buffer_half, [&buffer_half](const size_t start, const size_t end)
+                           {
+                               const double *data = buffer_half.data_vec[start].first;
+                               const double *conversions = buffer_half.conversions.data() + start;
+                               uint16_t *data_half = buffer_half.data + start;
+                               for (size_t i = 0; i < end - start; i++)
+                               {
+                                   data_half[i] = float_to_half((float)(data[i] * conversions[i]));
+                               } });
+}
+
+void MultiverseServer::commit_epoch()
+{
+    World &world = worlds[world_name];
+    world.epoch_mtx.lock();
+
+    for (Attribute *attribute : send_attributes)
+    {
+        commit_typed_attribute(attribute->attribute_double);
+        commit_typed_attribute(attribute->attribute_uint8_t);
+        commit_typed_attribute(attribute->attribute_uint16_t);
+    }
+    for (Attribute *attribute : send_cumulative_attributes)
     {
-        receive_buffer.buffer_double.data[i] = *receive_buffer.buffer_double.data_vec[i].first * receive_buffer.buffer_double.data_vec[i].second;
+        commit_typed_cumulative_attribute(attribute->attribute_double, simulation_name);
+        commit_typed_cumulative_attribute(attribute->attribute_uint8_t, simulation_name);
+        commit_typed_cumulative_attribute(attribute->attribute_uint16_t, simulation_name);
     }
-    for (size_t i = 0; i < receive_buffer.buffer_uint8_t.size; i++)
+    world.epoch_committed_simulations.insert(simulation_name);
+
+    // The last sender of the round flips the epoch, so the receivers see one commit of every sender
+    bool is_epoch_complete = true;
+    for (const std::pair<const std::string, std::vector<Attribute *>> &epoch_send_attributes : world.epoch_send_attributes)
     {
-        receive_buffer.buffer_uint8_t.data[i] = *receive_buffer.buffer_uint8_t.data_vec[i].first >> receive_buffer.buffer_uint8_t.data_vec[i].second;
+        if (world.epoch_committed_simulations.count(epoch_send_attributes.first) == 0)
+        {
+            is_epoch_complete = false;
+            break;
+        }
     }
-    for (size_t i = 0; i < receive_buffer.buffer_uint16_t.size; i++)
+    if (is_epoch_complete)
     {
-        receive_buffer.buffer_uint16_t.data[i] = *receive_buffer.buffer_uint16_t.data_vec[i].first >> receive_buffer.buffer_uint16_t.data_vec[i].second;
+        flip_epoch(world);
     }
+
+    world.epoch_mtx.unlock();
+}
+
+void MultiverseServer::bind_receive_epoch_data()
+{
+    const std::atomic<size_t> &epoch = worlds[world_name].epoch;
+    size_t epoch_start;
+    do
+    {
+        do
+        {
+            epoch_start = epoch.load(std::memory_order_acquire);
+        } while (!should_shut_down && epoch_start % 2 == 1);
+
+        bind_receive_data();
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+    } while (!should_shut_down && epoch.load(std::memory_order_relaxed) != epoch_start);
 }
 
 void MultiverseServer::receive_new_request_meta_data()
@@ -1473,10 +2849,17 @@ void MultiverseServer::receive_new_request_meta_data()
     receive_buffer.buffer_double.data_vec.clear();
     receive_buffer.buffer_uint8_t.data_vec.clear();
     receive_buffer.buffer_uint16_t.data_vec.clear();
+    send_buffer.buffer_float.data_vec.clear();
+    send_buffer.buffer_half.data_vec.clear();
+    receive_buffer.buffer_float.data_vec.clear();
+    receive_buffer.buffer_half.data_vec.clear();
 }
 
 void MultiverseServer::send_receive_data()
 {
+    const size_t buffer_count = get_buffer_count(receive_buffer);
+    bool is_delta_frame = false;
+    bool is_compressing_uint16_t = false;
     if (should_shut_down)
     {
         const int message_spec_int = 0;
@@ -1484,9 +2867,36 @@ void MultiverseServer::send_receive_data()
         memcpy(message_spec.data(), &message_spec_int, sizeof(int));
         socket.send(message_spec, zmq::send_flags::none);
     }
+    else if (!is_receive_due)
+    {
+        const int message_spec_int = 2;
+        zmq::message_t message_spec(sizeof(int));
+        memcpy(message_spec.data(), &message_spec_int, sizeof(int));
+        socket.send(message_spec, zmq::send_flags::sndmore);
+    }
     else
     {
-        const int message_spec_int = 2 + (receive_buffer.buffer_double.size > 0) + (receive_buffer.buffer_uint8_t.size > 0) + (receive_buffer.buffer_uint16_t.size > 0);
+        const bool is_compressed = compression_uint8_t != ECompression::None || compression_uint16_t != ECompression::None;
+        is_delta_frame = is_delta_encoding && !is_compressed && buffer_count > 0 && encode_delta_buffer(receive_buffer);
+        if (compression_uint16_t != ECompression::None && receive_buffer.buffer_uint16_t.size > 0)
+        {
+            // The worker compresses the uint16 frame while this thread compresses the uint8 frame and sends the others
+            if (!compression_worker.joinable())
+            {
+                compression_worker = std::thread(&MultiverseServer::run_compression_worker, this);
+            }
+            compression_mtx.lock();
+            is_compression_pending = true;
+            compression_mtx.unlock();
+            compression_cv.notify_all();
+            is_compressing_uint16_t = true;
+        }
+        if (compression_uint8_t != ECompression::None && receive_buffer.buffer_uint8_t.size > 0)
+        {
+            TypedBuffer<uint8_t> &buffer_uint8_t = receive_buffer.buffer_uint8_t;
+            compress_data(buffer_uint8_t.data, buffer_uint8_t.size, buffer_uint8_t.compressed_data, buffer_uint8_t.hash_table);
+        }
+        const int message_spec_int = 2 + buffer_count + (is_delta_frame ? delta_message_spec_offset : 0);
         zmq::message_t message_spec(sizeof(int));
         memcpy(message_spec.data(), &message_spec_int, sizeof(int));
         socket.send(message_spec, zmq::send_flags::sndmore);
@@ -1504,42 +2914,38 @@ void MultiverseServer::send_receive_data()
         memcpy(message_time.data(), &worlds[world_name].time, sizeof(double));
     }
 
-    if (receive_buffer.buffer_double.size > 0 || receive_buffer.buffer_uint8_t.size > 0 || receive_buffer.buffer_uint16_t.size > 0)
+    if (is_receive_due && buffer_count > 0)
     {
         socket.send(message_time, zmq::send_flags::sndmore);
+
+        std::vector<zmq::message_t> messages;
         if (receive_buffer.buffer_double.size > 0)
         {
-            zmq::message_t message_double(receive_buffer.buffer_double.size * sizeof(double));
-            memcpy(message_double.data(), receive_buffer.buffer_double.data, receive_buffer.buffer_double.size * sizeof(double));
-            if (receive_buffer.buffer_uint8_t.size > 0 || receive_buffer.buffer_uint16_t.size > 0)
-            {
-                socket.send(message_double, zmq::send_flags::sndmore);
-            }
-            else
-            {
-                socket.send(message_double, zmq::send_flags::none);
-            }
+            messages.push_back(pack_message(receive_buffer.buffer_double, is_delta_frame, ECompression::None));
         }
-
         if (receive_buffer.buffer_uint8_t.size > 0)
         {
-            zmq::message_t message_uint8_t(receive_buffer.buffer_uint8_t.size * sizeof(uint8_t));
-            memcpy(message_uint8_t.data(), receive_buffer.buffer_uint8_t.data, receive_buffer.buffer_uint8_t.size * sizeof(uint8_t));
-            if (receive_buffer.buffer_uint16_t.size > 0)
-            {
-                socket.send(message_uint8_t, zmq::send_flags::sndmore);
-            }
-            else
+            messages.push_back(pack_message(receive_buffer.buffer_uint8_t, is_delta_frame, compression_uint8_t));
+        }
+        if (receive_buffer.buffer_uint16_t.size > 0)
+        {
+            if (is_compressing_uint16_t)
             {
-                socket.send(message_uint8_t, zmq::send_flags::none);
+                wait_for_compression();
             }
+            messages.push_back(pack_message(receive_buffer.buffer_uint16_t, is_delta_frame, compression_uint16_t));
         }
-
-        if (receive_buffer.buffer_uint16_t.size > 0)
+        if (receive_buffer.buffer_float.size > 0)
+        {
+            messages.push_back(pack_message(receive_buffer.buffer_float, is_delta_frame, ECompression::None));
+        }
+        if (receive_buffer.buffer_half.size > 0)
         {
-            zmq::message_t message_uint16_t(receive_buffer.buffer_uint16_t.size * sizeof(uint16_t));
-            memcpy(message_uint16_t.data(), receive_buffer.buffer_uint16_t.data, receive_buffer.buffer_uint16_t.size * sizeof(uint16_t));
-            socket.send(message_uint16_t, zmq::send_flags::none);
+            messages.push_back(pack_message(receive_buffer.buffer_half, is_delta_frame, ECompression::None));
+        }
+        for (size_t i = 0; i < messages.size(); i++)
+        {
+            socket.send(messages[i], i + 1 < messages.size() ? zmq::send_flags::sndmore : zmq::send_flags::none);
         }
     }
     else
@@ -1548,6 +2954,36 @@ void MultiverseServer::send_receive_data()
     }
 }
 
+void MultiverseServer::run_compression_worker()
+{
+    std::unique_lock<std::mutex> lock(compression_mtx);
+    while (true)
+    {
+        compression_cv.wait(lock, [this]
+                            { return is_compression_pending || should_stop_compression; });
+        if (should_stop_compression)
+        {
+            break;
+        }
+
+        // The session does not touch the uint16 buffer until the compression is done
+        lock.unlock();
+        TypedBuffer<uint16_t> &buffer_uint16_t = receive_buffer.buffer_uint16_t;
+        compress_data(buffer_uint16_t.data, buffer_uint16_t.size, compression_uint16_t, buffer_uint16_t.compressed_data, buffer_uint16_t.hash_table);
+        lock.lock();
+
+        is_compression_pending = false;
+        compression_cv.notify_all();
+    }
+}
+
+void MultiverseServer::wait_for_compression()
+{
+    std::unique_lock<std::mutex> lock(compression_mtx);
+    compression_cv.wait(lock, [this]
+                        { return !is_compression_pending; });
+}
+
 void start_multiverse_server(const std::string &server_socket_addr)
 {
     std::map<std::string, std::thread> workers;
@@ -1564,6 +3000,11 @@ void start_multiverse_server(const std::string &server_socket_addr)
             printf("[Server] Waiting for request...\n");
             zmq::recv_result_t recv_result_t = server_socket.recv(request, zmq::recv_flags::none);
             receive_addr = request.to_string();
+            while (request.more())
+            {
+                // The world name is only needed by the router
+                recv_result_t = server_socket.recv(request, zmq::recv_flags::none);
+            }
             printf("[Server] Received request to open socket %s.\n", receive_addr.c_str());
         }
         catch (const zmq::error_t &e)
@@ -1590,4 +3031,321 @@ void start_multiverse_server(const std::string &server_socket_addr)
     {
         worker.second.join();
     }
-}
\ No newline at end of file
+}
+
+template <class T>
+static void append_snapshot_layout(Json::Value &layout_json, const std::string &object_name, const std::string &attribute_name, const char *dtype, const std::vector<T> &snapshot_data, std::vector<T> &snapshot)
+{
+    if (snapshot_data.empty())
+    {
+        return;
+    }
+
+    Json::Value entry_json;
+    entry_json["object"] = object_name;
+    entry_json["attribute"] = attribute_name;
+    entry_json["dtype"] = dtype;
+    entry_json["offset"] = Json::UInt64(snapshot.size());
+    entry_json["size"] = Json::UInt64(snapshot_data.size());
+    layout_json.append(entry_json);
+    snapshot.insert(snapshot.end(), snapshot_data.begin(), snapshot_data.end());
+}
+
+template <class T>
+static void append_snapshot_values(Json::Value &values_json, const std::vector<T> &snapshot, const size_t offset, const size_t size)
+{
+    for (size_t i = offset; i < offset + size && i < snapshot.size(); i++)
+    {
+        values_json.append(snapshot[i]);
+    }
+}
+
+static bool read_snapshot(const Json::Value &query_json, Json::Value &snapshot_json, std::vector<double> &snapshot_double, std::vector<uint8_t> &snapshot_uint8_t, std::vector<uint16_t> &snapshot_uint16_t)
+{
+    const std::string world_name = query_json.isMember("world_name") ? query_json["world_name"].asString() : "world";
+
+    World *world;
+    {
+        std::lock_guard<std::mutex> lock(snapshot_worlds_mtx);
+        std::map<std::string, World *>::iterator world_it = snapshot_worlds.find(world_name);
+        if (world_it == snapshot_worlds.end())
+        {
+            return false;
+        }
+        world = world_it->second;
+    }
+
+    // The first query enables the snapshot, the senders fill it from their next step on
+    world->is_snapshot_enabled = true;
+
+    std::vector<std::pair<std::string, std::string>> query_attribute_names;
+    const Json::Value &objects_json = query_json.isMember("objects") ? query_json["objects"] : Json::Value(Json::objectValue);
+    for (const std::string &object_name : objects_json.getMemberNames())
+    {
+        for (const Json::Value &attribute_json : objects_json[object_name])
+        {
+            query_attribute_names.emplace_back(object_name, attribute_json.asString());
+        }
+    }
+
+    // The snapshot attributes only change in the handshake of a sender, which waits for this lock
+    std::lock_guard<std::mutex> layout_lock(world->snapshot_layout_mtx);
+
+    // "" selects all objects or all attributes. The map is sorted by name and selects each attribute once.
+    std::vector<std::pair<const std::pair<std::string, std::string>, const Attribute *> *> attributes;
+    for (std::pair<const std::pair<std::string, std::string>, const Attribute *> &snapshot_attribute : world->snapshot_attributes)
+    {
+        for (const std::pair<std::string, std::string> &query_attribute_name : query_attribute_names)
+        {
+            if ((query_attribute_name.first.empty() || query_attribute_name.first == snapshot_attribute.first.first) &&
+                (query_attribute_name.second.empty() || query_attribute_name.second == snapshot_attribute.first.second))
+            {
+                attributes.push_back(&snapshot_attribute);
+                break;
+            }
+        }
+    }
+
+    // The copy is retried while a sender writes the snapshot
+    Json::Value layout_json;
+    double time;
+    while (true)
+    {
+        const size_t sequence_start = world->snapshot_sequence.load(std::memory_order_acquire);
+        if (sequence_start % 2 == 1)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        layout_json = Json::arrayValue;
+        snapshot_double.clear();
+        snapshot_uint8_t.clear();
+        snapshot_uint16_t.clear();
+        time = world->snapshot_time;
+        for (const std::pair<const std::pair<std::string, std::string>, const Attribute *> *attribute : attributes)
+        {
+            const std::string &object_name = attribute->first.first;
+            const std::string &attribute_name = attribute->first.second;
+            append_snapshot_layout(layout_json, object_name, attribute_name, "double", attribute->second->attribute_double.snapshot_data, snapshot_double);
+            append_snapshot_layout(layout_json, object_name, attribute_name, "uint8", attribute->second->attribute_uint8_t.snapshot_data, snapshot_uint8_t);
+            append_snapshot_layout(layout_json, object_name, attribute_name, "uint16", attribute->second->attribute_uint16_t.snapshot_data, snapshot_uint16_t);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (world->snapshot_sequence.load(std::memory_order_relaxed) == sequence_start)
+        {
+            break;
+        }
+    }
+
+    snapshot_json["world_name"] = world_name;
+    snapshot_json["time"] = time;
+    snapshot_json["layout"] = layout_json;
+    return true;
+}
+
+static size_t get_shard_index(const std::string &world_name, const size_t shard_count)
+{
+    // FNV-1a, so that a world is routed to the same shard after a restart of the router
+    uint64_t hash = 14695981039346656037ULL;
+    for (const char c : world_name)
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+    }
+    return hash % shard_count;
+}
+
+static const int shard_timeout_ms = 5000;
+
+static zmq::socket_t connect_shard(const std::string &shard_socket_addr)
+{
+    // A shard that is down must not block the router, its requests time out and the socket is connected again
+    zmq::socket_t shard_socket = zmq::socket_t(server_context, zmq::socket_type::req);
+    const int linger = 0;
+    zmq_setsockopt(shard_socket.handle(), ZMQ_RCVTIMEO, &shard_timeout_ms, sizeof(shard_timeout_ms));
+    zmq_setsockopt(shard_socket.handle(), ZMQ_LINGER, &linger, sizeof(linger));
+    shard_socket.connect(shard_socket_addr);
+    return shard_socket;
+}
+
+void start_multiverse_router(const std::string &server_socket_addr, const std::vector<std::string> &shard_socket_addrs)
+{
+    if (shard_socket_addrs.empty())
+    {
+        throw std::invalid_argument("[Server] The router at " + server_socket_addr + " needs at least one shard.");
+    }
+
+    std::vector<zmq::socket_t> shard_sockets;
+    for (const std::string &shard_socket_addr : shard_socket_addrs)
+    {
+        shard_sockets.push_back(connect_shard(shard_socket_addr));
+        printf("[Server] Connect router to shard %s\n", shard_socket_addr.c_str());
+    }
+
+    zmq::socket_t server_socket = zmq::socket_t(server_context, zmq::socket_type::rep);
+    server_socket.bind(server_socket_addr);
+    printf("[Server] Create router socket %s\n", server_socket_addr.c_str());
+
+    while (!should_shut_down)
+    {
+        try
+        {
+            zmq::message_t request;
+            zmq::recv_result_t recv_result_t = server_socket.recv(request, zmq::recv_flags::none);
+            const std::string receive_addr = request.to_string();
+            std::string world_name = "world";
+            if (request.more())
+            {
+                recv_result_t = server_socket.recv(request, zmq::recv_flags::none);
+                if (request.size() > 0)
+                {
+                    world_name = request.to_string();
+                }
+                while (request.more())
+                {
+                    recv_result_t = server_socket.recv(request, zmq::recv_flags::none);
+                }
+            }
+
+            // The shard opens the socket of the client, so the client talks to the shard directly afterwards
+            const size_t shard_index = get_shard_index(world_name, shard_sockets.size());
+            printf("[Server] Route socket %s of world %s to shard %s.\n", receive_addr.c_str(), world_name.c_str(), shard_socket_addrs[shard_index].c_str());
+            zmq::socket_t &shard_socket = shard_sockets[shard_index];
+            zmq::message_t shard_request_addr(receive_addr.size());
+            memcpy(shard_request_addr.data(), receive_addr.c_str(), receive_addr.size());
+            shard_socket.send(shard_request_addr, zmq::send_flags::sndmore);
+            zmq::message_t shard_request_world(world_name.size());
+            memcpy(shard_request_world.data(), world_name.c_str(), world_name.size());
+            shard_socket.send(shard_request_world, zmq::send_flags::none);
+
+            zmq::message_t response;
+            recv_result_t = shard_socket.recv(response, zmq::recv_flags::none);
+            if (!recv_result_t.has_value())
+            {
+                // The client compares the response with its socket address, so it retries after the error
+                printf("[Server] Shard %s did not respond within %d ms, reconnect it.\n", shard_socket_addrs[shard_index].c_str(), shard_timeout_ms);
+                shard_socket = connect_shard(shard_socket_addrs[shard_index]);
+                const std::string error_str = "[Server] Shard " + shard_socket_addrs[shard_index] + " of world " + world_name + " did not respond.";
+                response = zmq::message_t(error_str.size());
+                memcpy(response.data(), error_str.c_str(), error_str.size());
+            }
+            server_socket.send(response, zmq::send_flags::none);
+        }
+        catch (const zmq::error_t &e)
+        {
+            should_shut_down = true;
+            printf("[Server] %s, router socket %s prepares to close.\n", e.what(), server_socket_addr.c_str());
+            break;
+        }
+    }
+}
+
+void start_multiverse_query_server(const std::string &query_socket_addr)
+{
+    zmq::socket_t query_socket = zmq::socket_t(server_context, zmq::socket_type::rep);
+    try
+    {
+        query_socket.bind(query_socket_addr);
+    }
+    catch (const zmq::error_t &e)
+    {
+        // The query server is optional, the simulations keep running without it
+        printf("[Server] %s, query socket %s can not be bound, queries are disabled.\n", e.what(), query_socket_addr.c_str());
+        return;
+    }
+    printf("[Server] Create query socket %s\n", query_socket_addr.c_str());
+
+    Json::Reader query_reader;
+    while (!should_shut_down)
+    {
+        zmq::message_t request;
+        try
+        {
+            zmq::recv_result_t recv_result_t = query_socket.recv(request, zmq::recv_flags::none);
+        }
+        catch (const zmq::error_t &e)
+        {
+            printf("[Server] %s, query socket %s prepares to close.\n", e.what(), query_socket_addr.c_str());
+            break;
+        }
+
+        Json::Value query_json;
+        Json::Value snapshot_json;
+        std::vector<double> snapshot_double;
+        std::vector<uint8_t> snapshot_uint8_t;
+        std::vector<uint16_t> snapshot_uint16_t;
+        if (!query_reader.parse(request.to_string(), query_json) || !query_json.isObject() ||
+            !read_snapshot(query_json, snapshot_json, snapshot_double, snapshot_uint8_t, snapshot_uint16_t))
+        {
+            snapshot_json = Json::objectValue;
+            snapshot_json["error"] = "Invalid query [" + request.to_string() + "].";
+        }
+
+        try
+        {
+            if (snapshot_json.isMember("error") || query_json["format"].asString() != "binary")
+            {
+                // The values of each layout entry are listed under its object and attribute
+                if (snapshot_json.isMember("layout"))
+                {
+                    snapshot_json["objects"] = Json::objectValue;
+                    for (const Json::Value &entry_json : snapshot_json["layout"])
+                    {
+                        Json::Value &values_json = snapshot_json["objects"][entry_json["object"].asString()][entry_json["attribute"].asString()];
+                        if (values_json.isNull())
+                        {
+                            values_json = Json::arrayValue;
+                        }
+                        const std::string dtype = entry_json["dtype"].asString();
+                        const size_t offset = entry_json["offset"].asUInt64();
+                        const size_t size = entry_json["size"].asUInt64();
+                        if (dtype == "double")
+                        {
+                            append_snapshot_values(values_json, snapshot_double, offset, size);
+                        }
+                        else if (dtype == "uint8")
+                        {
+                            append_snapshot_values(values_json, snapshot_uint8_t, offset, size);
+                        }
+                        else
+                        {
+                            append_snapshot_values(values_json, snapshot_uint16_t, offset, size);
+                        }
+                    }
+                    snapshot_json.removeMember("layout");
+                }
+                const std::string snapshot_str = snapshot_json.toStyledString();
+                zmq::message_t message(snapshot_str.size());
+                memcpy(message.data(), snapshot_str.c_str(), snapshot_str.size());
+                query_socket.send(message, zmq::send_flags::none);
+            }
+            else
+            {
+                // The layout lists {object, attribute, dtype, offset, size} of each entry in the double, uint8 and uint16 frames
+                const std::string layout_str = snapshot_json.toStyledString();
+                zmq::message_t message_layout(layout_str.size());
+                memcpy(message_layout.data(), layout_str.c_str(), layout_str.size());
+                query_socket.send(message_layout, zmq::send_flags::sndmore);
+
+                zmq::message_t message_double(snapshot_double.size() * sizeof(double));
+                memcpy(message_double.data(), snapshot_double.data(), snapshot_double.size() * sizeof(double));
+                query_socket.send(message_double, zmq::send_flags::sndmore);
+
+                zmq::message_t message_uint8_t(snapshot_uint8_t.size() * sizeof(uint8_t));
+                memcpy(message_uint8_t.data(), snapshot_uint8_t.data(), snapshot_uint8_t.size() * sizeof(uint8_t));
+                query_socket.send(message_uint8_t, zmq::send_flags::sndmore);
+
+                zmq::message_t message_uint16_t(snapshot_uint16_t.size() * sizeof(uint16_t));
+                memcpy(message_uint16_t.data(), snapshot_uint16_t.data(), snapshot_uint16_t.size() * sizeof(uint16_t));
+                query_socket.send(message_uint16_t, zmq::send_flags::none);
+            }
+        }
+        catch (const zmq::error_t &e)
+        {
+            printf("[Server] %s, query socket %s prepares to close.\n", e.what(), query_socket_addr.c_str());
+            break;
+        }
+    }
+}